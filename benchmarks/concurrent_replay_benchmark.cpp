@@ -0,0 +1,107 @@
+#include "concurrent_replay_buffer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Measures push throughput by actor thread count while one learner thread samples
+ * continuously, for the lock-free ConcurrentReplayBuffer and for a plain ReplayBuffer
+ * behind a single mutex. With the mutex, actors queue behind each other and behind
+ * every gather of the learner; the lock-free buffer only shares a ticket counter.
+ *
+ * Usage: concurrent_replay_benchmark [max_threads] [pushes_per_thread]
+ */
+
+namespace {
+    constexpr size_t CAPACITY = 1000000;
+    constexpr size_t STATE_SIZE = 32;
+    constexpr size_t BATCH_SIZE = 64;
+
+    struct Result {
+        double pushes_per_second;
+        double batches_per_second;
+    };
+
+    // Runs the actors and a learner until every actor is done
+    template<typename Push, typename Sample>
+    Result run(size_t threads, size_t pushes, Push push, Sample sample) {
+        std::atomic<size_t> running{threads};
+        std::vector<std::thread> actors;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t t = 0; t < threads; ++t) {
+            actors.emplace_back([&, t]() {
+                std::vector<double> state(STATE_SIZE, (double)t);
+                for (size_t i = 0; i < pushes; ++i) {
+                    state[0] = (double)i;
+                    push(state, (int)t, 1.0, state, false);
+                }
+                running--;
+            });
+        }
+
+        size_t batches = 0;
+        while (running > 0) {
+            batches += sample() ? 1 : 0;
+        }
+        for (std::thread& actor : actors) {
+            actor.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        return {(double)(threads * pushes) / seconds, (double)batches / seconds};
+    }
+}
+
+int main(int argc, char** argv) {
+    const size_t max_threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 8;
+    const size_t pushes = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200000;
+
+    std::cout << "State size: " << STATE_SIZE << ", batch size: " << BATCH_SIZE << ", pushes per thread: " << pushes
+              << "\n";
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        ReplayBuffer locked(CAPACITY, STATE_SIZE);
+        std::mutex mutex;
+        ReplayBatch locked_batch;
+        Result baseline = run(
+            threads, pushes,
+            [&](const std::vector<double>& s, int a, double r, const std::vector<double>& n, bool d) {
+                std::lock_guard<std::mutex> lock(mutex);
+                locked.push(s, a, r, n, d);
+            },
+            [&]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!locked.is_ready(BATCH_SIZE)) {
+                    return false;
+                }
+                locked.sample(BATCH_SIZE, locked_batch);
+                return true;
+            });
+
+        ConcurrentReplayBuffer concurrent_buffer(CAPACITY, STATE_SIZE);
+        ReplayBatch concurrent_batch;
+        Result concurrent = run(
+            threads, pushes,
+            [&](const std::vector<double>& s, int a, double r, const std::vector<double>& n, bool d) {
+                concurrent_buffer.push(s, a, r, n, d);
+            },
+            [&]() {
+                if (!concurrent_buffer.is_ready(BATCH_SIZE)) {
+                    return false;
+                }
+                concurrent_buffer.sample(BATCH_SIZE, concurrent_batch);
+                return true;
+            });
+
+        std::cout << threads << " actors: mutex " << baseline.pushes_per_second / 1e6 << " M pushes/s ("
+                  << baseline.batches_per_second << " batches/s), lock-free " << concurrent.pushes_per_second / 1e6
+                  << " M pushes/s (" << concurrent.batches_per_second << " batches/s)\n";
+    }
+
+    return 0;
+}
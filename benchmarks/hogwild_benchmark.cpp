@@ -0,0 +1,108 @@
+#include "neuralnet.hpp"
+#include "dense.hpp"
+#include "activation.hpp"
+#include "loss.hpp"
+#include "hogwild_trainer.hpp"
+#include "parallel_trainer.hpp"
+#include "thread_pool.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/**
+ * Compares training throughput (samples/sec) of the Hogwild trainer against the
+ * synchronous data-parallel trainer and the single-threaded mini-batch path on a
+ * wide-input regression model.
+ *
+ * Usage: hogwild_benchmark [threads] [epochs]
+ */
+
+namespace {
+    constexpr size_t INPUT_SIZE = 512;
+    constexpr size_t HIDDEN_SIZE = 64;
+    constexpr size_t SAMPLES = 4096;
+    constexpr size_t BATCH_SIZE = 64;
+    constexpr double LEARNING_RATE = 0.001;
+
+    NeuralNet makeModel() {
+        NeuralNet net;
+        net.addLayer(std::make_shared<Dense>(INPUT_SIZE, HIDDEN_SIZE));
+        net.addLayer(std::make_shared<Activation>(ActivationType::ReLU));
+        net.addLayer(std::make_shared<Dense>(HIDDEN_SIZE, 1));
+        net.setLoss(std::make_shared<MSELoss>());
+        return net;
+    }
+
+    // Sparse-ish inputs: each sample activates a handful of features
+    void makeData(std::vector<std::vector<double>>& inputs, std::vector<std::vector<double>>& targets) {
+        for (size_t s = 0; s < SAMPLES; ++s) {
+            std::vector<double> x(INPUT_SIZE, 0.0);
+            double y = 0.0;
+            for (size_t k = 0; k < 8; ++k) {
+                size_t feature = (s * 31 + k * 97) % INPUT_SIZE;
+                x[feature] = 1.0;
+                y += std::sin((double)feature);
+            }
+            inputs.push_back(x);
+            targets.push_back({y / 8.0});
+        }
+    }
+
+    double loss(const NeuralNet& net, const std::vector<std::vector<double>>& inputs,
+                const std::vector<std::vector<double>>& targets) {
+        MSELoss mse;
+        double total = 0.0;
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            total += mse.compute(net.predict(inputs[i]), targets[i]);
+        }
+        return total / inputs.size();
+    }
+
+    template<typename Train>
+    void report(const char* name, int epochs, const NeuralNet& net, const std::vector<std::vector<double>>& inputs,
+                const std::vector<std::vector<double>>& targets, Train train) {
+        auto start = std::chrono::steady_clock::now();
+        train();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double rate = (double)epochs * inputs.size() / seconds;
+        std::cout << name << ": " << rate << " samples/sec, final loss " << loss(net, inputs, targets) << "\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    const size_t threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 0;
+    const int epochs = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    std::vector<std::vector<double>> inputs;
+    std::vector<std::vector<double>> targets;
+    makeData(inputs, targets);
+
+    ThreadPool pool(threads);
+    std::cout << "Threads: " << pool.size() << ", epochs: " << epochs << ", samples: " << SAMPLES
+              << ", model: " << INPUT_SIZE << "-" << HIDDEN_SIZE << "-1\n";
+
+    NeuralNet initial = makeModel();
+
+    NeuralNet serial(initial);
+    report("Serial mini-batch  ", epochs, serial, inputs, targets, [&]() {
+        serial.train(inputs, targets, epochs, LEARNING_RATE, BATCH_SIZE);
+    });
+
+    NeuralNet synchronous(initial);
+    ParallelTrainer parallel_trainer(synchronous, pool);
+    report("Synchronous (sync) ", epochs, synchronous, inputs, targets, [&]() {
+        parallel_trainer.train(inputs, targets, epochs, LEARNING_RATE, BATCH_SIZE);
+    });
+
+    NeuralNet hogwild(initial);
+    HogwildTrainer hogwild_trainer(hogwild, pool);
+    report("Hogwild (async)    ", epochs, hogwild, inputs, targets, [&]() {
+        hogwild_trainer.train(inputs, targets, epochs, LEARNING_RATE);
+    });
+
+    return 0;
+}
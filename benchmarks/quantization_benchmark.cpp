@@ -0,0 +1,126 @@
+#include "neuralnet.hpp"
+#include "dense.hpp"
+#include "activation.hpp"
+#include "inference_plan.hpp"
+#include "quantization.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/**
+ * Compares single-sample inference latency and weight footprint of a double, a float
+ * and an int8-quantized copy of the same MLP, and reports the largest output error of
+ * each copy relative to the largest double output. With the default width the double
+ * weights (about 3 MB) do not fit in L2, while the int8 weights (about 400 KB) do.
+ *
+ * Usage: quantization_benchmark [width] [iterations]
+ */
+
+namespace {
+    constexpr size_t INPUT_SIZE = 256;
+    constexpr size_t OUTPUT_SIZE = 16;
+    constexpr size_t CALIBRATION_SAMPLES = 256;
+
+    template<typename T>
+    BasicNeuralNet<T> makeModel(size_t width) {
+        BasicNeuralNet<T> net;
+        net.addLayer(std::make_shared<BasicDense<T>>(INPUT_SIZE, width));
+        net.addLayer(std::make_shared<BasicActivation<T>>(ActivationType::ReLU));
+        net.addLayer(std::make_shared<BasicDense<T>>(width, width));
+        net.addLayer(std::make_shared<BasicActivation<T>>(ActivationType::ReLU));
+        net.addLayer(std::make_shared<BasicDense<T>>(width, OUTPUT_SIZE));
+        return net;
+    }
+
+    // Copies the double model's parameters into a float model of the same shape
+    NeuralNetF toFloat(const NeuralNet& net, size_t width) {
+        NeuralNetF net_f = makeModel<float>(width);
+        for (size_t l = 0; l < net.getLayers().size(); ++l) {
+            const Dense* dense = dynamic_cast<const Dense*>(net.getLayers()[l].get());
+            if (dense != nullptr) {
+                auto* dense_f = dynamic_cast<DenseF*>(net_f.getLayers()[l].get());
+                dense_f->setWeights(MatrixF(dense->getWeights()));
+                dense_f->setBiases(std::vector<float>(dense->getBiases().begin(), dense->getBiases().end()));
+            }
+        }
+        return net_f;
+    }
+
+    template<typename T>
+    size_t weightBytes(const BasicNeuralNet<T>& net) {
+        size_t bytes = 0;
+        for (const auto& layer : net.getLayers()) {
+            if (const auto* dense = dynamic_cast<const BasicDense<T>*>(layer.get())) {
+                bytes += dense->getWeights().size() * sizeof(T);
+            } else if (const auto* quantized = dynamic_cast<const BasicQuantizedDense<T>*>(layer.get())) {
+                bytes += quantized->getWeights().size();
+            }
+        }
+        return bytes;
+    }
+
+    // Runs every sample through the plan repeatedly and returns microseconds per sample
+    template<typename T>
+    double latency(const BasicNeuralNet<T>& net, const BasicMatrix<T>& samples, int iterations) {
+        BasicInferencePlan<T> plan(net, INPUT_SIZE);
+        std::vector<T> output(plan.output_size());
+        auto start = std::chrono::steady_clock::now();
+        for (int it = 0; it < iterations; ++it) {
+            for (size_t r = 0; r < samples.rows(); ++r) {
+                plan.predict(Span<const T>(samples.row(r), INPUT_SIZE), output);
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return 1e6 * seconds / ((double)iterations * samples.rows());
+    }
+
+    template<typename T>
+    double relativeError(const NeuralNet& reference, const BasicNeuralNet<T>& net, const Matrix& samples) {
+        Matrix expected = reference.predict_batch(samples);
+        BasicMatrix<T> actual = net.predict_batch(BasicMatrix<T>(samples));
+        double error = 0.0;
+        double scale = 0.0;
+        for (size_t k = 0; k < expected.size(); ++k) {
+            error = std::max(error, std::fabs(expected.data()[k] - (double)actual.data()[k]));
+            scale = std::max(scale, std::fabs(expected.data()[k]));
+        }
+        return error / scale;
+    }
+
+    template<typename T>
+    void report(const char* name, const NeuralNet& reference, const BasicNeuralNet<T>& net, const Matrix& samples,
+                int iterations) {
+        std::cout << name << ": " << latency(net, BasicMatrix<T>(samples), iterations) << " us/sample, weights "
+                  << weightBytes(net) / 1024 << " KB, relative error " << relativeError(reference, net, samples) << "\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    const size_t width = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 512;
+    const int iterations = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    Matrix calibration(CALIBRATION_SAMPLES, INPUT_SIZE);
+    for (size_t k = 0; k < calibration.size(); ++k) {
+        calibration.data()[k] = std::sin(0.37 * (double)k);
+    }
+    Matrix samples(64, INPUT_SIZE);
+    std::copy(calibration.data(), calibration.data() + samples.size(), samples.data());
+
+    std::cout << "Model: " << INPUT_SIZE << "-" << width << "-" << width << "-" << OUTPUT_SIZE
+              << ", samples: " << samples.rows() << ", iterations: " << iterations << "\n";
+
+    NeuralNet net = makeModel<double>(width);
+    NeuralNetF net_f = toFloat(net, width);
+
+    report("double", net, net, samples, iterations);
+    report("float ", net, net_f, samples, iterations);
+    report("int8  ", net, Quantization::quantize(net, calibration), samples, iterations);
+    report("int8 f", net, Quantization::quantize(net_f, MatrixF(calibration)), samples, iterations);
+
+    return 0;
+}
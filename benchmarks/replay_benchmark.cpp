@@ -0,0 +1,62 @@
+#include "replay_buffer.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+ * Times ReplayBuffer::sample into a reused batch for each sampling mode across
+ * buffer sizes. The cost of a scan grows with the number of stored transitions, while
+ * sampling with or without replacement should stay flat; what remains is the cost
+ * of gathering batch_size rows.
+ *
+ * Usage: replay_benchmark [batch_size] [state_size] [iterations]
+ */
+
+namespace {
+    constexpr size_t BUFFER_SIZES[] = {1000, 10000, 100000, 1000000};
+
+    ReplayBuffer makeBuffer(size_t capacity, size_t state_size) {
+        ReplayBuffer buffer(capacity, state_size);
+        std::vector<double> state(state_size);
+        for (size_t i = 0; i < capacity; ++i) {
+            state[0] = (double)i;
+            buffer.push(state, (int)(i % 4), 0.0, state, false);
+        }
+        return buffer;
+    }
+
+    // Samples repeatedly and returns microseconds per batch
+    double latency(ReplayBuffer& buffer, SamplingMode mode, size_t batch_size, int iterations) {
+        ReplayBatch batch;
+        buffer.setSampling(mode);
+        buffer.sample(batch_size, batch);
+        auto start = std::chrono::steady_clock::now();
+        for (int it = 0; it < iterations; ++it) {
+            buffer.sample(batch_size, batch);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return 1e6 * seconds / iterations;
+    }
+}
+
+int main(int argc, char** argv) {
+    const size_t batch_size = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+    const size_t state_size = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 8;
+    const int iterations = argc > 3 ? std::atoi(argv[3]) : 2000;
+
+    std::cout << "Batch size: " << batch_size << ", state size: " << state_size << ", iterations: " << iterations
+              << "\n";
+
+    for (size_t capacity : BUFFER_SIZES) {
+        ReplayBuffer buffer = makeBuffer(capacity, state_size);
+        std::cout << "buffer " << capacity << ": scan " << latency(buffer, SamplingMode::Scan, batch_size, iterations)
+                  << " us, with replacement "
+                  << latency(buffer, SamplingMode::WithReplacement, batch_size, iterations)
+                  << " us, without replacement "
+                  << latency(buffer, SamplingMode::WithoutReplacement, batch_size, iterations) << " us\n";
+    }
+
+    return 0;
+}
@@ -14,9 +14,9 @@ int main() {
     NeuralNet net;
 
     auto dense1 = std::make_shared<Dense>(4, 5);
-    auto activation1 = std::make_shared<Activation>(Utils::relu, Utils::relu_derivative);
+    auto activation1 = std::make_shared<Activation>(ActivationType::ReLU);
     auto dense2 = std::make_shared<Dense>(5, 3);
-    auto activation2 = std::make_shared<Activation>(Utils::sigmoid, Utils::sigmoid_derivative);
+    auto activation2 = std::make_shared<Activation>(ActivationType::Sigmoid);
     
     // Using SGD with momentum
     dense1->setOptimizer(std::make_unique<SGD>(0.01, 0.9));
@@ -2,39 +2,120 @@
 #include "layer.hpp"
 #include <functional>
 
+/**
+ * @brief The activation functions with built-in kernels.
+ */
+enum class ActivationType {
+    Sigmoid,
+    ReLU,
+    LeakyReLU,
+    Tanh,
+    GELU,
+    SiLU,
+    Softmax,
+    /** @brief A user-supplied function and derivative, evaluated through std::function */
+    Custom
+};
+
 /**
  * @brief Activation layer that applies a non-linear activation function to inputs.
  * 
  * The Activation class implements various activation functions like sigmoid, ReLU, 
- * leaky ReLU, and tanh to introduce non-linearity into neural networks.
+ * leaky ReLU, tanh, GELU, SiLU and softmax to introduce non-linearity into neural networks.
+ * Built-in types are dispatched once per call to a loop that invokes the kernel
+ * directly, so it can be inlined and vectorized. Arbitrary callables remain supported
+ * as ActivationType::Custom, which calls through std::function per element.
+ * 
+ * @tparam T The scalar type of the activations.
  */
-class Activation : public Layer {
+template<typename T>
+class BasicActivation : public BasicLayer<T> {
     private:
-        /** @brief The activation function to be applied to inputs */
-        std::function<double(double)> activation;
+        /** @brief The kind of activation applied by this layer */
+        ActivationType type;
+
+        /** @brief The negative slope used by ActivationType::LeakyReLU */
+        double alpha;
+
+        /** @brief The activation function used by ActivationType::Custom */
+        std::function<T(T)> activation;
         
-        /** @brief The derivative of the activation function used during backpropagation */
-        std::function<double(double)> activation_derivative;
+        /** @brief The derivative used by ActivationType::Custom during backpropagation */
+        std::function<T(T)> activation_derivative;
         
         /** @brief Cache of input values for use in backward pass */
-        std::vector<double> input_cache;
+        std::vector<T> input_cache;
+
+        /** @brief Cache of the input batch for use in backward_batch */
+        BasicMatrix<T> batch_input_cache;
+
+        /**
+         * @brief Applies the activation to a rows x cols block, dispatching on the type once.
+         * 
+         * @param input The input block.
+         * @param output The output block (may not alias input).
+         * @param rows Number of rows (samples); softmax normalizes each row.
+         * @param cols Number of columns (features).
+         */
+        void apply(const T* input, T* output, size_t rows, size_t cols) const;
+
+        /**
+         * @brief Computes the input gradient for a rows x cols block.
+         * 
+         * @param input The block that was passed to apply().
+         * @param grad_output Gradient with respect to the activation output.
+         * @param grad_input Receives the gradient with respect to the input.
+         * @param rows Number of rows (samples).
+         * @param cols Number of columns (features).
+         */
+        void apply_gradient(const T* input, const T* grad_output, T* grad_input,
+                            size_t rows, size_t cols) const;
 
     public:
+        /**
+         * @brief Constructs an Activation layer using a built-in kernel.
+         * 
+         * @param type The activation to apply; must not be ActivationType::Custom.
+         * @param alpha The negative slope for ActivationType::LeakyReLU, ignored otherwise.
+         * @throws std::invalid_argument If type is ActivationType::Custom.
+         */
+        explicit BasicActivation(ActivationType type, double alpha = 0.01);
+
         /**
          * @brief Constructs an Activation layer with the specified activation function and its derivative.
          * 
+         * Plain function pointers to the single-argument Utils activations (sigmoid, relu,
+         * tanh, gelu, silu and their derivatives) are recognized and mapped to the built-in
+         * kernels; anything else is evaluated as ActivationType::Custom.
+         * 
          * @param act The activation function.
          * @param act_deriv The derivative of the activation function.
          */
-        Activation(std::function<double(double)> act, std::function<double(double)> act_deriv);
+        BasicActivation(std::function<T(T)> act, std::function<T(T)> act_deriv);
+
+        /**
+         * @brief Gets the kind of activation applied by this layer.
+         * 
+         * @return The activation type.
+         */
+        ActivationType getType() const;
+
+        /**
+         * @brief Gets the negative slope used by ActivationType::LeakyReLU.
+         * 
+         * @return The slope.
+         */
+        double getAlpha() const;
         
         /**
          * @brief Applies the activation function to the input.
          * 
+         * Softmax normalizes over the whole vector; all other types act element-wise.
+         * 
          * @param input The input vector.
          * @return The activated output vector.
          */
-        std::vector<double> forward(const std::vector<double>& input) override;
+        std::vector<T> forward(const std::vector<T>& input) override;
         
         /**
          * @brief Computes gradients during backpropagation.
@@ -43,12 +124,128 @@ class Activation : public Layer {
          * @param learning_rate The learning rate for parameter updates.
          * @return The gradient to pass to the previous layer.
          */
-        std::vector<double> backward(const std::vector<double>& grad_output, double learning_rate) override;
+        std::vector<T> backward(const std::vector<T>& grad_output, double learning_rate) override;
+
+        /**
+         * @brief Applies the activation function to every element of a mini-batch.
+         * 
+         * Softmax normalizes each row (sample) independently.
+         * 
+         * @param input The input batch.
+         * @return The activated output batch.
+         */
+        BasicMatrix<T> forward_batch(const BasicMatrix<T>& input) override;
+
+        /**
+         * @brief Computes gradients for the mini-batch seen by the last forward_batch call.
+         * 
+         * @param grad_output Gradient from the next layer.
+         * @param learning_rate The learning rate for parameter updates.
+         * @return The gradient to pass to the previous layer.
+         */
+        BasicMatrix<T> backward_batch(const BasicMatrix<T>& grad_output, double learning_rate) override;
+        
+        /**
+         * @brief Applies the activation function; there are no shared parameters to read.
+         * 
+         * @param input The input vector.
+         * @param output Receives the activated vector.
+         */
+        void forward_hogwild(Span<const T> input, Span<T> output) const override;
+
+        /**
+         * @brief Computes the input gradient from the given input; there are no parameters to update.
+         * 
+         * @param input The input vector seen by forward_hogwild.
+         * @param grad_output Gradient from the next layer.
+         * @param grad_input Receives the gradient to pass to the previous layer.
+         * @param learning_rate Unused.
+         */
+        void backward_hogwild(Span<const T> input, Span<const T> grad_output, Span<T> grad_input,
+                              double learning_rate) override;
+
+        /**
+         * @brief Gets the number of trainable parameters, which is always zero.
+         * 
+         * @return 0.
+         */
+        size_t parameter_count() const override;
+
+        /**
+         * @brief Computes the input gradient for the last mini-batch; there are no parameters.
+         * 
+         * @param grad_output Gradient from the next layer.
+         * @param parameter_gradients Unused.
+         * @return The gradient to pass to the previous layer.
+         */
+        BasicMatrix<T> compute_gradients(const BasicMatrix<T>& grad_output, Span<T> parameter_gradients) override;
+
+        /**
+         * @brief Computes the input gradient for the last mini-batch; there are no parameters.
+         * 
+         * @param grad_output Gradient from the next layer.
+         * @param parameter_gradients Unused.
+         * @return The gradient to pass to the previous layer.
+         */
+        BasicMatrix<T> accumulate_gradients(const BasicMatrix<T>& grad_output, Span<T> parameter_gradients) override;
+
+        /**
+         * @brief Does nothing, as activations have no parameters.
+         * 
+         * @param parameter_gradients Unused.
+         * @param learning_rate Unused.
+         */
+        void apply_gradients(Span<const T> parameter_gradients, double learning_rate) override;
+
+        /**
+         * @brief Checks that source is also an Activation; there are no parameters to copy.
+         * 
+         * @param source The layer to copy from.
+         * @throws std::invalid_argument If source is not an Activation layer.
+         */
+        void copy_parameters_from(const BasicLayer<T>& source) override;
+
+        /**
+         * @brief Does nothing, as there are no trainable parameters.
+         * 
+         * @param storage Must be empty.
+         * @param owner Unused.
+         * @throws std::invalid_argument If storage is not empty.
+         */
+        void bind_parameters(Span<T> storage, std::shared_ptr<void> owner) override;
+
+        /**
+         * @brief Gets the output size of this layer, which equals the input size.
+         * 
+         * @param input_size The number of input features.
+         * @return input_size.
+         */
+        size_t output_size(size_t input_size) const override;
+
+        /**
+         * @brief Applies the activation function without caching the input.
+         * 
+         * @param input The input vector.
+         * @param output Receives the activated vector.
+         */
+        void infer(Span<const T> input, Span<T> output) const override;
+
+        /**
+         * @brief Applies the activation function to a mini-batch without caching the input.
+         * 
+         * @param input The input batch.
+         * @param output Receives the activated batch; must have the same shape.
+         * @throws std::invalid_argument If the shapes differ.
+         */
+        void infer_batch(BasicConstMatrixView<T> input, BasicMatrixView<T> output) const override;
         
         /**
          * @brief Creates a deep copy of this layer.
          * 
          * @return A unique pointer to a new instance of this layer.
          */
-        std::unique_ptr<Layer> clone() const override;
-};
\ No newline at end of file
+        std::unique_ptr<BasicLayer<T>> clone() const override;
+};
+
+using Activation = BasicActivation<double>;
+using ActivationF = BasicActivation<float>;
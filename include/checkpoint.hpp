@@ -0,0 +1,143 @@
+#pragma once
+#include "neuralnet.hpp"
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Writes training checkpoints to a file on a background thread.
+ * 
+ * save() copies the network (parameters and optimizer state) on the calling thread,
+ * which costs about one pass over the parameters, and hands the copy to a writer
+ * thread that serializes it with NeuralNet::save. The training loop never waits for
+ * the disk: if the writer is still busy when the next snapshot arrives, the older
+ * unwritten snapshot is replaced by the newer one. Files are replaced atomically, so
+ * the checkpoint on disk is always a complete earlier state of the run.
+ * 
+ * Pass a checkpointer to NeuralNet::train to save every interval epochs; call
+ * restore() on a freshly built network first to resume an interrupted run.
+ * 
+ * @tparam T The scalar type of the network.
+ */
+template<typename T>
+class BasicCheckpointer {
+    private:
+        /** @brief The checkpoint file */
+        std::string path;
+
+        /** @brief Epochs between checkpoints taken by train */
+        int interval;
+
+        /** @brief Epochs completed as of the last save or restore */
+        int epoch;
+
+        /** @brief Snapshot waiting for the writer, or null */
+        std::unique_ptr<BasicNeuralNet<T>> pending;
+
+        /** @brief Epoch count recorded with the pending snapshot */
+        int pending_epoch;
+
+        /** @brief Set while the writer is saving a snapshot */
+        bool writing;
+
+        /** @brief Set when the destructor asks the writer to exit */
+        bool stopping;
+
+        /** @brief First error raised by the writer, reported by the next save or wait */
+        std::exception_ptr error;
+
+        /** @brief Guards the writer state above */
+        std::mutex mutex;
+
+        /** @brief Signalled when a snapshot is queued, written, or the writer should stop */
+        std::condition_variable state_changed;
+
+        /** @brief The background writer */
+        std::thread writer;
+
+        /**
+         * @brief Writer loop: saves pending snapshots until stopped and drained.
+         */
+        void run();
+
+        /**
+         * @brief Rethrows and clears a stored writer error; the mutex must be held.
+         */
+        void rethrow_error();
+
+    public:
+        /**
+         * @brief Starts a checkpointer writing to path.
+         * 
+         * @param path The checkpoint file.
+         * @param interval Epochs between checkpoints taken by train.
+         * @throws std::invalid_argument If interval is less than 1.
+         */
+        explicit BasicCheckpointer(std::string path, int interval = 1);
+
+        /** @brief Deleted copy constructor */
+        BasicCheckpointer(const BasicCheckpointer&) = delete;
+
+        /** @brief Deleted copy assignment operator */
+        BasicCheckpointer& operator=(const BasicCheckpointer&) = delete;
+
+        /**
+         * @brief Writes any pending snapshot and stops the writer; write errors are dropped.
+         */
+        ~BasicCheckpointer();
+
+        /**
+         * @brief Restores the checkpoint file into a network, if it exists.
+         * 
+         * Waits for pending writes first. On success the checkpointer continues counting
+         * from the epoch recorded in the file.
+         * 
+         * @param net A network with the same layers and optimizers as the one saved.
+         * @return true if a checkpoint was restored, false if the file does not exist.
+         * @throws std::runtime_error If the file exists but does not match the network.
+         */
+        bool restore(BasicNeuralNet<T>& net);
+
+        /**
+         * @brief Snapshots a network and queues it for writing.
+         * 
+         * @param net The network to save.
+         * @param completed_epochs The number of completed training epochs to record.
+         * @throws std::runtime_error If a previous background write failed.
+         */
+        void save(const BasicNeuralNet<T>& net, int completed_epochs);
+
+        /**
+         * @brief Blocks until every queued snapshot has been written.
+         * 
+         * @throws std::runtime_error If a background write failed.
+         */
+        void wait();
+
+        /**
+         * @brief Gets the number of epochs completed as of the last save or restore.
+         * 
+         * @return The epoch count.
+         */
+        int getEpoch() const;
+
+        /**
+         * @brief Gets the number of epochs between checkpoints taken by train.
+         * 
+         * @return The interval.
+         */
+        int getInterval() const;
+
+        /**
+         * @brief Gets the checkpoint file.
+         * 
+         * @return The path.
+         */
+        const std::string& getPath() const;
+};
+
+using Checkpointer = BasicCheckpointer<double>;
+using CheckpointerF = BasicCheckpointer<float>;
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "replay_buffer.hpp"
+#include "span.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * @brief A replay buffer that many actor threads push into while a learner thread samples.
+ *
+ * Ingestion is lock-free. Transitions live in the same preallocated columns as in
+ * ReplayBuffer, and every push claims the next ticket with one atomic increment and
+ * writes slot ticket % capacity. Each slot carries a version that is odd while the
+ * slot is being written and encodes which ticket it holds once the write is done,
+ * in the manner of a seqlock: the learner copies a slot without taking any lock and
+ * keeps the copy only if the version shows the expected ticket both before and after.
+ * Column elements are accessed with relaxed atomics, so concurrent reads and writes
+ * are well defined, and actors never wait for the learner.
+ *
+ * sample() takes a snapshot of the ticket counter and draws distinct tickets from the
+ * last capacity tickets before it. A ticket whose write is still in flight, or whose
+ * slot has since been overwritten, is rejected and another drawn, so every transition
+ * in a batch was pushed completely before the snapshot and read untorn.
+ *
+ * push() and size() may be called from any thread; sample() from one thread at a time.
+ */
+class ConcurrentReplayBuffer {
+    public:
+        /**
+         * @brief Constructs an empty buffer and preallocates its columns.
+         *
+         * @param capacity The maximum number of transitions; the oldest are overwritten.
+         * @param state_size The length of every state and next state.
+         * @throws std::invalid_argument If capacity or state_size is 0.
+         */
+        ConcurrentReplayBuffer(size_t capacity, size_t state_size);
+
+        /**
+         * @brief Adds an experience from any thread.
+         *
+         * @param experience The experience to add.
+         * @throws std::invalid_argument If the states do not have the buffer's state size.
+         */
+        void push(const Experience& experience);
+
+        /**
+         * @brief Adds a transition from any thread.
+         *
+         * Only waits if another push to the same slot, a whole capacity of tickets
+         * earlier, has not finished yet.
+         *
+         * @param state The state before the action (state size).
+         * @param action The action taken.
+         * @param reward The reward received.
+         * @param next_state The state after the action (state size).
+         * @param done Whether the episode ended after the transition.
+         * @throws std::invalid_argument If the states do not have the buffer's state size.
+         */
+        void push(Span<const double> state, int action, double reward, Span<const double> next_state, bool done);
+
+        /**
+         * @brief Samples distinct transitions uniformly at random from a snapshot into a batch.
+         *
+         * Expected O(batch_size) while batch_size is well below size().
+         *
+         * @param batch_size The number of transitions to sample.
+         * @param batch Receives the transitions and their slots; resized to batch_size.
+         * @throws std::runtime_error If fewer than batch_size transitions have been pushed.
+         */
+        void sample(size_t batch_size, ReplayBatch& batch);
+
+        /**
+         * @brief Gets the number of completed transitions, at most the capacity.
+         *
+         * @return The number of transitions available to sample.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Checks if the buffer has enough transitions for sampling.
+         *
+         * @param batch_size The batch size to check against.
+         * @return True if at least batch_size transitions have been pushed.
+         */
+        bool is_ready(size_t batch_size) const;
+
+    private:
+        /** @brief The states, one row per slot */
+        Matrix states;
+
+        /** @brief The next states, one row per slot */
+        Matrix next_states;
+
+        /** @brief The action of each slot */
+        std::vector<int> actions;
+
+        /** @brief The reward of each slot */
+        std::vector<double> rewards;
+
+        /** @brief The done flag of each slot */
+        std::vector<unsigned char> dones;
+
+        /** @brief Per slot 2 * lap + 1 while ticket lap * capacity + slot is written, 2 * lap + 2 after */
+        std::unique_ptr<std::atomic<uint64_t>[]> versions;
+
+        /** @brief The maximum number of transitions */
+        size_t capacity;
+
+        /** @brief The length of every state */
+        size_t state_size;
+
+        /** @brief The next ticket to hand to a push */
+        std::atomic<uint64_t> next_ticket{0};
+
+        /** @brief The number of pushes that have finished writing */
+        std::atomic<uint64_t> completed{0};
+
+        /** @brief Open-addressing set of the tickets already drawn for a batch */
+        std::vector<uint64_t> drawn;
+
+        /** @brief Random number generator for sampling */
+        std::mt19937 gen;
+
+        /** @brief Lets the tests leave slots in the state of an unfinished push */
+        friend struct ConcurrentReplayBufferProbe;
+
+        /**
+         * @brief Copies the transition of a ticket into a batch row if it is still stored whole.
+         *
+         * @param ticket The ticket.
+         * @param batch The batch, already sized.
+         * @param row The row to fill.
+         * @return True if the copy is consistent, false if the slot is being written or holds another ticket.
+         */
+        bool read(uint64_t ticket, ReplayBatch& batch, size_t row) const;
+};
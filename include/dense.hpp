@@ -1,6 +1,7 @@
 #pragma once
 #include "layer.hpp"
 #include "optimizer.hpp"
+#include "matrix.hpp"
 #include <memory>
 
 /**
@@ -8,30 +9,49 @@
  * 
  * This layer implements a fully-connected layer where each input is connected 
  * to each output through weights. Each output also has a bias term.
+ * 
+ * @tparam T The scalar type of the weights and activations.
  */
-class Dense : public Layer {
+template<typename T>
+class BasicDense : public BasicLayer<T> {
     public:
         /** @brief Deleted copy constructor */
-        Dense(const Dense&) = delete;
+        BasicDense(const BasicDense&) = delete;
         
         /** @brief Deleted copy assignment operator */
-        Dense& operator=(const Dense&) = delete;
+        BasicDense& operator=(const BasicDense&) = delete;
         
     private:
-        /** @brief The weight matrix (output_size x input_size) */
-        std::vector<std::vector<double>> weights;
+        /** @brief The weight matrix (output_size x input_size), stored row-major in one contiguous buffer */
+        BasicMatrix<T> weights;
         
-        /** @brief The bias vector (output_size) */
-        std::vector<double> biases;
+        /** @brief The bias vector (1 x output_size), kept as a matrix so it can view a parameter arena */
+        BasicMatrix<T> biases;
         
         /** @brief Cache of input values for use in backward pass */
-        std::vector<double> input_cache;
+        std::vector<T> input_cache;
+
+        /** @brief Cache of the input batch for use in backward_batch */
+        BasicMatrix<T> batch_input_cache;
         
+        /** @brief Scratch for the batch gradients (weights row-major, then biases), reused across steps */
+        std::vector<T> parameter_gradients;
+
         /** @brief Optimizer for the weights */
-        std::unique_ptr<Optimizer> weight_optimizer;
+        std::unique_ptr<BasicOptimizer<T>> weight_optimizer;
         
         /** @brief Optimizer for the biases */
-        std::unique_ptr<Optimizer> bias_optimizer;
+        std::unique_ptr<BasicOptimizer<T>> bias_optimizer;
+
+        /**
+         * @brief Backpropagates a mini-batch, writing or adding the parameter gradients.
+         * 
+         * @param grad_output The gradient from the next layer (batch_size x output_size).
+         * @param parameter_gradients The gradient buffer (parameter_count()).
+         * @param accumulate Whether to add to the buffer instead of overwriting it.
+         * @return The gradient to pass to the previous layer (batch_size x input_size).
+         */
+        BasicMatrix<T> backpropagate(const BasicMatrix<T>& grad_output, Span<T> parameter_gradients, bool accumulate);
 
     public:
         /**
@@ -40,14 +60,74 @@ class Dense : public Layer {
          * @param input_size The size of the input vector.
          * @param output_size The size of the output vector.
          */
-        Dense(int input_size, int output_size);
+        BasicDense(int input_size, int output_size);
+
+        /**
+         * @brief Constructs a Dense layer from existing parameters.
+         * 
+         * The weights are taken over without copying, so a borrowed matrix (for example
+         * one over a memory-mapped model file) stays borrowed.
+         * 
+         * @param weights The weight matrix (output_size x input_size).
+         * @param biases The bias vector (output_size).
+         * @throws std::invalid_argument If the sizes do not match or the matrix is empty.
+         */
+        BasicDense(BasicMatrix<T> weights, std::vector<T> biases);
         
         /**
          * @brief Sets the optimizer for this layer.
          * 
          * @param optimizer The optimizer to use for updating weights and biases.
          */
-        void setOptimizer(std::unique_ptr<Optimizer> optimizer);
+        void setOptimizer(std::unique_ptr<BasicOptimizer<T>> optimizer);
+
+        /**
+         * @brief Gets the optimizer for the weights.
+         * 
+         * @return The optimizer, or nullptr if none was set.
+         */
+        BasicOptimizer<T>* getWeightOptimizer() const;
+
+        /**
+         * @brief Gets the optimizer for the biases.
+         * 
+         * @return The optimizer, or nullptr if none was set.
+         */
+        BasicOptimizer<T>* getBiasOptimizer() const;
+
+        /**
+         * @brief Gets the weight matrix.
+         * 
+         * @return The weight matrix (output_size x input_size).
+         */
+        const BasicMatrix<T>& getWeights() const;
+
+        /**
+         * @brief Gets the bias vector.
+         * 
+         * @return The bias vector (output_size).
+         */
+        Span<const T> getBiases() const;
+
+        /**
+         * @brief Replaces the weight matrix.
+         * 
+         * The values are copied into the current storage, so a layer bound to a parameter arena stays bound.
+         * 
+         * @param new_weights The new weights; must have the same shape as the current ones.
+         * @throws std::invalid_argument If the shape does not match.
+         */
+        void setWeights(const BasicMatrix<T>& new_weights);
+
+        /**
+         * @brief Replaces the bias vector.
+         * 
+         * The values are copied into the current storage, so a layer bound to a parameter arena stays bound.
+         * 
+         * @param new_biases The new biases; must have output_size elements.
+         * @throws std::invalid_argument If the size does not match.
+         */
+        void setBiases(Span<const T> new_biases);
         
         /**
          * @brief Computes the forward pass through this layer.
@@ -55,21 +135,151 @@ class Dense : public Layer {
          * @param input The input vector.
          * @return The output vector.
          */
-        std::vector<double> forward(const std::vector<double>& input) override;
+        std::vector<T> forward(const std::vector<T>& input) override;
         
         /**
          * @brief Computes the backward pass through this layer.
          * 
+         * The input gradient, the weight gradient and the parameter update are computed
+         * in a single pass over each weight row, so the weight matrix is streamed through
+         * memory once per step.
+         * 
          * @param grad_output The gradient from the next layer.
          * @param learning_rate The learning rate for parameter updates.
          * @return The gradient to pass to the previous layer.
          */
-        std::vector<double> backward(const std::vector<double>& grad_output, double learning_rate) override;
+        std::vector<T> backward(const std::vector<T>& grad_output, double learning_rate) override;
+
+        /**
+         * @brief Computes the forward pass for a mini-batch.
+         * 
+         * @param input The input batch (batch_size x input_size).
+         * @return The output batch (batch_size x output_size).
+         * @throws std::invalid_argument If the input width does not match the layer.
+         */
+        BasicMatrix<T> forward_batch(const BasicMatrix<T>& input) override;
+
+        /**
+         * @brief Computes the backward pass for a mini-batch and applies one parameter update.
+         * 
+         * @param grad_output The gradient from the next layer (batch_size x output_size).
+         * @param learning_rate The learning rate for parameter updates.
+         * @return The gradient to pass to the previous layer (batch_size x input_size).
+         */
+        BasicMatrix<T> backward_batch(const BasicMatrix<T>& grad_output, double learning_rate) override;
+        
+        /**
+         * @brief Computes output = W * input + b, reading parameters with relaxed atomic loads.
+         * 
+         * @param input The input vector (input_size).
+         * @param output Receives the output vector (output_size).
+         */
+        void forward_hogwild(Span<const T> input, Span<T> output) const override;
+
+        /**
+         * @brief Computes the input gradient and applies W -= lr * g x^T, b -= lr * g without locks.
+         * 
+         * Each weight is read and written with relaxed atomics; the input gradient uses
+         * the value read just before that weight is updated.
+         * 
+         * @param input The input vector seen by forward_hogwild.
+         * @param grad_output The gradient from the next layer (output_size).
+         * @param grad_input Receives the gradient to pass to the previous layer (input_size).
+         * @param learning_rate The learning rate.
+         */
+        void backward_hogwild(Span<const T> input, Span<const T> grad_output, Span<T> grad_input,
+                              double learning_rate) override;
+
+        /**
+         * @brief Gets the number of trainable parameters.
+         * 
+         * @return output_size * input_size weights plus output_size biases.
+         */
+        size_t parameter_count() const override;
+
+        /**
+         * @brief Computes the batch gradients without updating the parameters.
+         * 
+         * The gradient buffer holds dW row-major (output_size x input_size) followed by db.
+         * 
+         * @param grad_output The gradient from the next layer (batch_size x output_size).
+         * @param parameter_gradients Receives the parameter gradients (parameter_count()).
+         * @return The gradient to pass to the previous layer (batch_size x input_size).
+         * @throws std::invalid_argument If parameter_gradients has the wrong size.
+         */
+        BasicMatrix<T> compute_gradients(const BasicMatrix<T>& grad_output, Span<T> parameter_gradients) override;
+
+        /**
+         * @brief Computes the batch gradients and adds them to the buffer without updating the parameters.
+         * 
+         * @param grad_output The gradient from the next layer (batch_size x output_size).
+         * @param parameter_gradients Accumulates the parameter gradients (parameter_count()).
+         * @return The gradient to pass to the previous layer (batch_size x input_size).
+         * @throws std::invalid_argument If parameter_gradients has the wrong size.
+         */
+        BasicMatrix<T> accumulate_gradients(const BasicMatrix<T>& grad_output, Span<T> parameter_gradients) override;
+
+        /**
+         * @brief Applies one update from a gradient buffer laid out as in compute_gradients.
+         * 
+         * @param parameter_gradients The parameter gradients (parameter_count()).
+         * @param learning_rate The learning rate used when no optimizer is set.
+         * @throws std::invalid_argument If parameter_gradients has the wrong size.
+         */
+        void apply_gradients(Span<const T> parameter_gradients, double learning_rate) override;
+
+        /**
+         * @brief Copies the weights and biases of another Dense layer of the same shape.
+         * 
+         * @param source The layer to copy from.
+         * @throws std::invalid_argument If source is not a Dense layer of the same shape.
+         */
+        void copy_parameters_from(const BasicLayer<T>& source) override;
+
+        /**
+         * @brief Moves the weights and biases into external storage (weights row-major, then biases).
+         * 
+         * The current values are copied into storage and the layer keeps working on it in place.
+         * 
+         * @param storage Destination of parameter_count() elements.
+         * @param owner Keeps storage alive for as long as the layer uses it.
+         * @throws std::invalid_argument If storage has the wrong size.
+         */
+        void bind_parameters(Span<T> storage, std::shared_ptr<void> owner) override;
+
+        /**
+         * @brief Gets the output size of this layer.
+         * 
+         * @param input_size The number of input features.
+         * @return The number of output features.
+         * @throws std::invalid_argument If input_size does not match the layer input size.
+         */
+        size_t output_size(size_t input_size) const override;
+
+        /**
+         * @brief Computes output = W * input + b without caching the input.
+         * 
+         * @param input The input vector (input_size).
+         * @param output Receives the output vector (output_size).
+         */
+        void infer(Span<const T> input, Span<T> output) const override;
+
+        /**
+         * @brief Computes output = input * W^T + b for a mini-batch without caching the input.
+         * 
+         * @param input The input batch (batch_size x input_size).
+         * @param output Receives the output batch (batch_size x output_size).
+         * @throws std::invalid_argument If the shapes do not match the layer.
+         */
+        void infer_batch(BasicConstMatrixView<T> input, BasicMatrixView<T> output) const override;
         
         /**
          * @brief Creates a deep copy of this layer.
          * 
          * @return A unique pointer to a new instance of this layer.
          */
-        std::unique_ptr<Layer> clone() const override;
-};
\ No newline at end of file
+        std::unique_ptr<BasicLayer<T>> clone() const override;
+};
+
+using Dense = BasicDense<double>;
+using DenseF = BasicDense<float>;
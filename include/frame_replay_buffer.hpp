@@ -0,0 +1,152 @@
+#pragma once
+
+#include "replay_buffer.hpp"
+#include "span.hpp"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * @brief A replay buffer that stores each observation once and samples n-step transitions.
+ *
+ * In a sequential episode the next state of step t is the state of step t + 1, so
+ * storing both doubles the memory. This buffer keeps a ring of frames instead: each
+ * frame is one observation, and the action, reward and done flag of the step taken
+ * from it. A push whose state equals the last pushed next state, in an episode that
+ * has not ended, only appends the next state; any other push starts a new episode
+ * with two frames. An episode of T steps thus takes T + 1 frames rather than 2T rows.
+ *
+ * Transitions are rebuilt at sample time: the state is the sampled frame, and the
+ * reward is the discounted sum of the rewards of the next n_steps steps of the same
+ * episode, stopping early at a done or at the last stored step of the episode. The
+ * next state is the frame after the last step summed, and batch.discounts holds
+ * gamma^k for the k steps summed, or 0 if the episode ended, so the target is
+ * reward + discount * value(next state). With n_steps = 1 the batches match those
+ * of ReplayBuffer apart from the discounts.
+ */
+class FrameReplayBuffer {
+    public:
+        /**
+         * @brief Constructs an empty buffer and preallocates its frames.
+         *
+         * @param capacity The maximum number of frames; the oldest are overwritten.
+         * @param state_size The length of every observation.
+         * @param n_steps The maximum number of rewards summed into each sampled transition.
+         * @param gamma The discount factor for the n-step return.
+         * @throws std::invalid_argument If capacity is below 2, state_size or n_steps is 0, or gamma is not in [0, 1].
+         */
+        FrameReplayBuffer(size_t capacity, size_t state_size, size_t n_steps = 1, double gamma = 0.99);
+
+        /**
+         * @brief Adds an experience.
+         *
+         * @param experience The experience to add.
+         * @return The frame of the experience's state.
+         * @throws std::invalid_argument If the states do not have the buffer's state size.
+         */
+        size_t push(const Experience& experience);
+
+        /**
+         * @brief Adds a transition, storing state only if it does not continue the last episode.
+         *
+         * @param state The state before the action (state size).
+         * @param action The action taken.
+         * @param reward The reward received.
+         * @param next_state The state after the action (state size).
+         * @param done Whether the episode ended after the transition.
+         * @return The frame of the state.
+         * @throws std::invalid_argument If the states do not have the buffer's state size.
+         */
+        size_t push(Span<const double> state, int action, double reward, Span<const double> next_state, bool done);
+
+        /**
+         * @brief Samples distinct transitions uniformly at random and rebuilds their n-step returns.
+         *
+         * Frames without a step (the last frame of each episode) are redrawn, so this
+         * is expected O(batch_size * n_steps) while batch_size is well below size().
+         *
+         * @param batch_size The number of transitions to sample.
+         * @param batch Receives the transitions, their frames in indices and their discounts.
+         * @throws std::runtime_error If the buffer holds fewer than batch_size transitions.
+         */
+        void sample(size_t batch_size, ReplayBatch& batch);
+
+        /**
+         * @brief Gets the number of stored transitions.
+         *
+         * @return The number of frames a step is taken from.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Gets the number of frames in use.
+         *
+         * @return The number of stored observations.
+         */
+        size_t getFrameCount() const;
+
+        /**
+         * @brief Checks if the buffer has enough transitions for sampling.
+         *
+         * @param batch_size The batch size to check against.
+         * @return True if at least batch_size transitions are stored.
+         */
+        bool is_ready(size_t batch_size) const;
+
+    private:
+        /** @brief The observations, one row per frame */
+        Matrix frames;
+
+        /** @brief The action taken from each frame */
+        std::vector<int> actions;
+
+        /** @brief The reward of the step taken from each frame */
+        std::vector<double> rewards;
+
+        /** @brief 1 if the step taken from the frame ended the episode */
+        std::vector<unsigned char> dones;
+
+        /** @brief 1 if a step was taken from the frame, so the next frame holds its successor */
+        std::vector<unsigned char> has_step;
+
+        /** @brief Per frame the sample call that last drew it, to keep a batch distinct */
+        std::vector<uint32_t> drawn;
+
+        /** @brief The maximum number of frames */
+        size_t capacity;
+
+        /** @brief The length of every observation */
+        size_t state_size;
+
+        /** @brief The maximum number of steps per sampled transition */
+        size_t n_steps;
+
+        /** @brief The discount factor */
+        double gamma;
+
+        /** @brief The frame written next */
+        size_t position;
+
+        /** @brief The number of frames in use */
+        size_t frame_count;
+
+        /** @brief The number of frames with a step */
+        size_t transitions;
+
+        /** @brief Whether the last frame belongs to an episode that has not ended */
+        bool episode_open;
+
+        /** @brief Counts sample calls, marking the frames drawn by the current one */
+        uint32_t generation;
+
+        /** @brief Random number generator for sampling */
+        std::mt19937 gen;
+
+        /**
+         * @brief Writes an observation into the next frame, dropping the step of the frame it replaces.
+         *
+         * @param observation The observation (state size).
+         * @return The frame written.
+         */
+        size_t write_frame(Span<const double> observation);
+};
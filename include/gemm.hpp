@@ -0,0 +1,138 @@
+#pragma once
+#include "matrix.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Dense linear algebra kernels used by the layers.
+ *
+ * All matrices are row-major and described by a pointer plus a leading dimension
+ * (the distance in elements between the starts of consecutive rows). The kernels are
+ * self-contained: large products go through a cache-blocked, packed, register-tiled
+ * GEMM, and the inner micro-kernel is compiled for AVX2/FMA as well as the baseline
+ * instruction set and picked at runtime. Every kernel has a double and a float
+ * overload; the float register tile is twice as wide. The int8 kernels used for
+ * quantized inference widen to 16 bits and accumulate exactly in 32 bits, using the
+ * AVX-512 VNNI dot-product instructions when the CPU has them and AVX2 otherwise.
+ */
+namespace Gemm {
+    /**
+     * @brief Whether an operand is used as stored or transposed.
+     */
+    enum class Transpose {
+        No,
+        Yes
+    };
+
+    /**
+     * @brief Computes C = alpha * op(A) * op(B) + beta * C.
+     *
+     * op(A) is m x k and op(B) is k x n, so A is stored as m x k (or k x m when
+     * transposed) and likewise for B. When beta is 0, C is not read, so it may hold
+     * uninitialized values.
+     *
+     * @param trans_a Whether A is transposed.
+     * @param trans_b Whether B is transposed.
+     * @param m Rows of op(A) and C.
+     * @param n Columns of op(B) and C.
+     * @param k Columns of op(A) and rows of op(B).
+     * @param alpha Scale applied to the product.
+     * @param a Pointer to A.
+     * @param lda Leading dimension of A.
+     * @param b Pointer to B.
+     * @param ldb Leading dimension of B.
+     * @param beta Scale applied to the existing contents of C.
+     * @param c Pointer to C.
+     * @param ldc Leading dimension of C.
+     */
+    void gemm(Transpose trans_a, Transpose trans_b, std::size_t m, std::size_t n, std::size_t k,
+              double alpha, const double* a, std::size_t lda, const double* b, std::size_t ldb,
+              double beta, double* c, std::size_t ldc);
+
+    /**
+     * @brief Single-precision overload of gemm.
+     */
+    void gemm(Transpose trans_a, Transpose trans_b, std::size_t m, std::size_t n, std::size_t k,
+              float alpha, const float* a, std::size_t lda, const float* b, std::size_t ldb,
+              float beta, float* c, std::size_t ldc);
+
+    /**
+     * @brief Computes C = alpha * op(A) * op(B) + beta * C on matrix views.
+     *
+     * @param trans_a Whether A is transposed.
+     * @param trans_b Whether B is transposed.
+     * @param alpha Scale applied to the product.
+     * @param a View of A.
+     * @param b View of B.
+     * @param beta Scale applied to the existing contents of C.
+     * @param c View of C; its shape must match op(A) * op(B).
+     * @throws std::invalid_argument If the shapes are not compatible.
+     */
+    void gemm(Transpose trans_a, Transpose trans_b, double alpha, ConstMatrixView a, ConstMatrixView b,
+              double beta, MatrixView c);
+
+    /**
+     * @brief Single-precision overload of gemm on matrix views.
+     */
+    void gemm(Transpose trans_a, Transpose trans_b, float alpha, ConstMatrixViewF a, ConstMatrixViewF b,
+              float beta, MatrixViewF c);
+
+    /**
+     * @brief Computes y = alpha * op(A) * x + beta * y.
+     *
+     * A is stored as m x n. Without transposition x has n elements and y has m;
+     * with transposition x has m elements and y has n. When beta is 0, y is not read.
+     *
+     * @param trans_a Whether A is transposed.
+     * @param m Rows of A as stored.
+     * @param n Columns of A as stored.
+     * @param alpha Scale applied to the product.
+     * @param a Pointer to A.
+     * @param lda Leading dimension of A.
+     * @param x The input vector.
+     * @param beta Scale applied to the existing contents of y.
+     * @param y The output vector.
+     */
+    void gemv(Transpose trans_a, std::size_t m, std::size_t n, double alpha, const double* a, std::size_t lda,
+              const double* x, double beta, double* y);
+
+    /**
+     * @brief Single-precision overload of gemv.
+     */
+    void gemv(Transpose trans_a, std::size_t m, std::size_t n, float alpha, const float* a, std::size_t lda,
+              const float* x, float beta, float* y);
+
+    /**
+     * @brief Computes C = A * B^T for int8 matrices with exact int32 results.
+     *
+     * Each C(i, j) is the dot product of row i of A with row j of B, so B is laid out
+     * like Dense weights (one row per output). A is m x k, B is n x k and C is m x n.
+     * C is overwritten. Results are exact as long as k * 128 * 128 fits in an int32,
+     * which holds for any k below 131072.
+     *
+     * @param m Rows of A and C.
+     * @param n Rows of B and columns of C.
+     * @param k Columns of A and B.
+     * @param a Pointer to A.
+     * @param lda Leading dimension of A.
+     * @param b Pointer to B.
+     * @param ldb Leading dimension of B.
+     * @param c Pointer to C.
+     * @param ldc Leading dimension of C.
+     */
+    void gemm_s8(std::size_t m, std::size_t n, std::size_t k, const std::int8_t* a, std::size_t lda,
+                 const std::int8_t* b, std::size_t ldb, std::int32_t* c, std::size_t ldc);
+
+    /**
+     * @brief Computes y = A * x for an int8 matrix and vector with exact int32 results.
+     *
+     * @param m Rows of A and elements of y.
+     * @param n Columns of A and elements of x.
+     * @param a Pointer to A.
+     * @param lda Leading dimension of A.
+     * @param x The input vector.
+     * @param y The output vector; overwritten.
+     */
+    void gemv_s8(std::size_t m, std::size_t n, const std::int8_t* a, std::size_t lda, const std::int8_t* x,
+                 std::int32_t* y);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "neuralnet.hpp"
+#include "thread_pool.hpp"
+#include <vector>
+
+/**
+ * @brief Lock-free asynchronous SGD ("Hogwild") training of a NeuralNet on a thread pool.
+ * 
+ * Every worker takes its own slice of the samples and runs per-sample forward and
+ * backward passes directly against the model's shared layers, updating the
+ * parameters after each sample without any locking. Parameter accesses are relaxed
+ * atomics, so there is no undefined behaviour, but updates from different threads
+ * to the same weight may overwrite each other and reads may see a mix of old and
+ * new values. This trades determinism for throughput and converges well when each
+ * sample touches a small part of the weights.
+ * 
+ * Hogwild always applies plain SGD; optimizers set on the layers are ignored.
+ * Nothing else may use the model (including predict) while train is running.
+ */
+class HogwildTrainer {
+    private:
+        /** @brief The network being trained, shared by all workers */
+        NeuralNet& model;
+
+        /** @brief The pool the workers run on */
+        ThreadPool& pool;
+
+    public:
+        /**
+         * @brief Creates a trainer for a model.
+         * 
+         * @param model The network to train; must have a loss function.
+         * @param pool The pool to run on.
+         * @throws std::invalid_argument If the model has no loss function.
+         */
+        HogwildTrainer(NeuralNet& model, ThreadPool& pool);
+
+        /**
+         * @brief Trains the model, with every worker applying per-sample updates concurrently.
+         * 
+         * @param inputs Vector of input vectors for training.
+         * @param targets Vector of target (ground truth) vectors.
+         * @param epochs Number of training epochs.
+         * @param learning_rate Learning rate for the SGD updates.
+         * @return The average loss over the last epoch, measured before each sample's update.
+         * @throws std::invalid_argument If inputs and targets differ in length or a sample has the wrong size.
+         */
+        double train(const std::vector<std::vector<double>>& inputs, const std::vector<std::vector<double>>& targets,
+                     int epochs, double learning_rate);
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include "neuralnet.hpp"
+#include "span.hpp"
+#include <vector>
+#include <memory>
+
+/**
+ * @brief Preplanned, allocation-free forward pass through a NeuralNet.
+ * 
+ * The plan walks the layers once at construction to work out every intermediate
+ * size and allocates two activation buffers large enough for any of them. predict
+ * then alternates between the two buffers (ping-pong), reading the caller's input
+ * directly and writing the last layer straight into the caller's output, so a call
+ * performs no heap allocations.
+ * 
+ * The plan shares the network's layers rather than copying them, so later weight
+ * updates are visible to it; layers added to the network afterwards are not. A plan
+ * owns its buffers and must not be used by several threads at once; create one plan
+ * per thread instead.
+ * 
+ * @tparam T The scalar type of the network.
+ */
+template<typename T>
+class BasicInferencePlan {
+    private:
+        /** @brief The layers to run, shared with the network */
+        std::vector<std::shared_ptr<const BasicLayer<T>>> layers;
+
+        /** @brief sizes[0] is the input size, sizes[i + 1] the output size of layer i */
+        std::vector<size_t> sizes;
+
+        /** @brief The two intermediate activation buffers */
+        std::vector<T, AlignedAllocator<T>> buffers[2];
+
+    public:
+        /**
+         * @brief Builds a plan for running net on inputs of a fixed size.
+         * 
+         * @param net The network to run.
+         * @param input_size The number of input features.
+         * @throws std::invalid_argument If a layer cannot accept the size produced by the previous one.
+         */
+        BasicInferencePlan(const BasicNeuralNet<T>& net, size_t input_size);
+
+        /**
+         * @brief Gets the number of input features the plan expects.
+         * 
+         * @return The input size.
+         */
+        size_t input_size() const;
+
+        /**
+         * @brief Gets the number of output values the plan produces.
+         * 
+         * @return The output size.
+         */
+        size_t output_size() const;
+
+        /**
+         * @brief Runs the network on one sample without allocating.
+         * 
+         * @param input The input features (input_size()).
+         * @param output Receives the prediction (output_size()); must not overlap input.
+         * @throws std::invalid_argument If either buffer has the wrong size.
+         */
+        void predict(Span<const T> input, Span<T> output);
+};
+
+using InferencePlan = BasicInferencePlan<double>;
+using InferencePlanF = BasicInferencePlan<float>;
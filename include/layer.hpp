@@ -1,4 +1,6 @@
 #pragma once
+#include "matrix.hpp"
+#include "span.hpp"
 #include <vector>
 #include <memory>
 
@@ -7,8 +9,13 @@
  * 
  * This abstract class defines the interface that all layer implementations must follow.
  * It includes methods for forward propagation, backward propagation, and cloning.
+ * Activations, inputs and parameters are stored as T; learning rates stay double.
+ * Instantiated for float and double.
+ * 
+ * @tparam T The scalar type.
  */
-class Layer {
+template<typename T>
+class BasicLayer {
     public:
         /**
          * @brief Performs forward propagation through the layer.
@@ -16,7 +23,7 @@ class Layer {
          * @param input The input vector to the layer.
          * @return The output vector from the layer.
          */
-        virtual std::vector<double> forward(const std::vector<double>& input) = 0;
+        virtual std::vector<T> forward(const std::vector<T>& input) = 0;
         
         /**
          * @brief Performs backward propagation through the layer.
@@ -25,17 +32,163 @@ class Layer {
          * @param learning_rate The learning rate for parameter updates.
          * @return The gradient to pass to the previous layer.
          */
-        virtual std::vector<double> backward(const std::vector<double>& grad_output, double learning_rate) = 0;
+        virtual std::vector<T> backward(const std::vector<T>& grad_output, double learning_rate) = 0;
+
+        /**
+         * @brief Performs forward propagation for a mini-batch.
+         * 
+         * Each row of the input matrix is one sample, so a batch of B samples with
+         * n features is a B x n matrix.
+         * 
+         * @param input The input batch (batch_size x input_size).
+         * @return The output batch (batch_size x output_size).
+         */
+        virtual BasicMatrix<T> forward_batch(const BasicMatrix<T>& input) = 0;
+
+        /**
+         * @brief Performs backward propagation for the mini-batch seen by the last forward_batch call.
+         * 
+         * Parameter gradients are summed over the rows of the batch before a single update is applied.
+         * 
+         * @param grad_output The gradient from the next layer (batch_size x output_size).
+         * @param learning_rate The learning rate for parameter updates.
+         * @return The gradient to pass to the previous layer (batch_size x input_size).
+         */
+        virtual BasicMatrix<T> backward_batch(const BasicMatrix<T>& grad_output, double learning_rate) = 0;
+
+        /**
+         * @brief Computes the forward pass for one sample while other threads may be updating the parameters.
+         * 
+         * Used by Hogwild training. Parameters are read with relaxed atomic loads, so
+         * the result may mix values from before and after a concurrent update.
+         * 
+         * @param input The input features.
+         * @param output Receives output_size(input.size()) values.
+         */
+        virtual void forward_hogwild(Span<const T> input, Span<T> output) const = 0;
+
+        /**
+         * @brief Backpropagates one sample and applies a plain SGD update concurrently with other threads.
+         * 
+         * Used by Hogwild training. The layer keeps no per-sample state; the caller
+         * passes the input it gave forward_hogwild. Parameters are updated with relaxed
+         * atomic loads and stores but no locks, so concurrent updates to the same
+         * parameter can overwrite each other. Optimizers are not used, since their
+         * state cannot be shared safely.
+         * 
+         * @param input The input this layer saw in the forward pass.
+         * @param grad_output The gradient from the next layer.
+         * @param grad_input Receives the gradient to pass to the previous layer (input.size()).
+         * @param learning_rate The learning rate.
+         */
+        virtual void backward_hogwild(Span<const T> input, Span<const T> grad_output, Span<T> grad_input,
+                                      double learning_rate) = 0;
+
+        /**
+         * @brief Gets the number of trainable parameters in this layer.
+         * 
+         * @return The length of the flat gradient buffer used by compute_gradients and apply_gradients.
+         */
+        virtual size_t parameter_count() const = 0;
+
+        /**
+         * @brief Computes gradients for the mini-batch seen by the last forward_batch call without updating anything.
+         * 
+         * Together with apply_gradients this splits backward_batch in two, so gradients
+         * from several copies of a layer can be combined before a single update.
+         * 
+         * @param grad_output The gradient from the next layer (batch_size x output_size).
+         * @param parameter_gradients Receives the parameter gradients summed over the batch (parameter_count()).
+         * @return The gradient to pass to the previous layer (batch_size x input_size).
+         */
+        virtual BasicMatrix<T> compute_gradients(const BasicMatrix<T>& grad_output, Span<T> parameter_gradients) = 0;
+
+        /**
+         * @brief Like compute_gradients, but adds the gradients to those already in the buffer.
+         * 
+         * Lets a caller sum the gradients of several mini-batches and apply them with a
+         * single apply_gradients call.
+         * 
+         * @param grad_output The gradient from the next layer (batch_size x output_size).
+         * @param parameter_gradients Accumulates the parameter gradients summed over the batch (parameter_count()).
+         * @return The gradient to pass to the previous layer (batch_size x input_size).
+         */
+        virtual BasicMatrix<T> accumulate_gradients(const BasicMatrix<T>& grad_output, Span<T> parameter_gradients) = 0;
+
+        /**
+         * @brief Updates the parameters from a flat gradient buffer, using the optimizer if one is set.
+         * 
+         * @param parameter_gradients The parameter gradients (parameter_count()).
+         * @param learning_rate The learning rate for plain gradient descent.
+         */
+        virtual void apply_gradients(Span<const T> parameter_gradients, double learning_rate) = 0;
+
+        /**
+         * @brief Overwrites this layer's parameters with those of another layer of the same type and shape.
+         * 
+         * Optimizer state and caches are left untouched.
+         * 
+         * @param source The layer to copy from.
+         * @throws std::invalid_argument If source is a different kind or shape of layer.
+         */
+        virtual void copy_parameters_from(const BasicLayer& source) = 0;
+
+        /**
+         * @brief Moves the parameters into external storage, which the layer then uses in place.
+         * 
+         * The current values are copied into storage in the same layout as the gradient
+         * buffer of compute_gradients, so a network can keep all parameters in one
+         * contiguous arena and update them with a single optimizer sweep.
+         * 
+         * @param storage Receives the parameters (parameter_count()).
+         * @param owner Handle that keeps storage alive while the layer refers to it.
+         * @throws std::invalid_argument If storage does not have parameter_count() elements.
+         */
+        virtual void bind_parameters(Span<T> storage, std::shared_ptr<void> owner) = 0;
+
+        /**
+         * @brief Gets the output size this layer produces for a given input size.
+         * 
+         * @param input_size The number of input features.
+         * @return The number of output features.
+         * @throws std::invalid_argument If the layer cannot accept input_size features.
+         */
+        virtual size_t output_size(size_t input_size) const = 0;
+
+        /**
+         * @brief Computes the forward pass for one sample into a caller-provided buffer.
+         * 
+         * Unlike forward, this does not record anything for backpropagation and does not
+         * allocate. The buffers must not overlap.
+         * 
+         * @param input The input features.
+         * @param output Receives output_size(input.size()) values.
+         */
+        virtual void infer(Span<const T> input, Span<T> output) const = 0;
+
+        /**
+         * @brief Computes the forward pass for a mini-batch into a caller-provided view.
+         * 
+         * Like infer, this leaves the layer untouched, so several threads may call it on
+         * the same layer at once. The views must not overlap.
+         * 
+         * @param input The input batch (batch_size x input_size).
+         * @param output Receives the output batch (batch_size x output_size(input_size)).
+         */
+        virtual void infer_batch(BasicConstMatrixView<T> input, BasicMatrixView<T> output) const = 0;
 
         /**
          * @brief Creates a deep copy of this layer.
          * 
          * @return A unique pointer to a new instance of this layer.
          */
-        virtual std::unique_ptr<Layer> clone() const = 0;
+        virtual std::unique_ptr<BasicLayer> clone() const = 0;
 
         /**
          * @brief Virtual destructor for proper cleanup in derived classes.
          */
-        virtual ~Layer() = default;
-};
\ No newline at end of file
+        virtual ~BasicLayer() = default;
+};
+
+using Layer = BasicLayer<double>;
+using LayerF = BasicLayer<float>;
@@ -1,4 +1,5 @@
 #pragma once
+#include "matrix.hpp"
 #include <vector>
 #include <memory>
 
@@ -6,9 +7,14 @@
  * @brief Base abstract class for loss functions.
  * 
  * This abstract class defines the interface that all loss function implementations must follow.
- * It includes methods for computing the loss and its gradient.
+ * It includes methods for computing the loss and its gradient. Predictions, targets
+ * and gradients are stored as T, while loss values are accumulated and returned as
+ * double. Instantiated for float and double.
+ * 
+ * @tparam T The scalar type.
  */
-class Loss {
+template<typename T>
+class BasicLoss {
     public:
         /**
          * @brief Computes the loss between predicted and actual values.
@@ -17,7 +23,7 @@ class Loss {
          * @param actual The target (ground truth) output.
          * @return The scalar loss value.
          */
-        virtual double compute(const std::vector<double>& predicted, const std::vector<double>& actual) = 0;
+        virtual double compute(const std::vector<T>& predicted, const std::vector<T>& actual) = 0;
         
         /**
          * @brief Computes the gradient of the loss with respect to predicted values.
@@ -26,19 +32,37 @@ class Loss {
          * @param actual The target (ground truth) output.
          * @return The gradient vector.
          */
-        virtual std::vector<double> gradient(const std::vector<double>& predicted, const std::vector<double>& actual) = 0;
+        virtual std::vector<T> gradient(const std::vector<T>& predicted, const std::vector<T>& actual) = 0;
+
+        /**
+         * @brief Computes the loss averaged over a mini-batch.
+         * 
+         * @param predicted The predicted batch (batch_size x output_size), one sample per row.
+         * @param actual The target batch, same shape as predicted.
+         * @return The mean of the per-sample losses.
+         */
+        virtual double compute_batch(const BasicMatrix<T>& predicted, const BasicMatrix<T>& actual) = 0;
+
+        /**
+         * @brief Computes the gradient of the batch-averaged loss with respect to each prediction.
+         * 
+         * @param predicted The predicted batch (batch_size x output_size), one sample per row.
+         * @param actual The target batch, same shape as predicted.
+         * @return The gradient matrix, same shape as predicted.
+         */
+        virtual BasicMatrix<T> gradient_batch(const BasicMatrix<T>& predicted, const BasicMatrix<T>& actual) = 0;
 
         /**
          * @brief Creates a deep copy of this loss function.
          * 
          * @return A unique pointer to a new instance of this loss function.
          */
-        virtual std::unique_ptr<Loss> clone() const = 0;
+        virtual std::unique_ptr<BasicLoss> clone() const = 0;
 
         /**
          * @brief Virtual destructor for proper cleanup in derived classes.
          */
-        virtual ~Loss() = default;
+        virtual ~BasicLoss() = default;
 };
 
 #include <memory>
@@ -48,8 +72,11 @@ class Loss {
  * 
  * The MSE loss computes the average squared difference between predicted and actual values.
  * It is commonly used for regression problems.
+ * 
+ * @tparam T The scalar type.
  */
-class MSELoss : public Loss {
+template<typename T>
+class BasicMSELoss : public BasicLoss<T> {
     public:
         /**
          * @brief Computes the MSE loss.
@@ -58,7 +85,7 @@ class MSELoss : public Loss {
          * @param actual The target (ground truth) output.
          * @return The MSE loss value.
          */
-        double compute(const std::vector<double>& predicted, const std::vector<double>& actual) override;
+        double compute(const std::vector<T>& predicted, const std::vector<T>& actual) override;
         
         /**
          * @brief Computes the gradient of the MSE loss.
@@ -67,12 +94,36 @@ class MSELoss : public Loss {
          * @param actual The target (ground truth) output.
          * @return The gradient vector.
          */
-        std::vector<double> gradient(const std::vector<double>& predicted, const std::vector<double>& actual) override;
+        std::vector<T> gradient(const std::vector<T>& predicted, const std::vector<T>& actual) override;
+
+        /**
+         * @brief Computes the MSE loss averaged over a mini-batch.
+         * 
+         * @param predicted The predicted batch.
+         * @param actual The target batch.
+         * @return The mean MSE over the batch.
+         */
+        double compute_batch(const BasicMatrix<T>& predicted, const BasicMatrix<T>& actual) override;
+
+        /**
+         * @brief Computes the gradient of the batch-averaged MSE loss.
+         * 
+         * @param predicted The predicted batch.
+         * @param actual The target batch.
+         * @return The gradient matrix.
+         */
+        BasicMatrix<T> gradient_batch(const BasicMatrix<T>& predicted, const BasicMatrix<T>& actual) override;
         
         /**
          * @brief Creates a deep copy of this loss function.
          * 
          * @return A unique pointer to a new instance of this loss function.
          */
-        std::unique_ptr<Loss> clone() const override;
-};
\ No newline at end of file
+        std::unique_ptr<BasicLoss<T>> clone() const override;
+};
+
+using Loss = BasicLoss<double>;
+using MSELoss = BasicMSELoss<double>;
+
+using LossF = BasicLoss<float>;
+using MSELossF = BasicMSELoss<float>;
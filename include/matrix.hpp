@@ -0,0 +1,274 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace Memory {
+    /** @brief Running count of blocks handed out by AlignedAllocator */
+    inline std::atomic<std::size_t> aligned_allocations{0};
+
+    /**
+     * @brief Debug counter of the heap blocks allocated through AlignedAllocator.
+     *
+     * Matrix storage, GEMM packing buffers and StepArena blocks all come from
+     * AlignedAllocator, so an unchanged count across a training step means the step did
+     * not allocate any of them. Updated with relaxed atomics, so it is safe to read from
+     * any thread but only meaningful while no other thread is allocating.
+     *
+     * @return The number of allocations since the program started.
+     */
+    inline std::size_t allocation_count() {
+        return aligned_allocations.load(std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Standard-compatible allocator that returns memory aligned to a fixed boundary.
+ *
+ * Used for weight and activation storage so that every buffer starts on a cache-line
+ * boundary and vectorized loops never straddle lines at the start of a row.
+ *
+ * @tparam T The element type.
+ * @tparam Alignment The alignment in bytes (must be a power of two).
+ */
+template<typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        Memory::aligned_allocations.fetch_add(1, std::memory_order_relaxed);
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+/**
+ * @brief Non-owning, stride-aware view over a row-major block of elements.
+ *
+ * Element (i, j) lives at data[i * stride + j]. The stride may be larger than the
+ * number of columns, which allows views over sub-blocks of a larger matrix.
+ *
+ * @tparam T The element type.
+ */
+template<typename T>
+struct BasicMatrixView {
+    /** @brief Pointer to element (0, 0) */
+    T* data;
+
+    /** @brief Number of rows in the view */
+    std::size_t rows;
+
+    /** @brief Number of columns in the view */
+    std::size_t cols;
+
+    /** @brief Distance in elements between the starts of consecutive rows */
+    std::size_t stride;
+
+    T* row(std::size_t i) const { return data + i * stride; }
+    T& operator()(std::size_t i, std::size_t j) const { return data[i * stride + j]; }
+};
+
+/**
+ * @brief Read-only counterpart of BasicMatrixView.
+ *
+ * @tparam T The element type.
+ */
+template<typename T>
+struct BasicConstMatrixView {
+    /** @brief Pointer to element (0, 0) */
+    const T* data;
+
+    /** @brief Number of rows in the view */
+    std::size_t rows;
+
+    /** @brief Number of columns in the view */
+    std::size_t cols;
+
+    /** @brief Distance in elements between the starts of consecutive rows */
+    std::size_t stride;
+
+    BasicConstMatrixView(const T* d, std::size_t r, std::size_t c, std::size_t s)
+        : data(d), rows(r), cols(c), stride(s) {}
+
+    BasicConstMatrixView(const BasicMatrixView<T>& other)
+        : data(other.data), rows(other.rows), cols(other.cols), stride(other.stride) {}
+
+    const T* row(std::size_t i) const { return data + i * stride; }
+    const T& operator()(std::size_t i, std::size_t j) const { return data[i * stride + j]; }
+};
+
+/**
+ * @brief Dense row-major matrix backed by a single contiguous, 64-byte aligned buffer.
+ *
+ * Rows are packed back to back (stride == cols), so the whole matrix can also be
+ * treated as one flat array of rows() * cols() elements. Instantiated for float
+ * and double.
+ *
+ * A matrix can also borrow external memory, such as a memory-mapped model file,
+ * instead of owning its elements. A borrowed matrix reads and writes that memory in
+ * place and keeps it alive through a shared owner handle. Copies always own their
+ * storage, and resizing a borrowed matrix to a different shape detaches it.
+ *
+ * @tparam T The element type.
+ */
+template<typename T>
+class BasicMatrix {
+    private:
+        /** @brief The contiguous element storage; unused while the matrix is borrowed */
+        std::vector<T, AlignedAllocator<T>> storage;
+
+        /** @brief Element (0, 0): storage.data(), or the external memory of a borrowed matrix */
+        T* elements;
+
+        /** @brief Keeps the external memory of a borrowed matrix alive, if it needs an owner */
+        std::shared_ptr<void> owner;
+
+        /** @brief Number of rows */
+        std::size_t num_rows;
+
+        /** @brief Number of columns */
+        std::size_t num_cols;
+
+    public:
+        using value_type = T;
+
+        /**
+         * @brief Constructs an empty 0 x 0 matrix.
+         */
+        BasicMatrix();
+
+        /**
+         * @brief Constructs a matrix of the given shape with every element set to value.
+         *
+         * @param rows The number of rows.
+         * @param cols The number of columns.
+         * @param value The initial value of every element.
+         */
+        BasicMatrix(std::size_t rows, std::size_t cols, T value = T(0));
+
+        /**
+         * @brief Constructs a copy of a matrix with a different element type, converting every element.
+         *
+         * @param other The matrix to convert.
+         */
+        template<typename U>
+        explicit BasicMatrix(const BasicMatrix<U>& other) : storage(other.data(), other.data() + other.size()),
+                                                            elements(storage.data()),
+                                                            num_rows(other.rows()), num_cols(other.cols()) {}
+
+        /**
+         * @brief Constructs a matrix over external memory without copying it.
+         *
+         * @param data Pointer to rows * cols contiguous row-major elements, which should be 64-byte aligned.
+         * @param rows The number of rows.
+         * @param cols The number of columns.
+         * @param owner Handle that keeps the memory alive while the matrix refers to it; may be null
+         *              if the caller keeps the memory alive for the lifetime of the matrix.
+         */
+        BasicMatrix(T* data, std::size_t rows, std::size_t cols, std::shared_ptr<void> owner);
+
+        /**
+         * @brief Constructs a deep copy; the copy owns its storage even if other is borrowed.
+         *
+         * @param other The matrix to copy.
+         */
+        BasicMatrix(const BasicMatrix& other);
+
+        /**
+         * @brief Takes over the storage (owned or borrowed) of another matrix, leaving it empty.
+         *
+         * @param other The matrix to move from.
+         */
+        BasicMatrix(BasicMatrix&& other) noexcept;
+
+        /**
+         * @brief Copies the shape and elements of another matrix into owned storage.
+         *
+         * @param other The matrix to copy.
+         * @return This matrix.
+         */
+        BasicMatrix& operator=(const BasicMatrix& other);
+
+        /**
+         * @brief Takes over the storage (owned or borrowed) of another matrix, leaving it empty.
+         *
+         * @param other The matrix to move from.
+         * @return This matrix.
+         */
+        BasicMatrix& operator=(BasicMatrix&& other) noexcept;
+
+        /**
+         * @brief Changes the shape of the matrix.
+         *
+         * Existing capacity is reused, so shrinking or resizing back to a previously
+         * seen shape does not allocate. Element values are unspecified afterwards.
+         * A borrowed matrix keeps its memory if the shape is unchanged and otherwise
+         * switches to owned storage.
+         *
+         * @param rows The new number of rows.
+         * @param cols The new number of columns.
+         */
+        void resize(std::size_t rows, std::size_t cols);
+
+        /**
+         * @brief Sets every element to value.
+         *
+         * @param value The value to assign.
+         */
+        void fill(T value);
+
+        std::size_t rows() const { return num_rows; }
+        std::size_t cols() const { return num_cols; }
+        std::size_t stride() const { return num_cols; }
+        std::size_t size() const { return num_rows * num_cols; }
+        bool empty() const { return size() == 0; }
+        bool borrowed() const { return elements != storage.data(); }
+
+        T* data() { return elements; }
+        const T* data() const { return elements; }
+
+        T* row(std::size_t i) { return elements + i * num_cols; }
+        const T* row(std::size_t i) const { return elements + i * num_cols; }
+
+        T& operator()(std::size_t i, std::size_t j) { return elements[i * num_cols + j]; }
+        const T& operator()(std::size_t i, std::size_t j) const { return elements[i * num_cols + j]; }
+
+        /**
+         * @brief Returns a mutable view over the whole matrix.
+         */
+        BasicMatrixView<T> view() { return BasicMatrixView<T>{elements, num_rows, num_cols, num_cols}; }
+
+        /**
+         * @brief Returns a read-only view over the whole matrix.
+         */
+        BasicConstMatrixView<T> view() const { return BasicConstMatrixView<T>(elements, num_rows, num_cols, num_cols); }
+};
+
+using MatrixView = BasicMatrixView<double>;
+using ConstMatrixView = BasicConstMatrixView<double>;
+using Matrix = BasicMatrix<double>;
+
+using MatrixViewF = BasicMatrixView<float>;
+using ConstMatrixViewF = BasicConstMatrixView<float>;
+using MatrixF = BasicMatrix<float>;
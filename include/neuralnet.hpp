@@ -1,86 +1,297 @@
 #pragma once
 #include "layer.hpp"
 #include "loss.hpp"
+#include "parameter_arena.hpp"
+#include "step_arena.hpp"
+#include "thread_pool.hpp"
 #include <vector>
 #include <memory>
+#include <string>
+
+template<typename T>
+class BasicCheckpointer;
 
 /**
  * @brief Main neural network class that manages layers and training.
  * 
  * This class represents a fully-connected neural network and provides methods
- * for building, training, and using the network for predictions.
+ * for building, training, and using the network for predictions. Instantiated for
+ * float and double; every layer and the loss must use the same scalar type.
+ * 
+ * @tparam T The scalar type of the inputs, outputs and parameters.
  */
-class NeuralNet {
+template<typename T>
+class BasicNeuralNet {
     private:
         /** @brief The layers in the network */
-        std::vector<std::shared_ptr<Layer>> layers;
+        std::vector<std::shared_ptr<BasicLayer<T>>> layers;
         
         /** @brief The loss function used for training */
-        std::shared_ptr<Loss> loss_function;
+        std::shared_ptr<BasicLoss<T>> loss_function;
+
+        /** @brief Flat parameter and gradient storage used by train once setOptimizer is called, or null */
+        std::unique_ptr<BasicParameterArena<T>> arena;
+
+        /** @brief Largest global gradient norm allowed when training through the arena; 0 disables clipping */
+        double max_gradient_norm = 0.0;
+
+        /** @brief Scratch for the temporaries of one training step, reset before every mini-batch */
+        StepArena step_arena;
+
+        /**
+         * @brief Runs one sample through the layers' training forward pass, filling their caches.
+         * 
+         * @param input The input vector.
+         * @return The network output.
+         */
+        std::vector<T> forward(const std::vector<T>& input);
+
+        /**
+         * @brief Runs a mini-batch through the layers' training forward pass, filling their caches.
+         * 
+         * @param inputs The input batch, one sample per row.
+         * @return The network output, one sample per row.
+         */
+        BasicMatrix<T> forward_batch(const BasicMatrix<T>& inputs);
+
+        /**
+         * @brief Runs a block of rows through the layers' const inference path.
+         * 
+         * @param input The input rows.
+         * @param output Receives the network output for those rows.
+         * @param ping Scratch for intermediate activations, resized as needed.
+         * @param pong Second scratch buffer, alternated with ping.
+         */
+        void infer_rows(BasicConstMatrixView<T> input, BasicMatrixView<T> output,
+                        BasicMatrix<T>& ping, BasicMatrix<T>& pong) const;
     
     public:
         /**
          * @brief Adds a layer to the network.
          * 
-         * Layers are executed in the order they are added.
+         * Layers are executed in the order they are added. If the network already has a
+         * parameter arena, it is rebuilt to include the new layer; the optimizer state of
+         * the existing parameters is kept.
          * 
          * @param layer The layer to add to the network.
          */
-        void addLayer(std::shared_ptr<Layer> layer);
+        void addLayer(std::shared_ptr<BasicLayer<T>> layer);
         
         /**
          * @brief Sets the loss function for the network.
          * 
          * @param loss The loss function to use.
          */
-        void setLoss(std::shared_ptr<Loss> loss);
+        void setLoss(std::shared_ptr<BasicLoss<T>> loss);
+        
+        /**
+         * @brief Gets the loss function used for training.
+         * 
+         * @return The loss function, or nullptr if none is set.
+         */
+        std::shared_ptr<BasicLoss<T>> getLoss() const;
+
+        /**
+         * @brief Moves all parameters into one arena updated by a single network-wide optimizer.
+         * 
+         * The parameters of every layer are copied into one contiguous buffer that the
+         * layers then view, and train applies each step as one sweep over it with the
+         * given optimizer instead of calling the per-layer optimizers. Replaces any arena
+         * set before.
+         * 
+         * @param optimizer The optimizer for all parameters, or null for plain gradient
+         *        descent at the learning rate passed to train.
+         */
+        void setOptimizer(std::unique_ptr<BasicOptimizer<T>> optimizer);
+
+        /**
+         * @brief Limits the global L2 norm of each step's gradients when training through the arena.
+         * 
+         * @param max_norm The largest allowed norm, or 0 to disable clipping.
+         * @throws std::invalid_argument If max_norm is negative.
+         */
+        void setGradientClipping(double max_norm);
+
+        /**
+         * @brief Gets the gradient norm limit set by setGradientClipping.
+         * 
+         * @return The largest allowed norm, or 0 if clipping is disabled.
+         */
+        double getGradientClipping() const;
+
+        /**
+         * @brief Gets the parameter arena.
+         * 
+         * @return The arena, or nullptr if setOptimizer has not been called.
+         */
+        BasicParameterArena<T>* getParameterArena() const;
+        
+        /**
+         * @brief Gets the layers of the network in execution order.
+         * 
+         * @return The layers.
+         */
+        const std::vector<std::shared_ptr<BasicLayer<T>>>& getLayers() const;
+        
+        /**
+         * @brief Computes the output width of the network for a given input width.
+         * 
+         * @param input_size The number of input features.
+         * @return The number of output values.
+         * @throws std::invalid_argument If a layer cannot accept the width produced by the previous one.
+         */
+        size_t output_size(size_t input_size) const;
         
         /**
          * @brief Makes a prediction using the network.
          * 
+         * The layers are only read, with intermediate results kept in per-call scratch,
+         * so concurrent calls on one network are safe as long as nothing trains or
+         * modifies it at the same time.
+         * 
          * @param input The input vector.
          * @return The predicted output vector.
          */
-        std::vector<double> predict(const std::vector<double>& input);
+        std::vector<T> predict(const std::vector<T>& input) const;
+        
+        /**
+         * @brief Makes predictions for a mini-batch using the network.
+         * 
+         * Thread-safe in the same way as predict.
+         * 
+         * @param inputs The input batch, one sample per row.
+         * @return The predicted batch, one sample per row.
+         */
+        BasicMatrix<T> predict_batch(const BasicMatrix<T>& inputs) const;
+
+        /**
+         * @brief Makes predictions for a mini-batch, splitting the rows across a thread pool.
+         * 
+         * The rows are cut into a few blocks per worker so that work stealing can even
+         * out uneven progress; each thread runs its blocks through its own reusable
+         * scratch buffers, so repeated calls do not allocate once warmed up.
+         * 
+         * @param inputs The input batch, one sample per row.
+         * @param outputs Receives the predicted batch; resized to match. Must not be inputs.
+         * @param pool The pool to run on.
+         * @throws std::invalid_argument If outputs and inputs are the same matrix or a layer rejects the input width.
+         */
+        void predict_batch(const BasicMatrix<T>& inputs, BasicMatrix<T>& outputs, ThreadPool& pool) const;
         
         /**
          * @brief Trains the network on the provided dataset.
          * 
+         * With a batch size of 1 every sample is propagated and applied on its own. Larger
+         * batch sizes pack consecutive samples into a matrix, run them through the layers'
+         * batched forward/backward path and apply one update per mini-batch using the
+         * gradient of the batch-averaged loss. The last batch of an epoch may be smaller.
+         * 
+         * With a parameter arena (see setOptimizer) every batch size takes the batched
+         * path: the layers write their gradients into the arena, which clips them if
+         * requested and applies one optimizer step to all parameters at once.
+         * 
+         * With accumulation_steps above 1, the gradients of that many consecutive
+         * mini-batches are summed before a single update, weighted so that the step is the
+         * one a single batch of batch_size * accumulation_steps samples would take. Only
+         * one mini-batch of activations is held at a time, and there is one optimizer pass
+         * per group instead of one per mini-batch.
+         * 
+         * The batched path takes the activations and gradients of each mini-batch from a
+         * StepArena owned by the network and reset before the next one, so once the first
+         * mini-batch has sized it, training no longer allocates matrices (see
+         * Memory::allocation_count). The per-sample path returns vectors from every layer
+         * and still allocates.
+         * 
+         * With a checkpointer, epochs is the total length of the run: training starts
+         * after the epochs the checkpointer has already completed (for example after
+         * restoring a checkpoint) and hands a snapshot to it every interval epochs and
+         * after the last one. Since training is deterministic, a run resumed from a
+         * checkpoint ends with exactly the parameters of an uninterrupted run.
+         * 
          * @param inputs Vector of input vectors for training.
          * @param targets Vector of target (ground truth) vectors.
          * @param epochs Number of training epochs.
          * @param learning_rate Learning rate for gradient descent.
+         * @param batch_size Number of samples per forward and backward pass.
+         * @param accumulation_steps Number of mini-batches whose gradients are combined into one update.
+         * @param checkpointer Optional checkpointer to resume from and save to.
+         * @throws std::invalid_argument If batch_size or accumulation_steps is 0, or inputs and targets differ in length.
          */
-        void train(const std::vector<std::vector<double>>& inputs, const std::vector<std::vector<double>>& targets, int epochs, double learning_rate);
+        void train(const std::vector<std::vector<T>>& inputs, const std::vector<std::vector<T>>& targets, int epochs, double learning_rate, size_t batch_size = 1,
+                   size_t accumulation_steps = 1, BasicCheckpointer<T>* checkpointer = nullptr);
 
         /**
          * @brief Default constructor.
          */
-        NeuralNet() = default;
+        BasicNeuralNet() = default;
         
         /**
          * @brief Copy constructor for creating a deep copy of the network.
          * 
          * @param other The network to copy.
          */
-        NeuralNet(const NeuralNet& other);
+        BasicNeuralNet(const BasicNeuralNet& other);
+
+        /** @brief Deleted copy assignment operator */
+        BasicNeuralNet& operator=(const BasicNeuralNet&) = delete;
 
         /**
-         * @brief Saves the network to a file.
+         * @brief Saves the layers of the network to a binary model file.
+         * 
+         * The file records the layer topology, activation kinds, weights and biases in a
+         * versioned format with every parameter blob on a 64-byte boundary (see
+         * src/serialization.cpp), along with the state of any Dense optimizers, the
+         * state of the arena optimizer and the number of completed training epochs. It is written to a temporary file and
+         * renamed into place, so a network currently mapped from filename is not
+         * disturbed and a crash never leaves a partial file. The loss function and the
+         * optimizer hyperparameters are not saved.
          * 
          * @param filename The path to the file where the network will be saved.
+         * @param epoch The number of completed training epochs to record.
+         * @throws std::invalid_argument If a layer is not a Dense or built-in Activation layer, or epoch is negative.
+         * @throws std::runtime_error If the file cannot be written.
          */
-        void save(const std::string& filename) const;
+        void save(const std::string& filename, int epoch = 0) const;
         
         /**
-         * @brief Loads the network from a file.
+         * @brief Replaces the layers of the network with those of a saved model file.
+         * 
+         * The file is memory-mapped copy-on-write and the Dense weights are borrowed
+         * straight from the mapping, so nothing is parsed or copied up front and pages
+         * are read in as they are first touched. Training the loaded network writes to
+         * private copies of the touched pages; the file itself is never modified. The
+         * mapping stays alive as long as any layer refers to it. The loss function is
+         * kept, and Dense layers start without an optimizer; any parameter arena is
+         * dropped, so call setOptimizer again to train through one.
          * 
          * @param filename The path to the file containing the saved network.
+         * @throws std::runtime_error If the file cannot be read, is not a model file, has an
+         *         unsupported version or was saved with a different scalar type.
          */
         void load(const std::string& filename);
 
+        /**
+         * @brief Restores parameters and optimizer state saved from a network of the same shape.
+         * 
+         * Unlike load, the existing layers and their optimizers are kept and the saved
+         * values are copied into them, so a network rebuilt with the same layers and
+         * optimizers continues training exactly where the saved one stopped. Optimizer
+         * state is restored into every Dense layer that has an optimizer and into the
+         * arena optimizer, if both the file and the network have one.
+         * 
+         * @param filename The path to the file containing the saved network.
+         * @return The number of completed training epochs recorded in the file.
+         * @throws std::runtime_error If the file cannot be read or its layers do not match the
+         *         network; the network is left unchanged in that case.
+         * @throws std::invalid_argument If the saved optimizer state does not fit a layer's optimizer.
+         */
+        int restore(const std::string& filename);
+
         /**
          * @brief Default destructor.
          */
-        ~NeuralNet() = default;
-};
\ No newline at end of file
+        ~BasicNeuralNet() = default;
+};
+
+using NeuralNet = BasicNeuralNet<double>;
+using NeuralNetF = BasicNeuralNet<float>;
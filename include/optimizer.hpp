@@ -1,42 +1,117 @@
 #pragma once
+#include "span.hpp"
+#include "simd.hpp"
 #include <vector>
 #include <memory>
 
+/**
+ * @brief Snapshot of the internal state of an optimizer.
+ * 
+ * Holds everything an optimizer accumulates while training, so that restoring it
+ * into an optimizer with the same hyperparameters continues the run bit-exactly.
+ * 
+ * @tparam T The scalar type.
+ */
+template<typename T>
+struct BasicOptimizerState {
+    /** @brief The per-parameter state vectors, e.g. the SGD velocity or the Adam moments */
+    std::vector<std::vector<T>> buffers;
+
+    /** @brief The step counter, e.g. the Adam timestep; zero for stateless schedules */
+    int step = 0;
+};
+
 /**
  * @brief Base abstract class for optimization algorithms.
  * 
  * This abstract class defines the interface that all optimizer implementations must follow.
- * Optimizers are used to update weights based on gradients during training.
+ * Optimizers are used to update weights based on gradients during training. Updates are
+ * applied in place through spans, so a layer can hand over views of its own parameter
+ * storage without copying; std::vector arguments convert implicitly.
+ * 
+ * A step can also be applied piecewise: begin_step() announces the size of the
+ * parameter block, then update_slice() is called for consecutive slices of it. This
+ * lets a layer update each weight row while it is still in cache from computing the
+ * row's gradient.
+ * 
+ * Parameters, gradients and optimizer state are stored as T, while hyperparameters
+ * are kept in double. Instantiated for float and double.
+ * 
+ * @tparam T The scalar type.
  */
-class Optimizer {
+template<typename T>
+class BasicOptimizer {
     public:
         /**
-         * @brief Updates weights based on gradients.
+         * @brief Updates weights in place based on gradients.
+         * 
+         * Equivalent to begin_step(weights.size()) followed by a single update_slice()
+         * over the whole block. Internal state is sized on the first call, so repeated
+         * updates of a same-sized parameter block do not allocate.
          * 
          * @param weights The weights to update.
-         * @param gradients The gradients used for the update.
+         * @param gradients The gradients used for the update; same size as weights.
+         * @throws std::invalid_argument If the sizes differ.
+         */
+        void update(Span<T> weights, Span<const T> gradients);
+
+        /**
+         * @brief Starts an optimization step over a parameter block.
+         * 
+         * Sizes the internal state for the block and advances any step counters. Must be
+         * called once per step before the update_slice() calls covering the block.
+         * 
+         * @param size The total number of parameters in the block.
          */
-        virtual void update(std::vector<double>& weights, const std::vector<double>& gradients) = 0;
+        virtual void begin_step(size_t size) = 0;
+
+        /**
+         * @brief Applies the current step to a slice of the parameter block.
+         * 
+         * @param weights The slice of weights to update.
+         * @param gradients The gradients for the slice; same size as weights.
+         * @param offset Position of the slice within the block, selecting the matching optimizer state.
+         * @throws std::invalid_argument If the sizes differ or the slice exceeds the block.
+         */
+        virtual void update_slice(Span<T> weights, Span<const T> gradients, size_t offset) = 0;
         
         /**
          * @brief Creates a deep copy of this optimizer.
          * 
          * @return A unique pointer to a new instance of this optimizer.
          */
-        virtual std::unique_ptr<Optimizer> clone() const = 0;
+        virtual std::unique_ptr<BasicOptimizer<T>> clone() const = 0;
+
+        /**
+         * @brief Exports the internal state of this optimizer.
+         * 
+         * @return A copy of the state vectors and step counter.
+         */
+        virtual BasicOptimizerState<T> getState() const = 0;
+
+        /**
+         * @brief Replaces the internal state of this optimizer.
+         * 
+         * @param state A state exported from an optimizer of the same kind.
+         * @throws std::invalid_argument If the state has the wrong number of buffers or they differ in size.
+         */
+        virtual void setState(const BasicOptimizerState<T>& state) = 0;
         
         /**
          * @brief Virtual destructor for proper cleanup in derived classes.
          */
-        virtual ~Optimizer() = default;
+        virtual ~BasicOptimizer() = default;
 };
 
 /**
  * @brief Stochastic Gradient Descent optimizer with momentum.
  * 
  * This optimizer implements the standard SGD algorithm with momentum support.
+ * 
+ * @tparam T The scalar type.
  */
-class SGD : public Optimizer {
+template<typename T>
+class BasicSGD : public BasicOptimizer<T> {
     private:
         /** @brief The learning rate */
         double learning_rate;
@@ -45,7 +120,7 @@ class SGD : public Optimizer {
         double momentum;
         
         /** @brief The velocity vector used for momentum */
-        std::vector<double> velocity;
+        std::vector<T> velocity;
         
     public:
         /**
@@ -54,22 +129,45 @@ class SGD : public Optimizer {
          * @param lr The learning rate.
          * @param mom The momentum coefficient.
          */
-        SGD(double lr, double mom = 0.0);
+        BasicSGD(double lr, double mom = 0.0);
         
         /**
-         * @brief Updates weights using SGD with momentum.
+         * @brief Sizes the velocity vector for a parameter block.
          * 
-         * @param weights The weights to update.
-         * @param gradients The gradients used for the update.
+         * @param size The total number of parameters in the block.
+         */
+        void begin_step(size_t size) override;
+
+        /**
+         * @brief Updates a slice of weights using SGD with momentum.
+         * 
+         * @param weights The slice of weights to update.
+         * @param gradients The gradients for the slice.
+         * @param offset Position of the slice within the block.
          */
-        void update(std::vector<double>& weights, const std::vector<double>& gradients) override;
+        void update_slice(Span<T> weights, Span<const T> gradients, size_t offset) override;
         
         /**
          * @brief Creates a deep copy of this optimizer.
          * 
          * @return A unique pointer to a new instance of this optimizer.
          */
-        std::unique_ptr<Optimizer> clone() const override;
+        std::unique_ptr<BasicOptimizer<T>> clone() const override;
+
+        /**
+         * @brief Exports the velocity.
+         * 
+         * @return A state with the velocity as its only buffer.
+         */
+        BasicOptimizerState<T> getState() const override;
+
+        /**
+         * @brief Replaces the velocity.
+         * 
+         * @param state A state with exactly one buffer, the velocity.
+         * @throws std::invalid_argument If the state does not have exactly one buffer.
+         */
+        void setState(const BasicOptimizerState<T>& state) override;
 };
 
 /**
@@ -77,8 +175,17 @@ class SGD : public Optimizer {
  * 
  * This optimizer implements the Adam algorithm, which maintains per-parameter
  * learning rates based on first and second moment estimates of the gradients.
+ * A nonzero weight decay turns it into AdamW: the weights shrink by
+ * learning_rate * weight_decay each step, independently of the gradient moments.
+ * 
+ * The bias corrections are computed once per step in begin_step(); each slice is
+ * then updated by the fused Simd::adam kernel in a single pass over the weights,
+ * gradients and both moment vectors.
+ * 
+ * @tparam T The scalar type.
  */
-class Adam : public Optimizer {
+template<typename T>
+class BasicAdam : public BasicOptimizer<T> {
     private:
         /** @brief The learning rate */
         double learning_rate;
@@ -93,13 +200,19 @@ class Adam : public Optimizer {
         double epsilon;
         
         /** @brief First moment vector */
-        std::vector<double> m;
+        std::vector<T> m;
         
         /** @brief Second moment vector */
-        std::vector<double> v;
+        std::vector<T> v;
         
+        /** @brief Decoupled weight decay coefficient; 0 for plain Adam */
+        double weight_decay;
+
         /** @brief Timestep counter */
         int t;
+
+        /** @brief Constants of the current step, computed by begin_step */
+        Simd::AdamCoefficients coefficients;
         
     public:
         /**
@@ -109,21 +222,54 @@ class Adam : public Optimizer {
          * @param b1 The beta1 coefficient for first moment estimates.
          * @param b2 The beta2 coefficient for second moment estimates.
          * @param eps The epsilon value for numerical stability.
+         * @param wd The decoupled weight decay coefficient (AdamW); 0 disables it.
          */
-        Adam(double lr = 0.001, double b1 = 0.9, double b2 = 0.999, double eps = 1e-8);
+        BasicAdam(double lr = 0.001, double b1 = 0.9, double b2 = 0.999, double eps = 1e-8, double wd = 0.0);
         
         /**
-         * @brief Updates weights using the Adam algorithm.
+         * @brief Sizes the moment vectors for a parameter block, advances the timestep and
+         *        computes the bias corrections for the step.
          * 
-         * @param weights The weights to update.
-         * @param gradients The gradients used for the update.
+         * @param size The total number of parameters in the block.
          */
-        void update(std::vector<double>& weights, const std::vector<double>& gradients) override;
+        void begin_step(size_t size) override;
+
+        /**
+         * @brief Updates a slice of weights using the Adam algorithm.
+         * 
+         * @param weights The slice of weights to update.
+         * @param gradients The gradients for the slice.
+         * @param offset Position of the slice within the block.
+         */
+        void update_slice(Span<T> weights, Span<const T> gradients, size_t offset) override;
         
         /**
          * @brief Creates a deep copy of this optimizer.
          * 
          * @return A unique pointer to a new instance of this optimizer.
          */
-        std::unique_ptr<Optimizer> clone() const override;
-};
\ No newline at end of file
+        std::unique_ptr<BasicOptimizer<T>> clone() const override;
+
+        /**
+         * @brief Exports the moment vectors and timestep.
+         * 
+         * @return A state with buffers {m, v} and step t.
+         */
+        BasicOptimizerState<T> getState() const override;
+
+        /**
+         * @brief Replaces the moment vectors and timestep.
+         * 
+         * @param state A state with buffers {m, v} of equal size and step t.
+         * @throws std::invalid_argument If the state does not have two equally sized buffers or the step is negative.
+         */
+        void setState(const BasicOptimizerState<T>& state) override;
+};
+
+using Optimizer = BasicOptimizer<double>;
+using SGD = BasicSGD<double>;
+using Adam = BasicAdam<double>;
+
+using OptimizerF = BasicOptimizer<float>;
+using SGDF = BasicSGD<float>;
+using AdamF = BasicAdam<float>;
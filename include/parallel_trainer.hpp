@@ -0,0 +1,106 @@
+#pragma once
+#include "neuralnet.hpp"
+#include "thread_pool.hpp"
+#include "matrix.hpp"
+#include <vector>
+
+/**
+ * @brief Data-parallel mini-batch training of a NeuralNet on a thread pool.
+ * 
+ * Each mini-batch is cut into a fixed number of row shards. Every shard is run
+ * through its own replica of the network (made from clones of the model's layers,
+ * so each replica has private activation caches), producing a flat gradient buffer
+ * for all layers. The buffers are summed with a pairwise tree reduction and the
+ * result is applied once to the model, so the model's optimizers see exactly one step
+ * per mini-batch: through its parameter arena, clipped as set by setGradientClipping,
+ * if setOptimizer was called, and through its layers otherwise. Replicas pick up the
+ * new parameters at the start of the next step.
+ * 
+ * The shard boundaries and the reduction order depend only on the shard count, so
+ * training is deterministic for a given number of shards regardless of scheduling.
+ * The loss is assumed to average over the rows of the batch, as MSELoss does.
+ */
+class ParallelTrainer {
+    private:
+        /** @brief The network being trained; its layers receive the updates */
+        NeuralNet& model;
+
+        /** @brief The pool the shards and the reduction run on */
+        ThreadPool& pool;
+
+        /** @brief One network replica per shard */
+        std::vector<NeuralNet> replicas;
+
+        /** @brief offsets[j] is where layer j starts in a gradient buffer; the last entry is the total */
+        std::vector<size_t> offsets;
+
+        /** @brief One flat gradient buffer per shard; the reduced sum ends up in gradients[0] */
+        std::vector<std::vector<double>> gradients;
+
+        /** @brief Per-shard copies of the batch rows, reused across steps */
+        std::vector<Matrix> shard_inputs;
+
+        /** @brief Per-shard copies of the target rows, reused across steps */
+        std::vector<Matrix> shard_targets;
+
+        /** @brief Loss summed over the rows of each shard for the current step */
+        std::vector<double> shard_losses;
+
+        /**
+         * @brief Syncs a replica with the model and computes its shard's gradients.
+         * 
+         * @param shard The shard index.
+         * @param inputs The full input batch.
+         * @param targets The full target batch.
+         */
+        void run_shard(size_t shard, const Matrix& inputs, const Matrix& targets);
+
+        /**
+         * @brief Sums all shard gradient buffers into gradients[0] with a pairwise tree.
+         */
+        void reduce_gradients();
+
+    public:
+        /**
+         * @brief Creates a trainer with one replica of the model per shard.
+         * 
+         * The model's layer structure must not change while the trainer is in use.
+         * 
+         * @param model The network to train; must have a loss function.
+         * @param pool The pool to run on.
+         * @param num_shards The number of shards per mini-batch; 0 uses one per pool worker.
+         * @throws std::invalid_argument If the model has no loss function.
+         */
+        ParallelTrainer(NeuralNet& model, ThreadPool& pool, size_t num_shards = 0);
+
+        /**
+         * @brief Gets the number of shards each mini-batch is split into.
+         * 
+         * @return The shard count.
+         */
+        size_t shard_count() const;
+
+        /**
+         * @brief Performs one training step on a mini-batch.
+         * 
+         * @param inputs The input batch, one sample per row.
+         * @param targets The target batch, one sample per row.
+         * @param learning_rate Learning rate when the model has no optimizer for the parameters.
+         * @return The loss of the batch before the update.
+         * @throws std::invalid_argument If inputs and targets have different row counts.
+         */
+        double train_batch(const Matrix& inputs, const Matrix& targets, double learning_rate);
+
+        /**
+         * @brief Trains the model on a dataset, one parallel step per mini-batch.
+         * 
+         * @param inputs Vector of input vectors for training.
+         * @param targets Vector of target (ground truth) vectors.
+         * @param epochs Number of training epochs.
+         * @param learning_rate Learning rate when the model has no optimizer for the parameters.
+         * @param batch_size Number of samples per update.
+         * @throws std::invalid_argument If batch_size is 0, inputs and targets differ in length or samples differ in size.
+         */
+        void train(const std::vector<std::vector<double>>& inputs, const std::vector<std::vector<double>>& targets,
+                   int epochs, double learning_rate, size_t batch_size);
+};
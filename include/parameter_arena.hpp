@@ -0,0 +1,115 @@
+#pragma once
+#include "layer.hpp"
+#include "matrix.hpp"
+#include "optimizer.hpp"
+#include "span.hpp"
+#include <vector>
+#include <memory>
+
+/**
+ * @brief One contiguous buffer for the parameters of a whole network, with a matching gradient buffer.
+ *
+ * Constructing an arena moves the parameters of every layer into a single aligned
+ * buffer (layer after layer, each in its compute_gradients layout) and binds the
+ * layers to views of it. A second buffer of the same shape receives the gradients,
+ * and a single optimizer owns the state for all of them, so one training step is a
+ * linear sweep over three or four arrays instead of two small optimizer calls per
+ * layer. Gradient clipping and checkpointing of the optimizer state work on the same
+ * flat buffers.
+ *
+ * The parameter buffer is shared with the layers, so it stays alive as long as any
+ * layer refers to it, even after the arena itself is gone.
+ *
+ * @tparam T The scalar type.
+ */
+template<typename T>
+class BasicParameterArena {
+    private:
+        /** @brief All parameters, shared with the layers that view them */
+        std::shared_ptr<std::vector<T, AlignedAllocator<T>>> parameters;
+
+        /** @brief All parameter gradients, in the same layout as parameters */
+        std::vector<T, AlignedAllocator<T>> gradients;
+
+        /** @brief Start of each layer's slice; one entry more than there are layers */
+        std::vector<size_t> offsets;
+
+        /** @brief Optimizer for the whole buffer, or null for plain gradient descent */
+        std::unique_ptr<BasicOptimizer<T>> optimizer;
+
+    public:
+        /**
+         * @brief Moves the parameters of the given layers into a new arena.
+         *
+         * The layers keep their current values and work on the arena from then on.
+         *
+         * @param layers The layers to bind, in network order.
+         * @param optimizer The optimizer for all parameters, or null for plain gradient descent.
+         */
+        BasicParameterArena(const std::vector<std::shared_ptr<BasicLayer<T>>>& layers,
+                            std::unique_ptr<BasicOptimizer<T>> optimizer);
+
+        /** @brief Deleted copy constructor */
+        BasicParameterArena(const BasicParameterArena&) = delete;
+
+        /** @brief Deleted copy assignment operator */
+        BasicParameterArena& operator=(const BasicParameterArena&) = delete;
+
+        /**
+         * @brief Gets the total number of parameters.
+         *
+         * @return The size of the parameter and gradient buffers.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Gets the parameter buffer.
+         *
+         * @return All parameters of all layers.
+         */
+        Span<T> getParameters();
+        Span<const T> getParameters() const;
+
+        /**
+         * @brief Gets the gradient buffer.
+         *
+         * @return All parameter gradients of all layers.
+         */
+        Span<T> getGradients();
+        Span<const T> getGradients() const;
+
+        /**
+         * @brief Gets the slice of the gradient buffer that belongs to one layer.
+         *
+         * @param layer Index of the layer in the order passed to the constructor.
+         * @return The layer's gradients (its parameter_count()).
+         * @throws std::out_of_range If layer is not a valid index.
+         */
+        Span<T> layerGradients(size_t layer);
+
+        /**
+         * @brief Gets the optimizer for the whole buffer.
+         *
+         * @return The optimizer, or nullptr for plain gradient descent.
+         */
+        BasicOptimizer<T>* getOptimizer() const;
+
+        /**
+         * @brief Scales the gradients down so their global L2 norm is at most max_norm.
+         *
+         * @param max_norm The largest allowed norm; must be positive.
+         * @return The norm of the gradients before clipping.
+         * @throws std::invalid_argument If max_norm is not positive.
+         */
+        double clip_gradients(double max_norm);
+
+        /**
+         * @brief Applies the gradients to the parameters in one sweep over the buffers.
+         *
+         * @param learning_rate Step size used when there is no optimizer.
+         */
+        void step(double learning_rate);
+};
+
+using ParameterArena = BasicParameterArena<double>;
+using ParameterArenaF = BasicParameterArena<float>;
@@ -0,0 +1,48 @@
+#pragma once
+#include "neuralnet.hpp"
+#include "quantized_dense.hpp"
+#include <vector>
+
+/**
+ * @brief Post-training int8 quantization of trained networks.
+ *
+ * Calibration runs a sample dataset through the network and records, for every
+ * layer, the largest input magnitude it sees. Quantization then replaces each Dense
+ * layer with a QuantizedDense whose input scale covers that range; other layers are
+ * copied unchanged. The sample should be representative of production inputs, since
+ * values beyond the calibrated range are clamped.
+ */
+namespace Quantization {
+    /**
+     * @brief Records the largest input magnitude seen by each layer.
+     *
+     * @param net The trained network.
+     * @param calibration_inputs Sample inputs, one per row.
+     * @return One range per layer, in layer order.
+     * @throws std::invalid_argument If a layer rejects the width produced by the previous one.
+     */
+    std::vector<double> calibrate(const NeuralNet& net, const Matrix& calibration_inputs);
+
+    /**
+     * @brief Single-precision overload of calibrate.
+     */
+    std::vector<double> calibrate(const NeuralNetF& net, const MatrixF& calibration_inputs);
+
+    /**
+     * @brief Builds an inference copy of a network with every Dense layer quantized to int8.
+     *
+     * The returned network shares nothing with net and keeps its loss function. It can
+     * be used with predict, predict_batch and InferencePlan but not trained.
+     *
+     * @param net The trained network.
+     * @param calibration_inputs Sample inputs, one per row, used to set the input scales.
+     * @return The quantized network.
+     * @throws std::invalid_argument If calibration_inputs is empty or a layer rejects its input width.
+     */
+    NeuralNet quantize(const NeuralNet& net, const Matrix& calibration_inputs);
+
+    /**
+     * @brief Single-precision overload of quantize.
+     */
+    NeuralNetF quantize(const NeuralNetF& net, const MatrixF& calibration_inputs);
+}
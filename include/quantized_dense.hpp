@@ -0,0 +1,226 @@
+#pragma once
+#include "layer.hpp"
+#include "dense.hpp"
+#include "matrix.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Inference-only fully-connected layer with int8 weights.
+ *
+ * Built from a trained Dense layer. Each weight row (output channel) is quantized
+ * symmetrically with its own scale, w ~ weight_scales[i] * q with q in [-127, 127].
+ * Inputs are quantized the same way with a single scale fixed at construction, so
+ * the range seen during calibration should cover the inputs seen in production;
+ * larger inputs are clamped. The product runs through the exact int8 kernels in
+ * Gemm and is rescaled once per output:
+ *
+ *     y_i = input_scale * weight_scales[i] * sum_j q_ij * qx_j + b_i
+ *
+ * The weights take one byte each, an eighth of a double Dense layer. The training
+ * methods throw; forward and forward_batch run the quantized inference path.
+ *
+ * @tparam T The scalar type of the activations, matching the network.
+ */
+template<typename T>
+class BasicQuantizedDense : public BasicLayer<T> {
+    private:
+        /** @brief Number of input features */
+        size_t num_inputs;
+
+        /** @brief Number of outputs */
+        size_t num_outputs;
+
+        /** @brief The quantized weights (output_size x input_size), row-major */
+        std::vector<std::int8_t, AlignedAllocator<std::int8_t>> weights;
+
+        /** @brief Dequantization scale of each weight row */
+        std::vector<T> weight_scales;
+
+        /** @brief input_scale * weight_scales[i], applied to each int32 dot product */
+        std::vector<T> output_scales;
+
+        /** @brief The bias vector (output_size), kept in full precision */
+        std::vector<T> biases;
+
+        /** @brief Quantization scale of the inputs */
+        T input_scale;
+
+        /**
+         * @brief Quantizes, multiplies and rescales rows of inputs.
+         *
+         * @param input The input rows.
+         * @param output Receives the output rows.
+         */
+        void run(BasicConstMatrixView<T> input, BasicMatrixView<T> output) const;
+
+    public:
+        /**
+         * @brief Quantizes the parameters of a Dense layer.
+         *
+         * @param dense The layer to quantize.
+         * @param input_range The largest input magnitude to represent exactly; larger inputs are clamped.
+         * @throws std::invalid_argument If input_range is negative or not finite.
+         */
+        BasicQuantizedDense(const BasicDense<T>& dense, T input_range);
+
+        /**
+         * @brief Gets the quantized weights.
+         *
+         * @return The int8 weights (output_size x input_size), row-major.
+         */
+        const std::vector<std::int8_t, AlignedAllocator<std::int8_t>>& getWeights() const;
+
+        /**
+         * @brief Gets the dequantization scale of each weight row.
+         *
+         * @return The weight scales (output_size).
+         */
+        const std::vector<T>& getWeightScales() const;
+
+        /**
+         * @brief Gets the quantization scale of the inputs.
+         *
+         * @return The input scale.
+         */
+        T getInputScale() const;
+
+        /**
+         * @brief Gets the bias vector.
+         *
+         * @return The bias vector (output_size).
+         */
+        const std::vector<T>& getBiases() const;
+
+        /**
+         * @brief Runs the quantized forward pass; nothing is cached.
+         *
+         * @param input The input vector.
+         * @return The output vector.
+         */
+        std::vector<T> forward(const std::vector<T>& input) override;
+
+        /**
+         * @brief Not supported; quantized layers cannot be trained.
+         *
+         * @throws std::runtime_error Always.
+         */
+        std::vector<T> backward(const std::vector<T>& grad_output, double learning_rate) override;
+
+        /**
+         * @brief Runs the quantized forward pass for a mini-batch; nothing is cached.
+         *
+         * @param input The input batch (batch_size x input_size).
+         * @return The output batch (batch_size x output_size).
+         */
+        BasicMatrix<T> forward_batch(const BasicMatrix<T>& input) override;
+
+        /**
+         * @brief Not supported; quantized layers cannot be trained.
+         *
+         * @throws std::runtime_error Always.
+         */
+        BasicMatrix<T> backward_batch(const BasicMatrix<T>& grad_output, double learning_rate) override;
+
+        /**
+         * @brief Runs the quantized forward pass; the parameters are never written.
+         *
+         * @param input The input vector.
+         * @param output Receives the output vector.
+         */
+        void forward_hogwild(Span<const T> input, Span<T> output) const override;
+
+        /**
+         * @brief Not supported; quantized layers cannot be trained.
+         *
+         * @throws std::runtime_error Always.
+         */
+        void backward_hogwild(Span<const T> input, Span<const T> grad_output, Span<T> grad_input,
+                              double learning_rate) override;
+
+        /**
+         * @brief Gets the number of trainable parameters, which is zero.
+         *
+         * @return 0.
+         */
+        size_t parameter_count() const override;
+
+        /**
+         * @brief Not supported; quantized layers cannot be trained.
+         *
+         * @throws std::runtime_error Always.
+         */
+        BasicMatrix<T> compute_gradients(const BasicMatrix<T>& grad_output, Span<T> parameter_gradients) override;
+
+        /**
+         * @brief Not supported; quantized layers cannot be trained.
+         *
+         * @throws std::runtime_error Always.
+         */
+        BasicMatrix<T> accumulate_gradients(const BasicMatrix<T>& grad_output, Span<T> parameter_gradients) override;
+
+        /**
+         * @brief Does nothing, as there are no trainable parameters.
+         *
+         * @param parameter_gradients Unused.
+         * @param learning_rate Unused.
+         */
+        void apply_gradients(Span<const T> parameter_gradients, double learning_rate) override;
+
+        /**
+         * @brief Copies the quantized parameters of another QuantizedDense layer of the same shape.
+         *
+         * @param source The layer to copy from.
+         * @throws std::invalid_argument If source is not a QuantizedDense layer of the same shape.
+         */
+        void copy_parameters_from(const BasicLayer<T>& source) override;
+
+        /**
+         * @brief Does nothing, as there are no trainable parameters.
+         * 
+         * @param storage Must be empty.
+         * @param owner Unused.
+         * @throws std::invalid_argument If storage is not empty.
+         */
+        void bind_parameters(Span<T> storage, std::shared_ptr<void> owner) override;
+
+        /**
+         * @brief Gets the output size of this layer.
+         *
+         * @param input_size The number of input features.
+         * @return The number of output features.
+         * @throws std::invalid_argument If input_size does not match the layer input size.
+         */
+        size_t output_size(size_t input_size) const override;
+
+        /**
+         * @brief Runs the quantized forward pass for one sample.
+         *
+         * @param input The input vector (input_size).
+         * @param output Receives the output vector (output_size).
+         */
+        void infer(Span<const T> input, Span<T> output) const override;
+
+        /**
+         * @brief Runs the quantized forward pass for a mini-batch.
+         *
+         * Quantized inputs and int32 products go through per-thread scratch, so
+         * concurrent calls are safe and repeated calls do not allocate once warmed up.
+         *
+         * @param input The input batch (batch_size x input_size).
+         * @param output Receives the output batch (batch_size x output_size).
+         * @throws std::invalid_argument If the shapes do not match the layer.
+         */
+        void infer_batch(BasicConstMatrixView<T> input, BasicMatrixView<T> output) const override;
+
+        /**
+         * @brief Creates a copy of this layer.
+         *
+         * @return A unique pointer to a new instance of this layer.
+         */
+        std::unique_ptr<BasicLayer<T>> clone() const override;
+};
+
+using QuantizedDense = BasicQuantizedDense<double>;
+using QuantizedDenseF = BasicQuantizedDense<float>;
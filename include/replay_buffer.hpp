@@ -1,5 +1,7 @@
 #pragma once
 
+#include "matrix.hpp"
+#include "span.hpp"
 #include <vector>
 #include <random>
 
@@ -26,45 +28,176 @@ struct Experience {
     bool done;
 };
 
+/**
+ * @brief How ReplayBuffer::sample picks transitions.
+ */
+enum class SamplingMode {
+    /** @brief Distinct transitions from one selection pass over the whole buffer; O(size), in slot order */
+    Scan,
+
+    /** @brief Independent uniform draws, so a batch may repeat a transition; O(batch_size) */
+    WithReplacement,
+
+    /** @brief Distinct transitions by Floyd's algorithm; O(batch_size) expected */
+    WithoutReplacement
+};
+
+/**
+ * @brief A batch of sampled transitions, one transition per row or element.
+ * 
+ * Filled by ReplayBuffer::sample. The members are resized to the batch on every
+ * call, so a batch object reused across calls of the same size does not allocate.
+ */
+struct ReplayBatch {
+    /** @brief The states (batch_size x state_size) */
+    Matrix states;
+
+    /** @brief The actions taken */
+    std::vector<int> actions;
+
+    /** @brief The rewards received */
+    std::vector<double> rewards;
+
+    /** @brief The next states (batch_size x state_size) */
+    Matrix next_states;
+
+    /** @brief 1 if the episode ended after the transition, 0 otherwise */
+    std::vector<unsigned char> dones;
+
+    /** @brief Slot of each transition in the buffer */
+    std::vector<size_t> indices;
+
+    /** @brief Importance-sampling weight of each transition; left empty by uniform sampling */
+    std::vector<double> weights;
+
+    /** @brief Factor for the bootstrap value of each next state, 0 after a done; left empty by one-step sampling */
+    std::vector<double> discounts;
+};
+
 /**
  * @brief A circular buffer for storing experiences for experience replay.
  * 
  * This class implements a replay buffer that stores experiences and allows
  * random sampling from them for training reinforcement learning agents.
+ * 
+ * Transitions are kept as a structure of arrays: states and next states are rows
+ * of two capacity x state_size matrices, and actions, rewards and done flags are
+ * parallel columns, all allocated once. Pushing copies into the next slot without
+ * allocating, and sample() gathers rows straight into a caller-provided batch.
+ * Every transition must have the same state size, fixed at construction or by the
+ * first push.
+ * 
+ * Sampling costs O(batch_size) by default, independent of how full the buffer is;
+ * see SamplingMode for the alternatives.
  */
 class ReplayBuffer {
     public:
         /**
          * @brief Constructs a replay buffer with the specified capacity.
          * 
+         * The columns are allocated on the first push, which also fixes the state size.
+         * 
          * @param capacity The maximum number of experiences the buffer can hold.
+         * @throws std::invalid_argument If capacity is 0.
          */
         explicit ReplayBuffer(size_t capacity);
-        
+
+        /**
+         * @brief Constructs a replay buffer and preallocates its columns.
+         * 
+         * @param capacity The maximum number of experiences the buffer can hold.
+         * @param state_size The length of every state and next state.
+         * @throws std::invalid_argument If capacity or state_size is 0.
+         */
+        ReplayBuffer(size_t capacity, size_t state_size);
+
         /**
          * @brief Adds an experience to the buffer.
          * 
          * If the buffer is full, the oldest experience will be overwritten.
          * 
          * @param experience The experience to add to the buffer.
+         * @return The slot the experience was written to.
+         * @throws std::invalid_argument If the states do not have the buffer's state size.
          */
-        void push(const Experience& experience);
-        
+        size_t push(const Experience& experience);
+
+        /**
+         * @brief Adds a transition to the buffer without building an Experience.
+         * 
+         * @param state The state before the action (state size).
+         * @param action The action taken.
+         * @param reward The reward received.
+         * @param next_state The state after the action (state size).
+         * @param done Whether the episode ended after the transition.
+         * @return The slot the transition was written to.
+         * @throws std::invalid_argument If the states do not have the buffer's state size.
+         */
+        size_t push(Span<const double> state, int action, double reward, Span<const double> next_state, bool done);
+
         /**
          * @brief Samples a batch of experiences randomly from the buffer.
          * 
+         * Builds a separate Experience for each sample; prefer the ReplayBatch overload
+         * in training loops.
+         * 
          * @param batch_size The number of experiences to sample.
          * @return A vector of sampled experiences.
+         * @throws std::runtime_error If the buffer holds fewer than batch_size experiences.
          */
         std::vector<Experience> sample(size_t batch_size);
-        
+
+        /**
+         * @brief Samples transitions uniformly at random into a batch.
+         * 
+         * Each state is copied with one memcpy per row into batch.states and
+         * batch.next_states; nothing is allocated once the batch has been sized.
+         * 
+         * @param batch_size The number of transitions to sample.
+         * @param batch Receives the transitions; resized to batch_size.
+         * @throws std::runtime_error If the buffer holds fewer than batch_size experiences.
+         */
+        void sample(size_t batch_size, ReplayBatch& batch);
+
+        /**
+         * @brief Copies the transitions in the given slots into a batch.
+         * 
+         * Lets other samplers choose the slots and reuse the buffer's storage.
+         * 
+         * @param indices The slots to copy; each must be below size(). May be batch.indices.
+         * @param batch Receives the transitions; resized to indices.size().
+         * @throws std::out_of_range If a slot is not in use.
+         */
+        void gather(Span<const size_t> indices, ReplayBatch& batch) const;
+
+        /**
+         * @brief Selects how sample picks transitions.
+         * 
+         * @param mode The sampling mode; WithoutReplacement by default.
+         */
+        void setSampling(SamplingMode mode);
+
+        /**
+         * @brief Gets the sampling mode.
+         * 
+         * @return The mode used by sample.
+         */
+        SamplingMode getSampling() const;
+
         /**
          * @brief Gets the current number of experiences in the buffer.
          * 
          * @return The number of experiences currently stored.
          */
         size_t size() const;
-        
+
+        /**
+         * @brief Gets the length of the stored states.
+         * 
+         * @return The state size, or 0 if it has not been fixed yet.
+         */
+        size_t getStateSize() const;
+
         /**
          * @brief Checks if the buffer has enough experiences for sampling.
          * 
@@ -74,18 +207,57 @@ class ReplayBuffer {
         bool is_ready(size_t batch_size) const;
 
     private:
-        /** @brief The storage for experiences */
-        std::vector<Experience> memory;
-        
+        /** @brief The states, one row per slot */
+        Matrix states;
+
+        /** @brief The next states, one row per slot */
+        Matrix next_states;
+
+        /** @brief The action of each slot */
+        std::vector<int> actions;
+
+        /** @brief The reward of each slot */
+        std::vector<double> rewards;
+
+        /** @brief The done flag of each slot */
+        std::vector<unsigned char> dones;
+
         /** @brief The maximum capacity of the buffer */
         size_t capacity;
-        
+
+        /** @brief The length of every state, or 0 until the first push */
+        size_t state_size;
+
         /** @brief The current position in the buffer for adding new experiences */
         size_t position;
-        
+
         /** @brief The current number of experiences in the buffer */
         size_t current_size;
-        
+
+        /** @brief Scratch for the slots drawn by the Experience overload of sample */
+        std::vector<size_t> sampled;
+
+        /** @brief How sample picks transitions */
+        SamplingMode sampling;
+
+        /** @brief Open-addressing set of the slots already drawn without replacement */
+        std::vector<size_t> drawn;
+
         /** @brief Random number generator for sampling */
         std::mt19937 gen;
+
+        /**
+         * @brief Allocates the columns for a given state size.
+         * 
+         * @param size The state size.
+         */
+        void allocate(size_t size);
+
+        /**
+         * @brief Picks batch_size slots uniformly at random as selected by the sampling mode.
+         * 
+         * @param batch_size The number of slots.
+         * @param indices Receives the slots.
+         */
+        void draw_indices(size_t batch_size, std::vector<size_t>& indices);
 };
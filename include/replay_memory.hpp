@@ -1,17 +1,195 @@
 #pragma once
 
+#include "replay_buffer.hpp"
+#include "span.hpp"
 #include <vector>
 #include <random>
-#include <deque>
 
 /**
- * @brief A memory structure for storing and replaying past experiences.
- * 
- * This class provides a more flexible implementation of replay memory
- * compared to ReplayBuffer, using a deque instead of a fixed-size array.
- * It is particularly useful for algorithms that require more complex 
- * sampling strategies.
+ * @brief Array-backed binary tree of priorities with sum and minimum queries.
+ *
+ * The leaves hold one priority per slot and every inner node the sum (and, in a
+ * second array, the minimum) of its children, laid out heap-style so node i has
+ * children 2i and 2i + 1. Updates and prefix-sum searches walk one root-to-leaf
+ * path, so both are O(log N), and the whole tree is two flat arrays allocated at
+ * construction, independent of how many priorities change.
+ */
+class PriorityTree {
+    private:
+        /** @brief Number of leaves, the capacity rounded up to a power of two */
+        size_t leaves;
+
+        /** @brief Subtree sums; node 1 is the root and leaf i is node leaves + i */
+        std::vector<double> sums;
+
+        /** @brief Subtree minimums over the slots in use; unused leaves hold infinity */
+        std::vector<double> minimums;
+
+    public:
+        /**
+         * @brief Constructs a tree with every priority unset.
+         *
+         * @param capacity The number of slots.
+         * @throws std::invalid_argument If capacity is 0.
+         */
+        explicit PriorityTree(size_t capacity);
+
+        /**
+         * @brief Sets the priority of a slot.
+         *
+         * @param index The slot.
+         * @param priority The new priority; must be positive and finite.
+         * @throws std::out_of_range If index is not a slot of the tree.
+         * @throws std::invalid_argument If priority is not positive and finite.
+         */
+        void set(size_t index, double priority);
+
+        /**
+         * @brief Gets the priority of a slot.
+         *
+         * @param index The slot.
+         * @return The priority, or 0 if it has never been set.
+         */
+        double get(size_t index) const;
+
+        /**
+         * @brief Gets the sum of all priorities.
+         *
+         * @return The total priority.
+         */
+        double total() const;
+
+        /**
+         * @brief Gets the smallest priority that has been set.
+         *
+         * @return The minimum, or infinity if no priority has been set.
+         */
+        double min() const;
+
+        /**
+         * @brief Finds the slot whose cumulative priority range contains mass.
+         *
+         * Slot i covers [sum of priorities before i, that sum + priority of i), so
+         * drawing mass uniformly from [0, total()) picks slots in proportion to their
+         * priority. Slots without a priority are never returned.
+         *
+         * @param mass A value in [0, total()); values outside are clamped.
+         * @return The slot.
+         * @throws std::runtime_error If no priority has been set.
+         */
+        size_t find(double mass) const;
+};
+
+/**
+ * @brief Prioritized experience replay memory.
+ *
+ * Transitions are stored in the columns of a ReplayBuffer and sampled in proportion
+ * to priority^alpha (proportional prioritization), using a PriorityTree for O(log N)
+ * sampling and priority updates. Each batch is stratified: the total priority is cut
+ * into batch_size equal segments and one transition is drawn from each, so a batch
+ * may contain a transition more than once. New transitions get the largest priority
+ * seen so far, so every transition is replayed at least once with high probability.
+ *
+ * Sampled batches carry importance-sampling weights (N * P(i))^-beta, normalized by
+ * their largest possible value so they are at most 1, to correct the bias of
+ * non-uniform sampling. After training on a batch, pass the new TD errors of its
+ * transitions to update_priorities.
  */
 class ReplayMemory {
-    // Note: This file appears to be a placeholder for future implementation
-};
\ No newline at end of file
+    private:
+        /** @brief The transitions */
+        ReplayBuffer storage;
+
+        /** @brief The priority^alpha of every stored transition */
+        PriorityTree priorities;
+
+        /** @brief How strongly priorities skew sampling; 0 is uniform */
+        double alpha;
+
+        /** @brief Added to every priority so that no transition becomes unreachable */
+        double epsilon;
+
+        /** @brief Largest priority^alpha seen so far, given to new transitions */
+        double max_priority;
+
+        /** @brief Random number generator for sampling */
+        std::mt19937 gen;
+
+    public:
+        /**
+         * @brief Constructs an empty prioritized replay memory.
+         *
+         * All storage, including the priority tree, is allocated here.
+         *
+         * @param capacity The maximum number of transitions; the oldest are overwritten.
+         * @param state_size The length of every state and next state.
+         * @param alpha The prioritization exponent, from 0 (uniform) to 1 (fully proportional).
+         * @param epsilon Small constant added to every priority before exponentiation.
+         * @throws std::invalid_argument If capacity or state_size is 0, alpha is negative or epsilon is not positive.
+         */
+        ReplayMemory(size_t capacity, size_t state_size, double alpha = 0.6, double epsilon = 1e-6);
+
+        /**
+         * @brief Adds an experience with the largest priority seen so far.
+         *
+         * @param experience The experience to add.
+         * @throws std::invalid_argument If the states do not have the memory's state size.
+         */
+        void push(const Experience& experience);
+
+        /**
+         * @brief Adds a transition with the largest priority seen so far.
+         *
+         * @param state The state before the action (state size).
+         * @param action The action taken.
+         * @param reward The reward received.
+         * @param next_state The state after the action (state size).
+         * @param done Whether the episode ended after the transition.
+         * @throws std::invalid_argument If the states do not have the memory's state size.
+         */
+        void push(Span<const double> state, int action, double reward, Span<const double> next_state, bool done);
+
+        /**
+         * @brief Samples a stratified batch in proportion to priority and computes its weights.
+         *
+         * @param batch_size The number of transitions to sample.
+         * @param beta The importance-sampling exponent, usually annealed from about 0.4 to 1.
+         * @param batch Receives the transitions, their slots in indices and their weights.
+         * @throws std::runtime_error If the memory holds fewer than batch_size transitions.
+         * @throws std::invalid_argument If beta is negative.
+         */
+        void sample(size_t batch_size, double beta, ReplayBatch& batch);
+
+        /**
+         * @brief Replaces the priorities of sampled transitions.
+         *
+         * @param indices The slots, as returned in ReplayBatch::indices.
+         * @param errors The new priorities, usually the absolute TD errors; one per slot.
+         * @throws std::invalid_argument If the spans differ in length or an error is negative or not finite.
+         * @throws std::out_of_range If a slot is not in use.
+         */
+        void update_priorities(Span<const size_t> indices, Span<const double> errors);
+
+        /**
+         * @brief Gets the priority^alpha of a stored transition.
+         *
+         * @param index The slot.
+         * @return The sampling weight of the slot before normalization.
+         */
+        double getPriority(size_t index) const;
+
+        /**
+         * @brief Gets the current number of transitions.
+         *
+         * @return The number of transitions stored.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Checks if the memory has enough transitions for sampling.
+         *
+         * @param batch_size The batch size to check against.
+         * @return True if at least batch_size transitions are stored.
+         */
+        bool is_ready(size_t batch_size) const;
+};
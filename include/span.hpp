@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Non-owning view over a contiguous range of elements.
+ *
+ * A minimal stand-in for C++20 std::span. It converts implicitly from std::vector
+ * (with any allocator), so functions taking a Span can be called with vectors,
+ * raw buffers or slices of Matrix storage without copying.
+ *
+ * @tparam T The element type; use a const type for read-only views.
+ */
+template<typename T>
+class Span {
+    private:
+        /** @brief Pointer to the first element */
+        T* ptr;
+
+        /** @brief Number of elements in the view */
+        std::size_t len;
+
+    public:
+        using element_type = T;
+        using value_type = std::remove_const_t<T>;
+
+        Span() : ptr(nullptr), len(0) {}
+
+        Span(T* data, std::size_t size) : ptr(data), len(size) {}
+
+        template<typename Alloc>
+        Span(std::vector<value_type, Alloc>& v) : ptr(v.data()), len(v.size()) {}
+
+        template<typename Alloc, typename U = T, typename = std::enable_if_t<std::is_const<U>::value>>
+        Span(const std::vector<value_type, Alloc>& v) : ptr(v.data()), len(v.size()) {}
+
+        template<typename U, typename = std::enable_if_t<std::is_const<T>::value && std::is_same<U, value_type>::value>>
+        Span(const Span<U>& other) : ptr(other.data()), len(other.size()) {}
+
+        T* data() const { return ptr; }
+        std::size_t size() const { return len; }
+        bool empty() const { return len == 0; }
+
+        T& operator[](std::size_t i) const { return ptr[i]; }
+
+        T* begin() const { return ptr; }
+        T* end() const { return ptr + len; }
+
+        /**
+         * @brief Returns a view over count elements starting at offset.
+         */
+        Span subspan(std::size_t offset, std::size_t count) const { return Span(ptr + offset, count); }
+};
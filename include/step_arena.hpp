@@ -0,0 +1,159 @@
+#pragma once
+#include "matrix.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Bump allocator for the temporaries of one training step.
+ *
+ * Memory is handed out from large 64-byte aligned blocks by advancing an offset, and
+ * reset() makes all of it available again in O(1) without freeing anything. Blocks
+ * are kept across resets, so once the arena has grown to the size of one step, later
+ * steps run without touching the heap. A request that does not fit the remaining
+ * blocks adds a new one, which shows up in getBlockAllocations() and in
+ * Memory::allocation_count().
+ *
+ * A Scope makes an arena the active one on the calling thread; while it is open,
+ * scratch_matrix() places matrices in the arena instead of on the heap. Layers and
+ * losses use scratch_matrix() for the matrices they return from the batched training
+ * calls, so NeuralNet::train can run a whole step out of one arena. Matrices taken
+ * from an arena must not be used after the next reset().
+ *
+ * Not thread-safe; each thread needs its own arena.
+ */
+class StepArena {
+    private:
+        /** @brief A block of arena memory */
+        using Block = std::vector<unsigned char, AlignedAllocator<unsigned char>>;
+
+        /** @brief The blocks, filled in order */
+        std::vector<Block> blocks;
+
+        /** @brief Index of the block currently being filled */
+        std::size_t current;
+
+        /** @brief Bytes used in the current block */
+        std::size_t offset;
+
+        /** @brief Size of a newly added block, unless a single request needs more */
+        std::size_t block_size;
+
+        /** @brief Number of blocks allocated from the heap so far */
+        std::size_t block_allocations;
+
+    public:
+        /**
+         * @brief Makes an arena the active one on this thread for the lifetime of the scope.
+         *
+         * Scopes nest; the previously active arena is restored on destruction.
+         */
+        class Scope {
+            private:
+                /** @brief The arena that was active before this scope */
+                StepArena* previous;
+
+            public:
+                /**
+                 * @brief Activates arena on the calling thread.
+                 *
+                 * @param arena The arena to activate; must outlive the scope.
+                 */
+                explicit Scope(StepArena& arena);
+
+                /** @brief Deleted copy constructor */
+                Scope(const Scope&) = delete;
+
+                /** @brief Deleted copy assignment operator */
+                Scope& operator=(const Scope&) = delete;
+
+                /**
+                 * @brief Restores the previously active arena.
+                 */
+                ~Scope();
+        };
+
+        /**
+         * @brief Constructs an empty arena; no memory is allocated until the first request.
+         *
+         * @param block_size Size of each block in bytes.
+         */
+        explicit StepArena(std::size_t block_size = 1 << 20);
+
+        /** @brief Deleted copy constructor */
+        StepArena(const StepArena&) = delete;
+
+        /** @brief Deleted copy assignment operator */
+        StepArena& operator=(const StepArena&) = delete;
+
+        /**
+         * @brief Allocates memory that stays valid until the next reset().
+         *
+         * @param bytes The number of bytes.
+         * @return A pointer aligned to 64 bytes.
+         */
+        void* allocate(std::size_t bytes);
+
+        /**
+         * @brief Allocates uninitialized storage for count elements of type T.
+         *
+         * @param count The number of elements.
+         * @return A pointer aligned to 64 bytes.
+         */
+        template<typename T>
+        T* allocate(std::size_t count) {
+            return static_cast<T*>(allocate(count * sizeof(T)));
+        }
+
+        /**
+         * @brief Releases everything allocated since the last reset, keeping the blocks.
+         */
+        void reset();
+
+        /**
+         * @brief Gets the number of bytes handed out since the last reset.
+         *
+         * @return The bytes in use, including alignment padding.
+         */
+        std::size_t used() const;
+
+        /**
+         * @brief Gets the total size of the blocks owned by the arena.
+         *
+         * @return The capacity in bytes.
+         */
+        std::size_t capacity() const;
+
+        /**
+         * @brief Gets the number of blocks the arena has allocated from the heap.
+         *
+         * @return The count; constant once the arena has warmed up to its steady-state size.
+         */
+        std::size_t getBlockAllocations() const;
+
+        /**
+         * @brief Gets the arena made active on this thread by the innermost open Scope.
+         *
+         * @return The active arena, or nullptr if there is none.
+         */
+        static StepArena* active();
+};
+
+/**
+ * @brief Creates an uninitialized matrix in the active step arena, or on the heap if there is none.
+ *
+ * The caller must write every element before reading it.
+ *
+ * @tparam T The scalar type.
+ * @param rows The number of rows.
+ * @param cols The number of columns.
+ * @return A matrix borrowing arena memory, or an owned zero-filled matrix.
+ */
+template<typename T>
+BasicMatrix<T> scratch_matrix(std::size_t rows, std::size_t cols) {
+    StepArena* arena = StepArena::active();
+    if (arena == nullptr) {
+        return BasicMatrix<T>(rows, cols);
+    }
+
+    return BasicMatrix<T>(arena->allocate<T>(rows * cols), rows, cols, nullptr);
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed-size pool of worker threads with per-worker task deques and work stealing.
+ * 
+ * Each worker owns a deque. Tasks submitted from a worker go to the back of its own
+ * deque and are taken back in LIFO order, which keeps recently produced data in that
+ * core's cache; tasks submitted from outside are spread round-robin across the
+ * deques. An idle worker steals from the front of the other deques before going to
+ * sleep, so uneven tasks are rebalanced without a central queue.
+ * 
+ * Threads that wait on the pool (parallel_for, wait) run queued tasks while they wait,
+ * so the pool can be used from inside its own tasks without deadlocking.
+ */
+class ThreadPool {
+    private:
+        /** @brief A worker's task deque and the lock that guards it */
+        struct TaskQueue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        /** @brief One deque per worker */
+        std::vector<std::unique_ptr<TaskQueue>> queues;
+
+        /** @brief The worker threads */
+        std::vector<std::thread> workers;
+
+        /** @brief Guards sleeping and waking of workers and waiters */
+        std::mutex state_mutex;
+
+        /** @brief Signalled when a task is queued or the pool shuts down */
+        std::condition_variable task_available;
+
+        /** @brief Signalled when the last unfinished task completes */
+        std::condition_variable all_done;
+
+        /** @brief Tasks sitting in a deque */
+        std::atomic<size_t> queued{0};
+
+        /** @brief Tasks submitted but not yet completed */
+        std::atomic<size_t> unfinished{0};
+
+        /** @brief Round-robin cursor for tasks submitted from outside the pool */
+        std::atomic<size_t> next_queue{0};
+
+        /** @brief Set when the destructor asks the workers to exit */
+        bool stopping = false;
+
+        /**
+         * @brief Takes a task, preferring the back of the caller's own deque and stealing from the front of others.
+         * 
+         * @param task Receives the task.
+         * @return True if a task was taken.
+         */
+        bool try_take(std::function<void()>& task);
+
+        /**
+         * @brief Runs a task taken from the pool and updates the completion count.
+         * 
+         * @param task The task to run.
+         */
+        void run_task(std::function<void()>& task);
+
+        /**
+         * @brief Main loop of worker thread index.
+         * 
+         * @param index The worker index.
+         */
+        void worker_loop(size_t index);
+
+    public:
+        /**
+         * @brief Starts the worker threads.
+         * 
+         * @param num_threads The number of workers; 0 uses std::thread::hardware_concurrency().
+         */
+        explicit ThreadPool(size_t num_threads = 0);
+
+        /** @brief Deleted copy constructor */
+        ThreadPool(const ThreadPool&) = delete;
+
+        /** @brief Deleted copy assignment operator */
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Finishes all queued tasks and joins the workers.
+         */
+        ~ThreadPool();
+
+        /**
+         * @brief Gets the number of worker threads.
+         * 
+         * @return The number of workers.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Queues a task for execution on a worker.
+         * 
+         * @param task The task to run; it must not throw.
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * @brief Blocks until every submitted task has completed, running queued tasks meanwhile.
+         * 
+         * Must not be called from inside a task of this pool, since that task would wait
+         * for itself; use parallel_for for nested work.
+         */
+        void wait();
+
+        /**
+         * @brief Runs body over [begin, end) split into chunks of at most grain indices.
+         * 
+         * Chunks run concurrently on the workers and the calling thread. Returns once
+         * all chunks have finished; if any chunk throws, the first exception is
+         * rethrown here after the remaining chunks complete.
+         * 
+         * @param begin The first index.
+         * @param end One past the last index.
+         * @param grain The maximum chunk length; 0 is treated as 1.
+         * @param body Called as body(chunk_begin, chunk_end).
+         */
+        void parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body);
+};
@@ -73,6 +73,36 @@ namespace Utils {
      */
     double tanh_derivative(double x);
 
+    /**
+     * @brief Computes the Gaussian Error Linear Unit (GELU) activation function.
+     * 
+     * Uses the exact form x * Phi(x), where Phi is the standard normal CDF.
+     * @param x The input value.
+     * @return The result of the GELU function.
+     */
+    double gelu(double x);
+
+    /**
+     * @brief Computes the derivative of the GELU function.
+     * @param x The input value.
+     * @return The derivative of the GELU function.
+     */
+    double gelu_derivative(double x);
+
+    /**
+     * @brief Computes the Sigmoid Linear Unit (SiLU, also called swish) activation function.
+     * @param x The input value.
+     * @return The result of the SiLU function, x * sigmoid(x).
+     */
+    double silu(double x);
+
+    /**
+     * @brief Computes the derivative of the SiLU function.
+     * @param x The input value.
+     * @return The derivative of the SiLU function.
+     */
+    double silu_derivative(double x);
+
     /**
      * @brief Computes the softmax function for a vector of values.
      * @param input The vector of values to be transformed.
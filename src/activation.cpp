@@ -1,27 +1,279 @@
 #include "activation.hpp"
+#include "utils.hpp"
+#include "simd.hpp"
+#include "step_arena.hpp"
+#include <stdexcept>
 
-Activation::Activation(std::function<double(double)> act, std::function<double(double)> act_deriv)
-    : activation(act), activation_derivative(act_deriv) {}
+namespace {
+    // Element-wise kernels. Each provides the function and its derivative as inline,
+    // branch-free expressions so the loops below can be inlined and vectorized.
+    // Sigmoid, tanh, SiLU and softmax are built on the Simd transcendental kernels instead.
+    // GELU has no vector kernel and is evaluated through the double Utils functions.
+    template<typename T>
+    struct ReLUKernel {
+        T f(T x) const { return x > T(0) ? x : T(0); }
+        T df(T x) const { return x > T(0) ? T(1) : T(0); }
+    };
 
-std::vector<double> Activation::forward(const std::vector<double>& input) {
-    input_cache = input;
-    std::vector<double> output(input.size());
-    for (size_t i = 0; i < input.size(); ++i) {
-        output[i] = activation(input[i]);
+    template<typename T>
+    struct LeakyReLUKernel {
+        T alpha;
+        T f(T x) const { return x > T(0) ? x : alpha * x; }
+        T df(T x) const { return x > T(0) ? T(1) : alpha; }
+    };
+
+    template<typename T>
+    struct GELUKernel {
+        T f(T x) const { return static_cast<T>(Utils::gelu(x)); }
+        T df(T x) const { return static_cast<T>(Utils::gelu_derivative(x)); }
+    };
+
+    template<typename Kernel, typename T>
+    void forward_kernel(const Kernel& k, const T* __restrict x, T* __restrict y, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            y[i] = k.f(x[i]);
+        }
+    }
+
+    template<typename Kernel, typename T>
+    void backward_kernel(const Kernel& k, const T* __restrict x, const T* __restrict g,
+                         T* __restrict gin, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            gin[i] = k.df(x[i]) * g[i];
+        }
+    }
+
+    // Softmax Jacobian-vector product for one row: gin = s * (g - dot(g, s)).
+    template<typename T>
+    void softmax_backward(const T* x, const T* g, T* gin, size_t n) {
+        Simd::softmax(x, gin, n);
+        T dot = T(0);
+        for (size_t i = 0; i < n; ++i) {
+            dot += g[i] * gin[i];
+        }
+        for (size_t i = 0; i < n; ++i) {
+            gin[i] *= g[i] - dot;
+        }
+    }
+
+    // Maps plain function pointers to the Utils activations onto the built-in kernels.
+    // The Utils functions take double, so this also recognizes them wrapped in std::function<float(float)>.
+    template<typename T>
+    ActivationType detect_type(const std::function<T(T)>& act, const std::function<T(T)>& act_deriv) {
+        using Fn = double (*)(double);
+        const Fn* f = act.template target<Fn>();
+        const Fn* df = act_deriv.template target<Fn>();
+        if (f == nullptr || df == nullptr) {
+            return ActivationType::Custom;
+        }
+        if (*f == &Utils::sigmoid && *df == &Utils::sigmoid_derivative) return ActivationType::Sigmoid;
+        if (*f == &Utils::relu && *df == &Utils::relu_derivative) return ActivationType::ReLU;
+        if (*f == &Utils::tanh && *df == &Utils::tanh_derivative) return ActivationType::Tanh;
+        if (*f == &Utils::gelu && *df == &Utils::gelu_derivative) return ActivationType::GELU;
+        if (*f == &Utils::silu && *df == &Utils::silu_derivative) return ActivationType::SiLU;
+        return ActivationType::Custom;
+    }
+}
+
+template<typename T>
+BasicActivation<T>::BasicActivation(ActivationType type, double alpha) : type(type), alpha(alpha) {
+    if (type == ActivationType::Custom) {
+        throw std::invalid_argument("Custom activations must be constructed from a function and its derivative");
+    }
+}
+
+template<typename T>
+BasicActivation<T>::BasicActivation(std::function<T(T)> act, std::function<T(T)> act_deriv)
+    : type(detect_type(act, act_deriv)), alpha(0.01), activation(act), activation_derivative(act_deriv) {}
+
+template<typename T>
+ActivationType BasicActivation<T>::getType() const {
+    return type;
+}
+
+template<typename T>
+double BasicActivation<T>::getAlpha() const {
+    return alpha;
+}
+
+template<typename T>
+void BasicActivation<T>::apply(const T* input, T* output, size_t rows, size_t cols) const {
+    const size_t n = rows * cols;
+    switch (type) {
+        case ActivationType::Sigmoid:   Simd::sigmoid(input, output, n); break;
+        case ActivationType::ReLU:      forward_kernel(ReLUKernel<T>{}, input, output, n); break;
+        case ActivationType::LeakyReLU: forward_kernel(LeakyReLUKernel<T>{static_cast<T>(alpha)}, input, output, n); break;
+        case ActivationType::Tanh:      Simd::tanh(input, output, n); break;
+        case ActivationType::GELU:      forward_kernel(GELUKernel<T>{}, input, output, n); break;
+        case ActivationType::SiLU:
+            Simd::sigmoid(input, output, n);
+            for (size_t i = 0; i < n; ++i) {
+                output[i] *= input[i];
+            }
+            break;
+        case ActivationType::Softmax:
+            for (size_t r = 0; r < rows; ++r) {
+                Simd::softmax(input + r * cols, output + r * cols, cols);
+            }
+            break;
+        case ActivationType::Custom:
+            for (size_t i = 0; i < n; ++i) {
+                output[i] = activation(input[i]);
+            }
+            break;
     }
+}
+
+template<typename T>
+void BasicActivation<T>::apply_gradient(const T* input, const T* grad_output, T* grad_input,
+                                size_t rows, size_t cols) const {
+    const size_t n = rows * cols;
+    switch (type) {
+        case ActivationType::Sigmoid:
+            Simd::sigmoid(input, grad_input, n);
+            for (size_t i = 0; i < n; ++i) {
+                const T s = grad_input[i];
+                grad_input[i] = s * (T(1) - s) * grad_output[i];
+            }
+            break;
+        case ActivationType::ReLU:      backward_kernel(ReLUKernel<T>{}, input, grad_output, grad_input, n); break;
+        case ActivationType::LeakyReLU: backward_kernel(LeakyReLUKernel<T>{static_cast<T>(alpha)}, input, grad_output, grad_input, n); break;
+        case ActivationType::Tanh:
+            Simd::tanh(input, grad_input, n);
+            for (size_t i = 0; i < n; ++i) {
+                const T t = grad_input[i];
+                grad_input[i] = (T(1) - t * t) * grad_output[i];
+            }
+            break;
+        case ActivationType::GELU:      backward_kernel(GELUKernel<T>{}, input, grad_output, grad_input, n); break;
+        case ActivationType::SiLU:
+            Simd::sigmoid(input, grad_input, n);
+            for (size_t i = 0; i < n; ++i) {
+                const T s = grad_input[i];
+                grad_input[i] = s * (T(1) + input[i] * (T(1) - s)) * grad_output[i];
+            }
+            break;
+        case ActivationType::Softmax:
+            for (size_t r = 0; r < rows; ++r) {
+                softmax_backward(input + r * cols, grad_output + r * cols, grad_input + r * cols, cols);
+            }
+            break;
+        case ActivationType::Custom:
+            for (size_t i = 0; i < n; ++i) {
+                grad_input[i] = activation_derivative(input[i]) * grad_output[i];
+            }
+            break;
+    }
+}
+
+template<typename T>
+std::vector<T> BasicActivation<T>::forward(const std::vector<T>& input) {
+    input_cache = input;
+    std::vector<T> output(input.size());
+    apply(input.data(), output.data(), 1, input.size());
 
     return output;
 }
 
-std::vector<double> Activation::backward(const std::vector<double>& grad_output, double learning_rate) {
-    std::vector<double> grad_input(grad_output.size());
-    for (size_t i = 0; i < grad_output.size(); ++i) {
-        grad_input[i] = activation_derivative(input_cache[i]) * grad_output[i];
+template<typename T>
+std::vector<T> BasicActivation<T>::backward(const std::vector<T>& grad_output, double learning_rate) {
+    std::vector<T> grad_input(grad_output.size());
+    apply_gradient(input_cache.data(), grad_output.data(), grad_input.data(), 1, grad_output.size());
+
+    return grad_input;
+}
+
+template<typename T>
+size_t BasicActivation<T>::output_size(size_t input_size) const {
+    return input_size;
+}
+
+template<typename T>
+void BasicActivation<T>::infer(Span<const T> input, Span<T> output) const {
+    apply(input.data(), output.data(), 1, input.size());
+}
+
+template<typename T>
+void BasicActivation<T>::infer_batch(BasicConstMatrixView<T> input, BasicMatrixView<T> output) const {
+    if (input.rows != output.rows || input.cols != output.cols) {
+        throw std::invalid_argument("Activation output batch must have the same shape as the input");
+    }
+
+    if (input.stride == input.cols && output.stride == output.cols) {
+        apply(input.data, output.data, input.rows, input.cols);
+        return;
     }
+    for (size_t r = 0; r < input.rows; ++r) {
+        apply(input.row(r), output.row(r), 1, input.cols);
+    }
+}
+
+template<typename T>
+BasicMatrix<T> BasicActivation<T>::forward_batch(const BasicMatrix<T>& input) {
+    batch_input_cache = input;
+    BasicMatrix<T> output = scratch_matrix<T>(input.rows(), input.cols());
+    apply(input.data(), output.data(), input.rows(), input.cols());
+
+    return output;
+}
+
+template<typename T>
+BasicMatrix<T> BasicActivation<T>::backward_batch(const BasicMatrix<T>& grad_output, double) {
+    BasicMatrix<T> grad_input = scratch_matrix<T>(grad_output.rows(), grad_output.cols());
+    apply_gradient(batch_input_cache.data(), grad_output.data(), grad_input.data(),
+                   grad_output.rows(), grad_output.cols());
 
     return grad_input;
 }
 
-std::unique_ptr<Layer> Activation::clone() const {
-    return std::make_unique<Activation>(*this);
-}
\ No newline at end of file
+template<typename T>
+void BasicActivation<T>::forward_hogwild(Span<const T> input, Span<T> output) const {
+    apply(input.data(), output.data(), 1, input.size());
+}
+
+template<typename T>
+void BasicActivation<T>::backward_hogwild(Span<const T> input, Span<const T> grad_output, Span<T> grad_input,
+                                  double) {
+    apply_gradient(input.data(), grad_output.data(), grad_input.data(), 1, input.size());
+}
+
+template<typename T>
+size_t BasicActivation<T>::parameter_count() const {
+    return 0;
+}
+
+template<typename T>
+BasicMatrix<T> BasicActivation<T>::compute_gradients(const BasicMatrix<T>& grad_output, Span<T>) {
+    return backward_batch(grad_output, 0.0);
+}
+
+template<typename T>
+BasicMatrix<T> BasicActivation<T>::accumulate_gradients(const BasicMatrix<T>& grad_output, Span<T>) {
+    return backward_batch(grad_output, 0.0);
+}
+
+template<typename T>
+void BasicActivation<T>::apply_gradients(Span<const T>, double) {
+}
+
+template<typename T>
+void BasicActivation<T>::copy_parameters_from(const BasicLayer<T>& source) {
+    if (dynamic_cast<const BasicActivation<T>*>(&source) == nullptr) {
+        throw std::invalid_argument("Can only copy parameters from another Activation layer");
+    }
+}
+
+template<typename T>
+void BasicActivation<T>::bind_parameters(Span<T> storage, std::shared_ptr<void>) {
+    if (!storage.empty()) {
+        throw std::invalid_argument("Activation layers have no parameters to bind");
+    }
+}
+
+template<typename T>
+std::unique_ptr<BasicLayer<T>> BasicActivation<T>::clone() const {
+    return std::make_unique<BasicActivation<T>>(*this);
+}
+
+template class BasicActivation<float>;
+template class BasicActivation<double>;
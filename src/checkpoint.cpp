@@ -0,0 +1,118 @@
+#include "checkpoint.hpp"
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+template<typename T>
+BasicCheckpointer<T>::BasicCheckpointer(std::string path, int interval)
+    : path(std::move(path)), interval(interval), epoch(0), pending_epoch(0), writing(false), stopping(false) {
+    if (interval < 1) {
+        throw std::invalid_argument("Checkpoint interval must be at least 1");
+    }
+    writer = std::thread([this]() { run(); });
+}
+
+template<typename T>
+BasicCheckpointer<T>::~BasicCheckpointer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    state_changed.notify_all();
+    writer.join();
+}
+
+template<typename T>
+void BasicCheckpointer<T>::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        state_changed.wait(lock, [this]() { return pending != nullptr || stopping; });
+        if (pending == nullptr) {
+            return;
+        }
+
+        std::unique_ptr<BasicNeuralNet<T>> snapshot = std::move(pending);
+        const int snapshot_epoch = pending_epoch;
+        writing = true;
+        lock.unlock();
+
+        std::exception_ptr failure;
+        try {
+            snapshot->save(path, snapshot_epoch);
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        snapshot.reset();
+
+        lock.lock();
+        if (failure && !error) {
+            error = failure;
+        }
+        writing = false;
+        state_changed.notify_all();
+    }
+}
+
+template<typename T>
+void BasicCheckpointer<T>::rethrow_error() {
+    if (error) {
+        std::exception_ptr failure = std::exchange(error, nullptr);
+        std::rethrow_exception(failure);
+    }
+}
+
+template<typename T>
+bool BasicCheckpointer<T>::restore(BasicNeuralNet<T>& net) {
+    wait();
+    if (!std::filesystem::exists(path)) {
+        return false;
+    }
+
+    const int restored = net.restore(path);
+    std::lock_guard<std::mutex> lock(mutex);
+    epoch = restored;
+    return true;
+}
+
+template<typename T>
+void BasicCheckpointer<T>::save(const BasicNeuralNet<T>& net, int completed_epochs) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        rethrow_error();
+    }
+
+    // Copied outside the lock so the writer is never blocked behind the snapshot.
+    auto snapshot = std::make_unique<BasicNeuralNet<T>>(net);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = std::move(snapshot);
+        pending_epoch = completed_epochs;
+        epoch = completed_epochs;
+    }
+    state_changed.notify_all();
+}
+
+template<typename T>
+void BasicCheckpointer<T>::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    state_changed.wait(lock, [this]() { return pending == nullptr && !writing; });
+    rethrow_error();
+}
+
+template<typename T>
+int BasicCheckpointer<T>::getEpoch() const {
+    return epoch;
+}
+
+template<typename T>
+int BasicCheckpointer<T>::getInterval() const {
+    return interval;
+}
+
+template<typename T>
+const std::string& BasicCheckpointer<T>::getPath() const {
+    return path;
+}
+
+template class BasicCheckpointer<float>;
+template class BasicCheckpointer<double>;
@@ -0,0 +1,180 @@
+#include "concurrent_replay_buffer.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    // Marks an empty entry of the drawn-ticket set.
+    constexpr uint64_t NO_TICKET = std::numeric_limits<uint64_t>::max();
+
+    // Relaxed atomic access to slots shared between actors and the learner. On x86-64
+    // these compile to plain loads and stores; the versions order them.
+    template<typename T>
+    inline T load_relaxed(const T* p) {
+        T v;
+        __atomic_load(p, &v, __ATOMIC_RELAXED);
+        return v;
+    }
+
+    template<typename T>
+    inline void store_relaxed(T* p, T v) {
+        __atomic_store(p, &v, __ATOMIC_RELAXED);
+    }
+}
+
+ConcurrentReplayBuffer::ConcurrentReplayBuffer(size_t capacity, size_t state_size)
+    : capacity(capacity), state_size(state_size), gen(std::random_device{}()) {
+    if (capacity == 0) {
+        throw std::invalid_argument("Replay buffer capacity must be at least 1");
+    }
+    if (state_size == 0) {
+        throw std::invalid_argument("Replay buffer state size must be at least 1");
+    }
+
+    states.resize(capacity, state_size);
+    next_states.resize(capacity, state_size);
+    actions.resize(capacity);
+    rewards.resize(capacity);
+    dones.resize(capacity);
+    versions.reset(new std::atomic<uint64_t>[capacity]);
+    for (size_t slot = 0; slot < capacity; ++slot) {
+        versions[slot].store(0, std::memory_order_relaxed);
+    }
+}
+
+void ConcurrentReplayBuffer::push(const Experience& experience) {
+    push(experience.state, experience.action, experience.reward, experience.next_state, experience.done);
+}
+
+void ConcurrentReplayBuffer::push(Span<const double> state, int action, double reward, Span<const double> next_state,
+                                  bool done) {
+    if (state.size() != state_size || next_state.size() != state_size) {
+        throw std::invalid_argument("Experience state size does not match the replay buffer");
+    }
+
+    const uint64_t ticket = next_ticket.fetch_add(1, std::memory_order_relaxed);
+    const size_t slot = ticket % capacity;
+    const uint64_t lap = ticket / capacity;
+    std::atomic<uint64_t>& version = versions[slot];
+
+    // The previous lap's push to this slot ends by storing 2 * lap; it is a whole
+    // capacity of pushes ahead, so this almost never spins.
+    while (version.load(std::memory_order_acquire) != 2 * lap) {
+        std::this_thread::yield();
+    }
+
+    version.store(2 * lap + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    double* state_row = states.row(slot);
+    double* next_state_row = next_states.row(slot);
+    for (size_t k = 0; k < state_size; ++k) {
+        store_relaxed(state_row + k, state[k]);
+        store_relaxed(next_state_row + k, next_state[k]);
+    }
+    store_relaxed(actions.data() + slot, action);
+    store_relaxed(rewards.data() + slot, reward);
+    store_relaxed(dones.data() + slot, (unsigned char)(done ? 1 : 0));
+    version.store(2 * lap + 2, std::memory_order_release);
+
+    completed.fetch_add(1, std::memory_order_release);
+}
+
+bool ConcurrentReplayBuffer::read(uint64_t ticket, ReplayBatch& batch, size_t row) const {
+    const size_t slot = ticket % capacity;
+    const uint64_t expected = 2 * (ticket / capacity) + 2;
+    const std::atomic<uint64_t>& version = versions[slot];
+    if (version.load(std::memory_order_acquire) != expected) {
+        return false;
+    }
+
+    const double* state_row = states.row(slot);
+    const double* next_state_row = next_states.row(slot);
+    double* batch_state = batch.states.row(row);
+    double* batch_next_state = batch.next_states.row(row);
+    for (size_t k = 0; k < state_size; ++k) {
+        batch_state[k] = load_relaxed(state_row + k);
+        batch_next_state[k] = load_relaxed(next_state_row + k);
+    }
+    batch.actions[row] = load_relaxed(actions.data() + slot);
+    batch.rewards[row] = load_relaxed(rewards.data() + slot);
+    batch.dones[row] = load_relaxed(dones.data() + slot);
+    batch.indices[row] = slot;
+
+    // A push that started during the copy has changed the version by now.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return version.load(std::memory_order_relaxed) == expected;
+}
+
+void ConcurrentReplayBuffer::sample(size_t batch_size, ReplayBatch& batch) {
+    if (size() < batch_size) {
+        throw std::runtime_error("Not enough experiences in memory to sample a batch.");
+    }
+
+    batch.states.resize(batch_size, state_size);
+    batch.next_states.resize(batch_size, state_size);
+    batch.actions.resize(batch_size);
+    batch.rewards.resize(batch_size);
+    batch.dones.resize(batch_size);
+    batch.indices.resize(batch_size);
+    batch.weights.clear();
+    batch.discounts.clear();
+
+    size_t table = 2;
+    while (table < 2 * batch_size) {
+        table *= 2;
+    }
+    size_t mask = table - 1;
+    auto insert = [&](uint64_t ticket) {
+        size_t h = (ticket * 0x9E3779B97F4A7C15ull) & mask;
+        while (drawn[h] != NO_TICKET) {
+            if (drawn[h] == ticket) {
+                return false;
+            }
+            h = (h + 1) & mask;
+        }
+        drawn[h] = ticket;
+        return true;
+    };
+
+    // Rejected tickets stay in the set, so a snapshot runs out once more tickets were
+    // rejected than the batch can spare, or once the set is half full; the writers
+    // will have moved on, so retake it. A set that filled up is doubled, until it can
+    // hold the whole window, so a window with few readable slots is still covered.
+    for (;;) {
+        const uint64_t end = next_ticket.load(std::memory_order_acquire);
+        const uint64_t window = std::min<uint64_t>(end, capacity);
+        std::uniform_int_distribution<uint64_t> dist(end - window, end - 1);
+        drawn.assign(table, NO_TICKET);
+        mask = table - 1;
+
+        size_t filled = 0;
+        uint64_t rejected = 0;
+        while (filled < batch_size && window - rejected >= batch_size && filled + rejected < table / 2) {
+            const uint64_t ticket = dist(gen);
+            if (!insert(ticket)) {
+                continue;
+            }
+            if (read(ticket, batch, filled)) {
+                ++filled;
+            } else {
+                ++rejected;
+            }
+        }
+        if (filled == batch_size) {
+            return;
+        }
+        if (filled + rejected >= table / 2 && table < 2 * window) {
+            table *= 2;
+        }
+        std::this_thread::yield();
+    }
+}
+
+size_t ConcurrentReplayBuffer::size() const {
+    return (size_t)std::min<uint64_t>(completed.load(std::memory_order_acquire), capacity);
+}
+
+bool ConcurrentReplayBuffer::is_ready(size_t batch_size) const {
+    return size() >= batch_size;
+}
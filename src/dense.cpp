@@ -1,94 +1,356 @@
 #include "dense.hpp"
 #include "utils.hpp"
+#include "gemm.hpp"
+#include "step_arena.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
 
-Dense::Dense(int input_size, int output_size) {
-    weights.resize(output_size, std::vector<double>(input_size));
-    biases.resize(output_size);
-    for (auto& row : weights) {
-        for (double& w : row) {
-            w = Utils::random_weight();
-        }
+namespace {
+    // Width of the row segments the fused backward pass hands to the optimizer. The
+    // segment and its gradient stay in L1 between computing and applying the update.
+    constexpr size_t FUSED_CHUNK = 256;
+
+    // Relaxed atomic access to parameters shared between Hogwild threads. On x86-64
+    // these compile to plain loads and stores; they only stop the compiler from
+    // tearing, caching or inventing accesses.
+    template<typename T>
+    inline T load_relaxed(const T* p) {
+        T v;
+        __atomic_load(p, &v, __ATOMIC_RELAXED);
+        return v;
+    }
+
+    template<typename T>
+    inline void store_relaxed(T* p, T v) {
+        __atomic_store(p, &v, __ATOMIC_RELAXED);
+    }
+}
+
+template<typename T>
+BasicDense<T>::BasicDense(int input_size, int output_size)
+    : weights(output_size, input_size), biases(1, output_size) {
+    T* w = weights.data();
+    for (size_t k = 0; k < weights.size(); ++k) {
+        w[k] = static_cast<T>(Utils::random_weight());
     }
-    for (double& b : biases) {
-        b = Utils::random_weight();
+    T* b = biases.data();
+    for (size_t i = 0; i < biases.size(); ++i) {
+        b[i] = static_cast<T>(Utils::random_weight());
     }
 }
 
-void Dense::setOptimizer(std::unique_ptr<Optimizer> optimizer) {
+template<typename T>
+BasicDense<T>::BasicDense(BasicMatrix<T> weights, std::vector<T> biases)
+    : weights(std::move(weights)), biases(1, biases.size()) {
+    if (this->weights.empty() || biases.size() != this->weights.rows()) {
+        throw std::invalid_argument("Bias vector size does not match the weight matrix");
+    }
+    std::copy(biases.begin(), biases.end(), this->biases.data());
+}
+
+template<typename T>
+void BasicDense<T>::setOptimizer(std::unique_ptr<BasicOptimizer<T>> optimizer) {
     weight_optimizer = optimizer->clone();
     bias_optimizer = optimizer->clone();
 }
 
-std::vector<double> Dense::forward(const std::vector<double>& input) {
+template<typename T>
+BasicOptimizer<T>* BasicDense<T>::getWeightOptimizer() const {
+    return weight_optimizer.get();
+}
+
+template<typename T>
+BasicOptimizer<T>* BasicDense<T>::getBiasOptimizer() const {
+    return bias_optimizer.get();
+}
+
+template<typename T>
+const BasicMatrix<T>& BasicDense<T>::getWeights() const {
+    return weights;
+}
+
+template<typename T>
+Span<const T> BasicDense<T>::getBiases() const {
+    return Span<const T>(biases.data(), biases.size());
+}
+
+template<typename T>
+void BasicDense<T>::setWeights(const BasicMatrix<T>& new_weights) {
+    if (new_weights.rows() != weights.rows() || new_weights.cols() != weights.cols()) {
+        throw std::invalid_argument("Weight matrix shape does not match the layer");
+    }
+    std::copy(new_weights.data(), new_weights.data() + new_weights.size(), weights.data());
+}
+
+template<typename T>
+void BasicDense<T>::setBiases(Span<const T> new_biases) {
+    if (new_biases.size() != biases.size()) {
+        throw std::invalid_argument("Bias vector size does not match the layer");
+    }
+    std::copy(new_biases.begin(), new_biases.end(), biases.data());
+}
+
+template<typename T>
+std::vector<T> BasicDense<T>::forward(const std::vector<T>& input) {
     input_cache = input;
-    std::vector<double> output(biases);
-    for (size_t i = 0; i < weights.size(); ++i) {
-        for (size_t j = 0; j < weights[i].size(); ++j) {
-            output[i] += weights[i][j] * input[j];
+    std::vector<T> output(biases.data(), biases.data() + biases.size());
+    Gemm::gemv(Gemm::Transpose::No, weights.rows(), weights.cols(), 1.0, weights.data(), weights.stride(),
+               input.data(), 1.0, output.data());
+
+    return output;
+}
+
+template<typename T>
+std::vector<T> BasicDense<T>::backward(const std::vector<T>& grad_output, double learning_rate) {
+    const size_t in = weights.cols();
+    const T* x = input_cache.data();
+    std::vector<T> grad_input(in, T(0));
+    T* gin = grad_input.data();
+
+    // One pass over each weight row: accumulate the input gradient from the old weights,
+    // form the weight gradient g_i * x and apply the update while the row is in cache.
+    if (weight_optimizer && bias_optimizer) {
+        alignas(64) T grad_chunk[FUSED_CHUNK];
+        weight_optimizer->begin_step(weights.size());
+        for (size_t i = 0; i < weights.rows(); ++i) {
+            T* w = weights.row(i);
+            const T g = grad_output[i];
+            for (size_t j0 = 0; j0 < in; j0 += FUSED_CHUNK) {
+                const size_t len = std::min(FUSED_CHUNK, in - j0);
+                for (size_t j = 0; j < len; ++j) {
+                    gin[j0 + j] += w[j0 + j] * g;
+                    grad_chunk[j] = g * x[j0 + j];
+                }
+                weight_optimizer->update_slice(Span<T>(w + j0, len), Span<const T>(grad_chunk, len),
+                                               i * in + j0);
+            }
         }
+        bias_optimizer->update(Span<T>(biases.data(), biases.size()), grad_output);
+    } else {
+        const T lr = static_cast<T>(learning_rate);
+        for (size_t i = 0; i < weights.rows(); ++i) {
+            T* w = weights.row(i);
+            const T g = grad_output[i];
+            const T step = lr * g;
+            for (size_t j = 0; j < in; ++j) {
+                gin[j] += w[j] * g;
+                w[j] -= step * x[j];
+            }
+        }
+        T* b = biases.data();
+        for (size_t i = 0; i < biases.size(); ++i) {
+            b[i] -= lr * grad_output[i];
+        }
+    }
+
+    return grad_input;
+}
+
+template<typename T>
+size_t BasicDense<T>::output_size(size_t input_size) const {
+    if (input_size != weights.cols()) {
+        throw std::invalid_argument("Input size does not match the layer input size");
+    }
+
+    return weights.rows();
+}
+
+template<typename T>
+void BasicDense<T>::infer(Span<const T> input, Span<T> output) const {
+    std::copy(biases.data(), biases.data() + biases.size(), output.data());
+    Gemm::gemv(Gemm::Transpose::No, weights.rows(), weights.cols(), 1.0, weights.data(), weights.stride(),
+               input.data(), 1.0, output.data());
+}
+
+template<typename T>
+void BasicDense<T>::infer_batch(BasicConstMatrixView<T> input, BasicMatrixView<T> output) const {
+    if (input.cols != weights.cols() || output.cols != weights.rows() || output.rows != input.rows) {
+        throw std::invalid_argument("Batch shapes do not match the layer");
+    }
+
+    for (size_t r = 0; r < output.rows; ++r) {
+        std::copy(biases.data(), biases.data() + biases.size(), output.row(r));
+    }
+    Gemm::gemm(Gemm::Transpose::No, Gemm::Transpose::Yes, 1.0, input, weights.view(), 1.0, output);
+}
+
+template<typename T>
+BasicMatrix<T> BasicDense<T>::forward_batch(const BasicMatrix<T>& input) {
+    if (input.cols() != weights.cols()) {
+        throw std::invalid_argument("Input batch width does not match the layer input size");
+    }
+
+    batch_input_cache = input;
+    BasicMatrix<T> output = scratch_matrix<T>(input.rows(), weights.rows());
+    for (size_t r = 0; r < output.rows(); ++r) {
+        std::copy(biases.data(), biases.data() + biases.size(), output.row(r));
     }
 
+    // Y = X * W^T + b
+    Gemm::gemm(Gemm::Transpose::No, Gemm::Transpose::Yes, 1.0, input.view(), weights.view(), 1.0, output.view());
+
     return output;
 }
 
-std::vector<double> Dense::backward(const std::vector<double>& grad_output, double learning_rate) {
-    std::vector<double> grad_input(input_cache.size(), 0.0);
-    
-    for (size_t i = 0; i < weights.size(); ++i) {
-        for (size_t j = 0; j < input_cache.size(); ++j) {
-            grad_input[j] += weights[i][j] * grad_output[i];
+template<typename T>
+BasicMatrix<T> BasicDense<T>::backward_batch(const BasicMatrix<T>& grad_output, double learning_rate) {
+    parameter_gradients.resize(parameter_count());
+    BasicMatrix<T> grad_input = compute_gradients(grad_output, parameter_gradients);
+    apply_gradients(parameter_gradients, learning_rate);
+
+    return grad_input;
+}
+
+template<typename T>
+void BasicDense<T>::forward_hogwild(Span<const T> input, Span<T> output) const {
+    const size_t in = weights.cols();
+    const T* x = input.data();
+    for (size_t i = 0; i < weights.rows(); ++i) {
+        const T* w = weights.row(i);
+        T sum = load_relaxed(biases.data() + i);
+        for (size_t j = 0; j < in; ++j) {
+            sum += load_relaxed(&w[j]) * x[j];
         }
+        output[i] = sum;
     }
-    
-    if (weight_optimizer && bias_optimizer) {
-        std::vector<double> weight_gradients;
-        for (size_t i = 0; i < weights.size(); ++i) {
-            for (size_t j = 0; j < weights[i].size(); ++j) {
-                weight_gradients.push_back(grad_output[i] * input_cache[j]);
-            }
+}
+
+template<typename T>
+void BasicDense<T>::backward_hogwild(Span<const T> input, Span<const T> grad_output, Span<T> grad_input,
+                             double learning_rate) {
+    const size_t in = weights.cols();
+    const T* x = input.data();
+    T* gin = grad_input.data();
+    std::fill(gin, gin + in, T(0));
+
+    // Read-modify-write without locks: a concurrent update to the same weight between
+    // the load and the store is lost, which Hogwild tolerates for sparse-ish updates.
+    for (size_t i = 0; i < weights.rows(); ++i) {
+        T* w = weights.row(i);
+        const T g = grad_output[i];
+        if (g == 0.0) {
+            continue;
         }
-        
-        std::vector<double> flat_weights;
-        for (const auto& row : weights) {
-            for (double w : row) {
-                flat_weights.push_back(w);
-            }
+        const T step = static_cast<T>(learning_rate) * g;
+        for (size_t j = 0; j < in; ++j) {
+            const T wij = load_relaxed(&w[j]);
+            gin[j] += wij * g;
+            store_relaxed(&w[j], wij - step * x[j]);
         }
-        
-        weight_optimizer->update(flat_weights, weight_gradients);
-        
-        size_t idx = 0;
-        for (size_t i = 0; i < weights.size(); ++i) {
-            for (size_t j = 0; j < weights[i].size(); ++j) {
-                weights[i][j] = flat_weights[idx++];
-            }
+        store_relaxed(biases.data() + i, load_relaxed(biases.data() + i) - step);
+    }
+}
+
+template<typename T>
+size_t BasicDense<T>::parameter_count() const {
+    return weights.size() + biases.size();
+}
+
+template<typename T>
+BasicMatrix<T> BasicDense<T>::compute_gradients(const BasicMatrix<T>& grad_output, Span<T> parameter_gradients) {
+    return backpropagate(grad_output, parameter_gradients, false);
+}
+
+template<typename T>
+BasicMatrix<T> BasicDense<T>::accumulate_gradients(const BasicMatrix<T>& grad_output, Span<T> parameter_gradients) {
+    return backpropagate(grad_output, parameter_gradients, true);
+}
+
+template<typename T>
+BasicMatrix<T> BasicDense<T>::backpropagate(const BasicMatrix<T>& grad_output, Span<T> parameter_gradients, bool accumulate) {
+    if (parameter_gradients.size() != parameter_count()) {
+        throw std::invalid_argument("Gradient buffer size does not match the layer parameter count");
+    }
+
+    const size_t in = weights.cols();
+    const size_t out = weights.rows();
+    const size_t batch = grad_output.rows();
+    BasicMatrix<T> grad_input = scratch_matrix<T>(batch, in);
+
+    // grad_input = G * W, using the weights before this step's update
+    Gemm::gemm(Gemm::Transpose::No, Gemm::Transpose::No, 1.0, grad_output.view(), weights.view(), 0.0, grad_input.view());
+
+    // Parameter gradients summed over the batch: dW = G^T * X, db = column sums of G
+    BasicMatrixView<T> weight_gradients{parameter_gradients.data(), out, in, in};
+    Gemm::gemm(Gemm::Transpose::Yes, Gemm::Transpose::No, 1.0, grad_output.view(), batch_input_cache.view(),
+               accumulate ? 1.0 : 0.0, weight_gradients);
+
+    T* bias_gradients = parameter_gradients.data() + weights.size();
+    if (!accumulate) {
+        std::fill(bias_gradients, bias_gradients + out, T(0));
+    }
+    for (size_t r = 0; r < batch; ++r) {
+        const T* g = grad_output.row(r);
+        for (size_t i = 0; i < out; ++i) {
+            bias_gradients[i] += g[i];
         }
-        
-        std::vector<double> bias_gradients = grad_output;
-        bias_optimizer->update(biases, bias_gradients);
+    }
+
+    return grad_input;
+}
+
+template<typename T>
+void BasicDense<T>::apply_gradients(Span<const T> parameter_gradients, double learning_rate) {
+    if (parameter_gradients.size() != parameter_count()) {
+        throw std::invalid_argument("Gradient buffer size does not match the layer parameter count");
+    }
+
+    Span<const T> weight_gradients = parameter_gradients.subspan(0, weights.size());
+    Span<const T> bias_gradients = parameter_gradients.subspan(weights.size(), biases.size());
+    if (weight_optimizer && bias_optimizer) {
+        weight_optimizer->update(Span<T>(weights.data(), weights.size()), weight_gradients);
+        bias_optimizer->update(Span<T>(biases.data(), biases.size()), bias_gradients);
     } else {
-        for (size_t i = 0; i < weights.size(); ++i) {
-            for (size_t j = 0; j < input_cache.size(); ++j) {
-                weights[i][j] -= learning_rate * grad_output[i] * input_cache[j];
-            }
+        const T lr = static_cast<T>(learning_rate);
+        T* w = weights.data();
+        for (size_t k = 0; k < weights.size(); ++k) {
+            w[k] -= lr * weight_gradients[k];
         }
+        T* b = biases.data();
         for (size_t i = 0; i < biases.size(); ++i) {
-            biases[i] -= learning_rate * grad_output[i];
+            b[i] -= lr * bias_gradients[i];
         }
     }
-    
-    return grad_input;
 }
 
-std::unique_ptr<Layer> Dense::clone() const {
-    auto cloned = std::make_unique<Dense>(input_cache.size(), weights.size());
-    cloned->weights = weights;
-    cloned->biases = biases;
+template<typename T>
+void BasicDense<T>::copy_parameters_from(const BasicLayer<T>& source) {
+    const BasicDense<T>* other = dynamic_cast<const BasicDense<T>*>(&source);
+    if (other == nullptr) {
+        throw std::invalid_argument("Can only copy parameters from another Dense layer");
+    }
+    setWeights(other->weights);
+    setBiases(other->getBiases());
+}
+
+template<typename T>
+void BasicDense<T>::bind_parameters(Span<T> storage, std::shared_ptr<void> owner) {
+    if (storage.size() != parameter_count()) {
+        throw std::invalid_argument("Parameter storage size does not match the layer parameter count");
+    }
+
+    T* bound = storage.data();
+    std::copy(weights.data(), weights.data() + weights.size(), bound);
+    std::copy(biases.data(), biases.data() + biases.size(), bound + weights.size());
+    weights = BasicMatrix<T>(bound, weights.rows(), weights.cols(), owner);
+    biases = BasicMatrix<T>(bound + weights.size(), 1, biases.size(), std::move(owner));
+}
+
+template<typename T>
+std::unique_ptr<BasicLayer<T>> BasicDense<T>::clone() const {
+    auto cloned = std::make_unique<BasicDense<T>>(weights, std::vector<T>(biases.data(), biases.data() + biases.size()));
     cloned->input_cache = input_cache;
+    cloned->batch_input_cache = batch_input_cache;
     if (weight_optimizer) {
-        std::unique_ptr<Optimizer> optimizer = weight_optimizer->clone();
-        cloned->setOptimizer(std::move(optimizer));
+        cloned->weight_optimizer = weight_optimizer->clone();
+    }
+    if (bias_optimizer) {
+        cloned->bias_optimizer = bias_optimizer->clone();
     }
-    
+
     return cloned;
-}
\ No newline at end of file
+}
+
+template class BasicDense<float>;
+template class BasicDense<double>;
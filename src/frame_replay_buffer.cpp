@@ -0,0 +1,138 @@
+#include "frame_replay_buffer.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+FrameReplayBuffer::FrameReplayBuffer(size_t capacity, size_t state_size, size_t n_steps, double gamma)
+    : capacity(capacity), state_size(state_size), n_steps(n_steps), gamma(gamma), position(0), frame_count(0),
+      transitions(0), episode_open(false), generation(0), gen(std::random_device{}()) {
+    if (capacity < 2) {
+        throw std::invalid_argument("Frame replay buffer needs room for at least 2 frames");
+    }
+    if (state_size == 0) {
+        throw std::invalid_argument("Replay buffer state size must be at least 1");
+    }
+    if (n_steps == 0) {
+        throw std::invalid_argument("Transitions must span at least 1 step");
+    }
+    if (!(gamma >= 0.0 && gamma <= 1.0)) {
+        throw std::invalid_argument("Discount factor must be in [0, 1]");
+    }
+
+    frames.resize(capacity, state_size);
+    actions.resize(capacity);
+    rewards.resize(capacity);
+    dones.resize(capacity);
+    has_step.assign(capacity, 0);
+    drawn.assign(capacity, 0);
+}
+
+size_t FrameReplayBuffer::write_frame(Span<const double> observation) {
+    const size_t frame = position;
+    if (has_step[frame]) {
+        has_step[frame] = 0;
+        transitions--;
+    }
+    std::copy(observation.begin(), observation.end(), frames.row(frame));
+
+    position = (position + 1) % capacity;
+    if (frame_count < capacity) {
+        frame_count++;
+    }
+
+    return frame;
+}
+
+size_t FrameReplayBuffer::push(const Experience& experience) {
+    return push(experience.state, experience.action, experience.reward, experience.next_state, experience.done);
+}
+
+size_t FrameReplayBuffer::push(Span<const double> state, int action, double reward, Span<const double> next_state,
+                               bool done) {
+    if (state.size() != state_size || next_state.size() != state_size) {
+        throw std::invalid_argument("Experience state size does not match the replay buffer");
+    }
+
+    // The last frame written is the previous next state; reuse it if this step continues it.
+    const size_t last = (position + capacity - 1) % capacity;
+    const bool continues = episode_open && std::equal(state.begin(), state.end(), frames.row(last));
+    const size_t frame = continues ? last : write_frame(state);
+    write_frame(next_state);
+
+    actions[frame] = action;
+    rewards[frame] = reward;
+    dones[frame] = done ? 1 : 0;
+    has_step[frame] = 1;
+    transitions++;
+    episode_open = !done;
+
+    return frame;
+}
+
+void FrameReplayBuffer::sample(size_t batch_size, ReplayBatch& batch) {
+    if (transitions < batch_size) {
+        throw std::runtime_error("Not enough experiences in memory to sample a batch.");
+    }
+
+    batch.states.resize(batch_size, state_size);
+    batch.next_states.resize(batch_size, state_size);
+    batch.actions.resize(batch_size);
+    batch.rewards.resize(batch_size);
+    batch.dones.resize(batch_size);
+    batch.indices.resize(batch_size);
+    batch.discounts.resize(batch_size);
+    batch.weights.clear();
+
+    if (++generation == 0) {
+        std::fill(drawn.begin(), drawn.end(), 0);
+        generation = 1;
+    }
+
+    std::uniform_int_distribution<size_t> dist(0, frame_count - 1);
+    for (size_t r = 0; r < batch_size;) {
+        const size_t frame = dist(gen);
+        if (drawn[frame] == generation) {
+            continue;
+        }
+        drawn[frame] = generation;
+        if (!has_step[frame]) {
+            continue;
+        }
+
+        // Follow the episode: a frame with a step is always followed by its successor,
+        // and the newest frame never has a step, so the walk stays inside the ring.
+        double ret = 0.0;
+        double discount = 1.0;
+        size_t current = frame;
+        bool done = false;
+        for (size_t k = 0; k < n_steps && has_step[current]; ++k) {
+            ret += discount * rewards[current];
+            discount *= gamma;
+            done = dones[current] != 0;
+            current = (current + 1) % capacity;
+            if (done) {
+                break;
+            }
+        }
+
+        std::copy(frames.row(frame), frames.row(frame) + state_size, batch.states.row(r));
+        std::copy(frames.row(current), frames.row(current) + state_size, batch.next_states.row(r));
+        batch.actions[r] = actions[frame];
+        batch.rewards[r] = ret;
+        batch.dones[r] = done ? 1 : 0;
+        batch.discounts[r] = done ? 0.0 : discount;
+        batch.indices[r] = frame;
+        ++r;
+    }
+}
+
+size_t FrameReplayBuffer::size() const {
+    return transitions;
+}
+
+size_t FrameReplayBuffer::getFrameCount() const {
+    return frame_count;
+}
+
+bool FrameReplayBuffer::is_ready(size_t batch_size) const {
+    return transitions >= batch_size;
+}
@@ -0,0 +1,574 @@
+#include "gemm.hpp"
+#include "simd.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GEMM_HAS_AVX2_PATH 1
+#define GEMM_INLINE inline __attribute__((always_inline))
+#define GEMM_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define GEMM_TARGET_VNNI __attribute__((target("avx512f,avx512bw,avx512vl,avx512vnni")))
+#include <immintrin.h>
+#else
+#define GEMM_HAS_AVX2_PATH 0
+#define GEMM_INLINE inline
+#define GEMM_TARGET_AVX2
+#endif
+
+namespace Gemm {
+    namespace {
+        // Register tile computed by one micro-kernel call: 4 rows by two 256-bit
+        // registers' worth of columns (4 x 8 doubles or 4 x 16 floats). That is eight
+        // accumulators, which leaves room in the AVX2 register file for the broadcast
+        // A values and the B row.
+        constexpr std::size_t MR = 4;
+
+        template<typename T>
+        constexpr std::size_t NR = 64 / sizeof(T);
+
+        // Cache blocking: a KC x NR panel of B stays in L1, an MC x KC block of A in L2
+        // and a KC x NC block of B in L3.
+        constexpr std::size_t MC = 128;
+        constexpr std::size_t KC = 256;
+        constexpr std::size_t NC = 2048;
+
+        // Below this many multiply-adds, packing costs more than it saves.
+        constexpr std::size_t SMALL_PRODUCT = 16 * 16 * 16;
+
+        // Independent partial sums in the gemv dot products: one cache line's worth.
+        template<typename T>
+        constexpr std::size_t GEMV_LANES = 64 / sizeof(T);
+
+        template<typename T>
+        using PackBuffer = std::vector<T, AlignedAllocator<T>>;
+
+        // Per-thread packing buffers so concurrent callers never share scratch and
+        // steady-state calls do not allocate.
+        template<typename T>
+        PackBuffer<T>& packed_a() {
+            thread_local PackBuffer<T> buffer;
+            return buffer;
+        }
+
+        template<typename T>
+        PackBuffer<T>& packed_b() {
+            thread_local PackBuffer<T> buffer;
+            return buffer;
+        }
+
+        template<typename T>
+        using MicroKernel = void (*)(std::size_t kc, const T* a, const T* b, T* tile);
+
+        template<typename T>
+        using GemvKernel = void (*)(bool trans, std::size_t m, std::size_t n, T alpha, const T* a,
+                                    std::size_t lda, const T* x, T* y);
+
+        template<typename T>
+        inline T element(const T* m, std::size_t ld, bool trans, std::size_t i, std::size_t j) {
+            return trans ? m[j * ld + i] : m[i * ld + j];
+        }
+
+        // Packs the mc x kc block of op(A) at (ic, pc) into MR-row panels, each stored
+        // column by column and zero-padded to a full MR rows.
+        template<typename T>
+        void pack_a(bool trans, const T* a, std::size_t lda, std::size_t ic, std::size_t pc,
+                    std::size_t mc, std::size_t kc, T* dst) {
+            for (std::size_t ir = 0; ir < mc; ir += MR) {
+                const std::size_t rows = std::min(MR, mc - ir);
+                for (std::size_t p = 0; p < kc; ++p) {
+                    for (std::size_t i = 0; i < rows; ++i) {
+                        *dst++ = element(a, lda, trans, ic + ir + i, pc + p);
+                    }
+                    for (std::size_t i = rows; i < MR; ++i) {
+                        *dst++ = T(0);
+                    }
+                }
+            }
+        }
+
+        // Packs the kc x nc block of op(B) at (pc, jc) into NR-column panels, each stored
+        // row by row and zero-padded to a full NR columns.
+        template<typename T>
+        void pack_b(bool trans, const T* b, std::size_t ldb, std::size_t pc, std::size_t jc,
+                    std::size_t kc, std::size_t nc, T* dst) {
+            for (std::size_t jr = 0; jr < nc; jr += NR<T>) {
+                const std::size_t cols = std::min(NR<T>, nc - jr);
+                for (std::size_t p = 0; p < kc; ++p) {
+                    for (std::size_t j = 0; j < cols; ++j) {
+                        *dst++ = element(b, ldb, trans, pc + p, jc + jr + j);
+                    }
+                    for (std::size_t j = cols; j < NR<T>; ++j) {
+                        *dst++ = T(0);
+                    }
+                }
+            }
+        }
+
+        // tile = A_panel * B_panel over kc steps. The accumulator array is small and
+        // fully unrolled, so it lives in vector registers and each j loop becomes
+        // one or two vector multiply-adds.
+        template<typename T>
+        GEMM_INLINE void micro_kernel_body(std::size_t kc, const T* __restrict a, const T* __restrict b,
+                                           T* __restrict tile) {
+            constexpr std::size_t nr = NR<T>;
+            T acc[MR][nr] = {};
+            for (std::size_t p = 0; p < kc; ++p) {
+                for (std::size_t i = 0; i < MR; ++i) {
+                    const T ai = a[i];
+                    for (std::size_t j = 0; j < nr; ++j) {
+                        acc[i][j] += ai * b[j];
+                    }
+                }
+                a += MR;
+                b += nr;
+            }
+            for (std::size_t i = 0; i < MR; ++i) {
+                for (std::size_t j = 0; j < nr; ++j) {
+                    tile[i * nr + j] = acc[i][j];
+                }
+            }
+        }
+
+        // y = alpha * op(A) * x, accumulated into y. Dot products keep a cache line's
+        // worth of independent partial sums so the compiler can vectorize them without
+        // reassociating.
+        template<typename T>
+        GEMM_INLINE void gemv_body(bool trans, std::size_t m, std::size_t n, T alpha, const T* a,
+                                   std::size_t lda, const T* __restrict x, T* __restrict y) {
+            constexpr std::size_t lanes = GEMV_LANES<T>;
+            if (!trans) {
+                for (std::size_t i = 0; i < m; ++i) {
+                    const T* row = a + i * lda;
+                    T partial[lanes] = {};
+                    std::size_t j = 0;
+                    for (; j + lanes <= n; j += lanes) {
+                        for (std::size_t l = 0; l < lanes; ++l) {
+                            partial[l] += row[j + l] * x[j + l];
+                        }
+                    }
+                    for (std::size_t width = lanes / 2; width > 0; width /= 2) {
+                        for (std::size_t l = 0; l < width; ++l) {
+                            partial[l] += partial[l + width];
+                        }
+                    }
+                    T sum = partial[0];
+                    for (; j < n; ++j) {
+                        sum += row[j] * x[j];
+                    }
+                    y[i] += alpha * sum;
+                }
+            } else {
+                std::size_t i = 0;
+                for (; i + 4 <= m; i += 4) {
+                    const T* r0 = a + i * lda;
+                    const T* r1 = r0 + lda;
+                    const T* r2 = r1 + lda;
+                    const T* r3 = r2 + lda;
+                    const T x0 = alpha * x[i];
+                    const T x1 = alpha * x[i + 1];
+                    const T x2 = alpha * x[i + 2];
+                    const T x3 = alpha * x[i + 3];
+                    for (std::size_t j = 0; j < n; ++j) {
+                        y[j] += x0 * r0[j] + x1 * r1[j] + x2 * r2[j] + x3 * r3[j];
+                    }
+                }
+                for (; i < m; ++i) {
+                    const T* r = a + i * lda;
+                    const T xi = alpha * x[i];
+                    for (std::size_t j = 0; j < n; ++j) {
+                        y[j] += xi * r[j];
+                    }
+                }
+            }
+        }
+
+        template<typename T>
+        void micro_kernel_generic(std::size_t kc, const T* a, const T* b, T* tile) {
+            micro_kernel_body(kc, a, b, tile);
+        }
+
+        template<typename T>
+        void gemv_generic(bool trans, std::size_t m, std::size_t n, T alpha, const T* a,
+                          std::size_t lda, const T* x, T* y) {
+            gemv_body(trans, m, n, alpha, a, lda, x, y);
+        }
+
+#if GEMM_HAS_AVX2_PATH
+        template<typename T>
+        GEMM_TARGET_AVX2 void micro_kernel_avx2(std::size_t kc, const T* a, const T* b, T* tile) {
+            micro_kernel_body(kc, a, b, tile);
+        }
+
+        template<typename T>
+        GEMM_TARGET_AVX2 void gemv_avx2(bool trans, std::size_t m, std::size_t n, T alpha, const T* a,
+                                        std::size_t lda, const T* x, T* y) {
+            gemv_body(trans, m, n, alpha, a, lda, x, y);
+        }
+
+        bool cpu_has_avx2() {
+            return Simd::detect_isa() != Simd::Isa::Scalar;
+        }
+#endif
+
+        template<typename T>
+        MicroKernel<T> select_micro_kernel() {
+#if GEMM_HAS_AVX2_PATH
+            if (cpu_has_avx2()) {
+                return micro_kernel_avx2<T>;
+            }
+#endif
+            return micro_kernel_generic<T>;
+        }
+
+        template<typename T>
+        GemvKernel<T> select_gemv_kernel() {
+#if GEMM_HAS_AVX2_PATH
+            if (cpu_has_avx2()) {
+                return gemv_avx2<T>;
+            }
+#endif
+            return gemv_generic<T>;
+        }
+
+        // C = beta * C, without reading C when beta is 0.
+        template<typename T>
+        void scale_c(std::size_t m, std::size_t n, T beta, T* c, std::size_t ldc) {
+            if (beta == T(1)) {
+                return;
+            }
+            for (std::size_t i = 0; i < m; ++i) {
+                T* row = c + i * ldc;
+                if (beta == T(0)) {
+                    std::fill(row, row + n, T(0));
+                } else {
+                    for (std::size_t j = 0; j < n; ++j) {
+                        row[j] *= beta;
+                    }
+                }
+            }
+        }
+
+        // Unblocked product for shapes too small to amortize packing. C has already been
+        // scaled by beta. The loop order keeps the innermost access contiguous in C.
+        template<typename T>
+        void gemm_small(bool trans_a, bool trans_b, std::size_t m, std::size_t n, std::size_t k, T alpha,
+                        const T* a, std::size_t lda, const T* b, std::size_t ldb,
+                        T* c, std::size_t ldc) {
+            for (std::size_t i = 0; i < m; ++i) {
+                T* crow = c + i * ldc;
+                for (std::size_t p = 0; p < k; ++p) {
+                    const T aip = alpha * element(a, lda, trans_a, i, p);
+                    if (!trans_b) {
+                        const T* brow = b + p * ldb;
+                        for (std::size_t j = 0; j < n; ++j) {
+                            crow[j] += aip * brow[j];
+                        }
+                    } else {
+                        for (std::size_t j = 0; j < n; ++j) {
+                            crow[j] += aip * b[j * ldb + p];
+                        }
+                    }
+                }
+            }
+        }
+
+        // Runs the micro-kernel over one packed mc x kc block of A and kc x nc block of B
+        // and accumulates alpha * result into the corresponding block of C.
+        template<typename T>
+        void macro_kernel(MicroKernel<T> kernel, std::size_t mc, std::size_t nc, std::size_t kc, T alpha,
+                          const T* pa, const T* pb, T* c, std::size_t ldc) {
+            constexpr std::size_t nr = NR<T>;
+            alignas(64) T tile[MR * nr];
+            for (std::size_t jr = 0; jr < nc; jr += nr) {
+                const std::size_t cols = std::min(nr, nc - jr);
+                const T* b_panel = pb + jr * kc;
+                for (std::size_t ir = 0; ir < mc; ir += MR) {
+                    const std::size_t rows = std::min(MR, mc - ir);
+                    kernel(kc, pa + ir * kc, b_panel, tile);
+                    for (std::size_t i = 0; i < rows; ++i) {
+                        T* crow = c + (ir + i) * ldc + jr;
+                        const T* trow = tile + i * nr;
+                        for (std::size_t j = 0; j < cols; ++j) {
+                            crow[j] += alpha * trow[j];
+                        }
+                    }
+                }
+            }
+        }
+
+        template<typename T>
+        void gemm_impl(Transpose trans_a, Transpose trans_b, std::size_t m, std::size_t n, std::size_t k,
+                       T alpha, const T* a, std::size_t lda, const T* b, std::size_t ldb,
+                       T beta, T* c, std::size_t ldc) {
+            if (m == 0 || n == 0) {
+                return;
+            }
+
+            scale_c(m, n, beta, c, ldc);
+            if (k == 0 || alpha == T(0)) {
+                return;
+            }
+
+            const bool ta = trans_a == Transpose::Yes;
+            const bool tb = trans_b == Transpose::Yes;
+
+            if (m * n * k <= SMALL_PRODUCT) {
+                gemm_small(ta, tb, m, n, k, alpha, a, lda, b, ldb, c, ldc);
+                return;
+            }
+
+            static const MicroKernel<T> kernel = select_micro_kernel<T>();
+            constexpr std::size_t nr = NR<T>;
+
+            const std::size_t kc_max = std::min(KC, k);
+            const std::size_t mc_max = std::min(MC, m);
+            const std::size_t nc_max = std::min(NC, n);
+            PackBuffer<T>& pa = packed_a<T>();
+            PackBuffer<T>& pb = packed_b<T>();
+            pa.resize(((mc_max + MR - 1) / MR) * MR * kc_max);
+            pb.resize(((nc_max + nr - 1) / nr) * nr * kc_max);
+
+            for (std::size_t jc = 0; jc < n; jc += NC) {
+                const std::size_t nc = std::min(NC, n - jc);
+                for (std::size_t pc = 0; pc < k; pc += KC) {
+                    const std::size_t kc = std::min(KC, k - pc);
+                    pack_b(tb, b, ldb, pc, jc, kc, nc, pb.data());
+                    for (std::size_t ic = 0; ic < m; ic += MC) {
+                        const std::size_t mc = std::min(MC, m - ic);
+                        pack_a(ta, a, lda, ic, pc, mc, kc, pa.data());
+                        macro_kernel(kernel, mc, nc, kc, alpha, pa.data(), pb.data(), c + ic * ldc + jc, ldc);
+                    }
+                }
+            }
+        }
+
+        template<typename T>
+        void gemm_view_impl(Transpose trans_a, Transpose trans_b, T alpha, BasicConstMatrixView<T> a,
+                            BasicConstMatrixView<T> b, T beta, BasicMatrixView<T> c) {
+            const std::size_t m = trans_a == Transpose::Yes ? a.cols : a.rows;
+            const std::size_t k = trans_a == Transpose::Yes ? a.rows : a.cols;
+            const std::size_t kb = trans_b == Transpose::Yes ? b.cols : b.rows;
+            const std::size_t n = trans_b == Transpose::Yes ? b.rows : b.cols;
+            if (k != kb || c.rows != m || c.cols != n) {
+                throw std::invalid_argument("Matrix shapes are not compatible for multiplication");
+            }
+
+            gemm_impl(trans_a, trans_b, m, n, k, alpha, a.data, a.stride, b.data, b.stride, beta, c.data, c.stride);
+        }
+
+        template<typename T>
+        void gemv_impl(Transpose trans_a, std::size_t m, std::size_t n, T alpha, const T* a, std::size_t lda,
+                       const T* x, T beta, T* y) {
+            const bool trans = trans_a == Transpose::Yes;
+            const std::size_t y_size = trans ? n : m;
+            if (beta == T(0)) {
+                std::fill(y, y + y_size, T(0));
+            } else if (beta != T(1)) {
+                for (std::size_t i = 0; i < y_size; ++i) {
+                    y[i] *= beta;
+                }
+            }
+            if (alpha == T(0)) {
+                return;
+            }
+
+            static const GemvKernel<T> kernel = select_gemv_kernel<T>();
+            kernel(trans, m, n, alpha, a, lda, x, y);
+        }
+    }
+
+    void gemm(Transpose trans_a, Transpose trans_b, std::size_t m, std::size_t n, std::size_t k,
+              double alpha, const double* a, std::size_t lda, const double* b, std::size_t ldb,
+              double beta, double* c, std::size_t ldc) {
+        gemm_impl(trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
+
+    void gemm(Transpose trans_a, Transpose trans_b, std::size_t m, std::size_t n, std::size_t k,
+              float alpha, const float* a, std::size_t lda, const float* b, std::size_t ldb,
+              float beta, float* c, std::size_t ldc) {
+        gemm_impl(trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
+
+    void gemm(Transpose trans_a, Transpose trans_b, double alpha, ConstMatrixView a, ConstMatrixView b,
+              double beta, MatrixView c) {
+        gemm_view_impl(trans_a, trans_b, alpha, a, b, beta, c);
+    }
+
+    void gemm(Transpose trans_a, Transpose trans_b, float alpha, ConstMatrixViewF a, ConstMatrixViewF b,
+              float beta, MatrixViewF c) {
+        gemm_view_impl(trans_a, trans_b, alpha, a, b, beta, c);
+    }
+
+    void gemv(Transpose trans_a, std::size_t m, std::size_t n, double alpha, const double* a, std::size_t lda,
+              const double* x, double beta, double* y) {
+        gemv_impl(trans_a, m, n, alpha, a, lda, x, beta, y);
+    }
+
+    void gemv(Transpose trans_a, std::size_t m, std::size_t n, float alpha, const float* a, std::size_t lda,
+              const float* x, float beta, float* y) {
+        gemv_impl(trans_a, m, n, alpha, a, lda, x, beta, y);
+    }
+
+    namespace {
+        // Signature shared by the int8 kernels: out[r] = dot(x, w + r * ldw) for r < rows,
+        // each dot product k elements long.
+        using DotRowsKernel = void (*)(std::size_t k, const std::int8_t* x, const std::int8_t* w,
+                                       std::size_t ldw, std::size_t rows, std::int32_t* out);
+
+        // Weight rows per block in gemm_s8, sized so the block stays in L1 while every
+        // row of A is run against it.
+        constexpr std::size_t S8_BLOCK_BYTES = 16 * 1024;
+
+        std::int32_t dot_s8_scalar(std::size_t k, const std::int8_t* x, const std::int8_t* w) {
+            std::int32_t sum = 0;
+            for (std::size_t p = 0; p < k; ++p) {
+                sum += (std::int32_t)x[p] * (std::int32_t)w[p];
+            }
+            return sum;
+        }
+
+        void dot_rows_generic(std::size_t k, const std::int8_t* x, const std::int8_t* w, std::size_t ldw,
+                              std::size_t rows, std::int32_t* out) {
+            for (std::size_t r = 0; r < rows; ++r) {
+                out[r] = dot_s8_scalar(k, x, w + r * ldw);
+            }
+        }
+
+#if GEMM_HAS_AVX2_PATH
+        GEMM_TARGET_AVX2 std::int32_t hsum_epi32_avx2(__m256i v) {
+            __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+            s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+            s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_cvtsi128_si32(s);
+        }
+
+        // 16 int8 at a time, sign-extended to int16; madd multiplies and adds adjacent
+        // pairs into int32 lanes. Four weight rows share each load of x.
+        GEMM_TARGET_AVX2 void dot_rows_avx2(std::size_t k, const std::int8_t* x, const std::int8_t* w,
+                                            std::size_t ldw, std::size_t rows, std::int32_t* out) {
+            const std::size_t k16 = k - k % 16;
+            std::size_t r = 0;
+            for (; r + 4 <= rows; r += 4) {
+                const std::int8_t* w0 = w + r * ldw;
+                const std::int8_t* w1 = w0 + ldw;
+                const std::int8_t* w2 = w1 + ldw;
+                const std::int8_t* w3 = w2 + ldw;
+                __m256i acc0 = _mm256_setzero_si256();
+                __m256i acc1 = _mm256_setzero_si256();
+                __m256i acc2 = _mm256_setzero_si256();
+                __m256i acc3 = _mm256_setzero_si256();
+                for (std::size_t p = 0; p < k16; p += 16) {
+                    const __m256i xv = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(x + p)));
+                    acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(xv, _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(w0 + p)))));
+                    acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(xv, _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(w1 + p)))));
+                    acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(xv, _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(w2 + p)))));
+                    acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(xv, _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(w3 + p)))));
+                }
+                out[r] = hsum_epi32_avx2(acc0) + dot_s8_scalar(k - k16, x + k16, w0 + k16);
+                out[r + 1] = hsum_epi32_avx2(acc1) + dot_s8_scalar(k - k16, x + k16, w1 + k16);
+                out[r + 2] = hsum_epi32_avx2(acc2) + dot_s8_scalar(k - k16, x + k16, w2 + k16);
+                out[r + 3] = hsum_epi32_avx2(acc3) + dot_s8_scalar(k - k16, x + k16, w3 + k16);
+            }
+            for (; r < rows; ++r) {
+                const std::int8_t* wr = w + r * ldw;
+                __m256i acc = _mm256_setzero_si256();
+                for (std::size_t p = 0; p < k16; p += 16) {
+                    const __m256i xv = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(x + p)));
+                    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(xv, _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(wr + p)))));
+                }
+                out[r] = hsum_epi32_avx2(acc) + dot_s8_scalar(k - k16, x + k16, wr + k16);
+            }
+        }
+
+        // 32 int8 at a time, sign-extended to int16; vpdpwssd multiplies adjacent pairs
+        // and accumulates into int32 lanes in one instruction. The tail uses masked loads.
+        // As in the Simd kernels, GCC 12 gives a false -Wmaybe-uninitialized from inside
+        // the AVX-512 reduction intrinsic.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+        GEMM_TARGET_VNNI void dot_rows_vnni(std::size_t k, const std::int8_t* x, const std::int8_t* w,
+                                            std::size_t ldw, std::size_t rows, std::int32_t* out) {
+            const std::size_t k32 = k - k % 32;
+            const __mmask32 tail = (__mmask32)((1ull << (k - k32)) - 1ull);
+            const __m512i x_tail = _mm512_cvtepi8_epi16(_mm256_maskz_loadu_epi8(tail, x + k32));
+            std::size_t r = 0;
+            for (; r + 4 <= rows; r += 4) {
+                const std::int8_t* w0 = w + r * ldw;
+                const std::int8_t* w1 = w0 + ldw;
+                const std::int8_t* w2 = w1 + ldw;
+                const std::int8_t* w3 = w2 + ldw;
+                __m512i acc0 = _mm512_setzero_si512();
+                __m512i acc1 = _mm512_setzero_si512();
+                __m512i acc2 = _mm512_setzero_si512();
+                __m512i acc3 = _mm512_setzero_si512();
+                for (std::size_t p = 0; p < k32; p += 32) {
+                    const __m512i xv = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(x + p)));
+                    acc0 = _mm512_dpwssd_epi32(acc0, xv, _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(w0 + p))));
+                    acc1 = _mm512_dpwssd_epi32(acc1, xv, _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(w1 + p))));
+                    acc2 = _mm512_dpwssd_epi32(acc2, xv, _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(w2 + p))));
+                    acc3 = _mm512_dpwssd_epi32(acc3, xv, _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(w3 + p))));
+                }
+                if (tail != 0) {
+                    acc0 = _mm512_dpwssd_epi32(acc0, x_tail, _mm512_cvtepi8_epi16(_mm256_maskz_loadu_epi8(tail, w0 + k32)));
+                    acc1 = _mm512_dpwssd_epi32(acc1, x_tail, _mm512_cvtepi8_epi16(_mm256_maskz_loadu_epi8(tail, w1 + k32)));
+                    acc2 = _mm512_dpwssd_epi32(acc2, x_tail, _mm512_cvtepi8_epi16(_mm256_maskz_loadu_epi8(tail, w2 + k32)));
+                    acc3 = _mm512_dpwssd_epi32(acc3, x_tail, _mm512_cvtepi8_epi16(_mm256_maskz_loadu_epi8(tail, w3 + k32)));
+                }
+                out[r] = _mm512_reduce_add_epi32(acc0);
+                out[r + 1] = _mm512_reduce_add_epi32(acc1);
+                out[r + 2] = _mm512_reduce_add_epi32(acc2);
+                out[r + 3] = _mm512_reduce_add_epi32(acc3);
+            }
+            for (; r < rows; ++r) {
+                const std::int8_t* wr = w + r * ldw;
+                __m512i acc = _mm512_setzero_si512();
+                for (std::size_t p = 0; p < k32; p += 32) {
+                    const __m512i xv = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(x + p)));
+                    acc = _mm512_dpwssd_epi32(acc, xv, _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i*)(wr + p))));
+                }
+                if (tail != 0) {
+                    acc = _mm512_dpwssd_epi32(acc, x_tail, _mm512_cvtepi8_epi16(_mm256_maskz_loadu_epi8(tail, wr + k32)));
+                }
+                out[r] = _mm512_reduce_add_epi32(acc);
+            }
+        }
+#pragma GCC diagnostic pop
+
+        bool cpu_has_vnni() {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl") &&
+                   __builtin_cpu_supports("avx512vnni");
+        }
+#endif
+
+        DotRowsKernel select_dot_rows_kernel() {
+#if GEMM_HAS_AVX2_PATH
+            if (cpu_has_vnni()) {
+                return dot_rows_vnni;
+            }
+            if (cpu_has_avx2()) {
+                return dot_rows_avx2;
+            }
+#endif
+            return dot_rows_generic;
+        }
+    }
+
+    void gemm_s8(std::size_t m, std::size_t n, std::size_t k, const std::int8_t* a, std::size_t lda,
+                 const std::int8_t* b, std::size_t ldb, std::int32_t* c, std::size_t ldc) {
+        static const DotRowsKernel kernel = select_dot_rows_kernel();
+        const std::size_t block = std::max<std::size_t>(4, (S8_BLOCK_BYTES / std::max<std::size_t>(k, 1)) & ~std::size_t(3));
+        for (std::size_t j0 = 0; j0 < n; j0 += block) {
+            const std::size_t rows = std::min(block, n - j0);
+            for (std::size_t i = 0; i < m; ++i) {
+                kernel(k, a + i * lda, b + j0 * ldb, ldb, rows, c + i * ldc + j0);
+            }
+        }
+    }
+
+    void gemv_s8(std::size_t m, std::size_t n, const std::int8_t* a, std::size_t lda, const std::int8_t* x,
+                 std::int32_t* y) {
+        gemm_s8(1, m, n, x, n, a, lda, y, m);
+    }
+}
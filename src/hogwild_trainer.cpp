@@ -0,0 +1,91 @@
+#include "hogwild_trainer.hpp"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+    // Sample slices per worker, so stealing can even out uneven progress.
+    constexpr size_t SLICES_PER_WORKER = 4;
+}
+
+HogwildTrainer::HogwildTrainer(NeuralNet& model, ThreadPool& pool) : model(model), pool(pool) {
+    if (!model.getLoss()) {
+        throw std::invalid_argument("HogwildTrainer needs a network with a loss function");
+    }
+}
+
+double HogwildTrainer::train(const std::vector<std::vector<double>>& inputs, const std::vector<std::vector<double>>& targets,
+                             int epochs, double learning_rate) {
+    if (inputs.size() != targets.size()) {
+        throw std::invalid_argument("Inputs and targets must have the same number of samples");
+    }
+    if (inputs.empty()) {
+        return 0.0;
+    }
+
+    const auto& layers = model.getLayers();
+    const size_t input_size = inputs[0].size();
+    const size_t output_size = model.output_size(input_size);
+
+    // sizes[j] is the input size of layer j; sizes.back() is the network output size
+    std::vector<size_t> sizes = {input_size};
+    for (const auto& layer : layers) {
+        sizes.push_back(layer->output_size(sizes.back()));
+    }
+    const size_t widest = *std::max_element(sizes.begin(), sizes.end());
+
+    const size_t slices = pool.size() * SLICES_PER_WORKER;
+    const size_t grain = std::max<size_t>(1, (inputs.size() + slices - 1) / slices);
+    std::vector<double> slice_losses((inputs.size() + grain - 1) / grain);
+
+    for (int epoch = 0; epoch < epochs; ++epoch) {
+        pool.parallel_for(0, inputs.size(), grain, [&](size_t lo, size_t hi) {
+            // Per-slice scratch: every layer's input for backprop, plus two gradient buffers
+            std::unique_ptr<Loss> loss = model.getLoss()->clone();
+            std::vector<std::vector<double>> activations(sizes.size());
+            for (size_t j = 0; j < sizes.size(); ++j) {
+                activations[j].resize(sizes[j]);
+            }
+            std::vector<double> grad(widest);
+            std::vector<double> grad_next(widest);
+
+            double total = 0.0;
+            for (size_t s = lo; s < hi; ++s) {
+                if (inputs[s].size() != input_size || targets[s].size() != output_size) {
+                    throw std::invalid_argument("All samples must have the same size");
+                }
+
+                std::copy(inputs[s].begin(), inputs[s].end(), activations[0].begin());
+                for (size_t j = 0; j < layers.size(); ++j) {
+                    layers[j]->forward_hogwild(activations[j], activations[j + 1]);
+                }
+
+                total += loss->compute(activations.back(), targets[s]);
+                std::vector<double> loss_grad = loss->gradient(activations.back(), targets[s]);
+                std::copy(loss_grad.begin(), loss_grad.end(), grad.begin());
+                for (size_t j = layers.size(); j-- > 0;) {
+                    layers[j]->backward_hogwild(activations[j], Span<const double>(grad.data(), sizes[j + 1]),
+                                                Span<double>(grad_next.data(), sizes[j]), learning_rate);
+                    grad.swap(grad_next);
+                }
+            }
+            slice_losses[lo / grain] = total;
+        });
+
+        if (epoch % 1000 == 0) {
+            double total = 0.0;
+            for (double loss : slice_losses) {
+                total += loss;
+            }
+            std::cout << "Epoch " << epoch << ", Average Loss: " << total / inputs.size() << std::endl;
+        }
+    }
+
+    double total = 0.0;
+    for (double loss : slice_losses) {
+        total += loss;
+    }
+
+    return total / inputs.size();
+}
@@ -0,0 +1,55 @@
+#include "inference_plan.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+template<typename T>
+BasicInferencePlan<T>::BasicInferencePlan(const BasicNeuralNet<T>& net, size_t input_size) {
+    sizes.push_back(input_size);
+    size_t largest = 0;
+    for (const auto& layer : net.getLayers()) {
+        const size_t out = layer->output_size(sizes.back());
+        layers.push_back(layer);
+        sizes.push_back(out);
+        largest = std::max(largest, out);
+    }
+
+    // The last output goes straight to the caller, so only intermediates need room
+    buffers[0].resize(largest);
+    buffers[1].resize(largest);
+}
+
+template<typename T>
+size_t BasicInferencePlan<T>::input_size() const {
+    return sizes.front();
+}
+
+template<typename T>
+size_t BasicInferencePlan<T>::output_size() const {
+    return sizes.back();
+}
+
+template<typename T>
+void BasicInferencePlan<T>::predict(Span<const T> input, Span<T> output) {
+    if (input.size() != input_size()) {
+        throw std::invalid_argument("Input size does not match the inference plan");
+    }
+    if (output.size() != output_size()) {
+        throw std::invalid_argument("Output size does not match the inference plan");
+    }
+    if (layers.empty()) {
+        std::copy(input.begin(), input.end(), output.begin());
+        return;
+    }
+
+    Span<const T> current = input;
+    const size_t last = layers.size() - 1;
+    for (size_t i = 0; i < last; ++i) {
+        Span<T> next(buffers[i % 2].data(), sizes[i + 1]);
+        layers[i]->infer(current, next);
+        current = next;
+    }
+    layers[last]->infer(current, output);
+}
+
+template class BasicInferencePlan<float>;
+template class BasicInferencePlan<double>;
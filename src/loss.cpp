@@ -1,34 +1,79 @@
 #include "loss.hpp"
+#include "step_arena.hpp"
 #include <cmath>
 #include <stdexcept>
 
-double MSELoss::compute(const std::vector<double>& predicted, const std::vector<double>& actual) {
+template<typename T>
+double BasicMSELoss<T>::compute(const std::vector<T>& predicted, const std::vector<T>& actual) {
     if (predicted.size() != actual.size()) {
         throw std::invalid_argument("Predicted and actual vectors must have the same size");
     }
     
     double mse = 0.0;
     for (size_t i = 0; i < predicted.size(); ++i) {
-        double diff = predicted[i] - actual[i];
+        double diff = (double)predicted[i] - (double)actual[i];
         mse += diff * diff;
     }
     
     return mse / predicted.size();
 }
 
-std::vector<double> MSELoss::gradient(const std::vector<double>& predicted, const std::vector<double>& actual) {
+template<typename T>
+std::vector<T> BasicMSELoss<T>::gradient(const std::vector<T>& predicted, const std::vector<T>& actual) {
     if (predicted.size() != actual.size()) {
         throw std::invalid_argument("Predicted and actual vectors must have the same size");
     }
     
-    std::vector<double> grad(predicted.size());
+    std::vector<T> grad(predicted.size());
     for (size_t i = 0; i < predicted.size(); ++i) {
-        grad[i] = 2.0 * (predicted[i] - actual[i]) / predicted.size();
+        grad[i] = static_cast<T>(2.0 * ((double)predicted[i] - (double)actual[i]) / predicted.size());
     }
     
     return grad;
 }
 
-std::unique_ptr<Loss> MSELoss::clone() const {
-    return std::make_unique<MSELoss>(*this);
-}
\ No newline at end of file
+template<typename T>
+double BasicMSELoss<T>::compute_batch(const BasicMatrix<T>& predicted, const BasicMatrix<T>& actual) {
+    if (predicted.rows() != actual.rows() || predicted.cols() != actual.cols()) {
+        throw std::invalid_argument("Predicted and actual batches must have the same shape");
+    }
+    if (predicted.empty()) {
+        return 0.0;
+    }
+
+    const T* p = predicted.data();
+    const T* a = actual.data();
+    double mse = 0.0;
+    for (size_t k = 0; k < predicted.size(); ++k) {
+        double diff = (double)p[k] - (double)a[k];
+        mse += diff * diff;
+    }
+
+    return mse / predicted.size();
+}
+
+template<typename T>
+BasicMatrix<T> BasicMSELoss<T>::gradient_batch(const BasicMatrix<T>& predicted, const BasicMatrix<T>& actual) {
+    if (predicted.rows() != actual.rows() || predicted.cols() != actual.cols()) {
+        throw std::invalid_argument("Predicted and actual batches must have the same shape");
+    }
+
+    BasicMatrix<T> grad = scratch_matrix<T>(predicted.rows(), predicted.cols());
+    const T* p = predicted.data();
+    const T* a = actual.data();
+    T* g = grad.data();
+    const T scale = static_cast<T>(2.0 / (double)predicted.size());
+    for (size_t k = 0; k < predicted.size(); ++k) {
+        g[k] = scale * (p[k] - a[k]);
+    }
+
+    return grad;
+}
+
+template<typename T>
+std::unique_ptr<BasicLoss<T>> BasicMSELoss<T>::clone() const {
+    return std::make_unique<BasicMSELoss<T>>(*this);
+}
+
+template class BasicMSELoss<float>;
+template class BasicMSELoss<double>;
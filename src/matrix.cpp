@@ -0,0 +1,72 @@
+#include "matrix.hpp"
+#include <algorithm>
+#include <utility>
+
+template<typename T>
+BasicMatrix<T>::BasicMatrix() : elements(nullptr), num_rows(0), num_cols(0) {}
+
+template<typename T>
+BasicMatrix<T>::BasicMatrix(std::size_t rows, std::size_t cols, T value)
+    : storage(rows * cols, value), elements(storage.data()), num_rows(rows), num_cols(cols) {}
+
+template<typename T>
+BasicMatrix<T>::BasicMatrix(T* data, std::size_t rows, std::size_t cols, std::shared_ptr<void> owner)
+    : elements(data), owner(std::move(owner)), num_rows(rows), num_cols(cols) {}
+
+template<typename T>
+BasicMatrix<T>::BasicMatrix(const BasicMatrix& other)
+    : storage(other.data(), other.data() + other.size()), elements(storage.data()),
+      num_rows(other.num_rows), num_cols(other.num_cols) {}
+
+template<typename T>
+BasicMatrix<T>::BasicMatrix(BasicMatrix&& other) noexcept
+    : storage(std::move(other.storage)), elements(std::exchange(other.elements, nullptr)),
+      owner(std::move(other.owner)), num_rows(std::exchange(other.num_rows, 0)),
+      num_cols(std::exchange(other.num_cols, 0)) {}
+
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator=(const BasicMatrix& other) {
+    if (this != &other) {
+        storage.assign(other.data(), other.data() + other.size());
+        elements = storage.data();
+        owner.reset();
+        num_rows = other.num_rows;
+        num_cols = other.num_cols;
+    }
+
+    return *this;
+}
+
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator=(BasicMatrix&& other) noexcept {
+    if (this != &other) {
+        storage = std::move(other.storage);
+        other.storage.clear();
+        elements = std::exchange(other.elements, nullptr);
+        owner = std::move(other.owner);
+        num_rows = std::exchange(other.num_rows, 0);
+        num_cols = std::exchange(other.num_cols, 0);
+    }
+
+    return *this;
+}
+
+template<typename T>
+void BasicMatrix<T>::resize(std::size_t rows, std::size_t cols) {
+    if (borrowed() && rows == num_rows && cols == num_cols) {
+        return;
+    }
+    owner.reset();
+    storage.resize(rows * cols);
+    elements = storage.data();
+    num_rows = rows;
+    num_cols = cols;
+}
+
+template<typename T>
+void BasicMatrix<T>::fill(T value) {
+    std::fill(elements, elements + size(), value);
+}
+
+template class BasicMatrix<float>;
+template class BasicMatrix<double>;
@@ -1,16 +1,153 @@
 #include "neuralnet.hpp"
+#include "checkpoint.hpp"
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
 
-void NeuralNet::addLayer(std::shared_ptr<Layer> layer) {
+namespace {
+    // Smallest block of rows worth handing to another thread.
+    constexpr size_t MIN_ROWS_PER_TASK = 16;
+
+    // Blocks per worker in the pooled predict_batch, so stealing can rebalance.
+    constexpr size_t TASKS_PER_WORKER = 4;
+
+    // Per-thread ping-pong buffers for the pooled predict_batch, reused across calls.
+    template<typename T>
+    thread_local BasicMatrix<T> pool_scratch[2];
+
+    // Per-thread ping-pong buffers for the hidden activations of predict, reused across calls.
+    template<typename T>
+    thread_local std::vector<T> predict_scratch[2];
+}
+
+template<typename T>
+void BasicNeuralNet<T>::addLayer(std::shared_ptr<BasicLayer<T>> layer) {
     layers.push_back(layer);
+    if (arena) {
+        // New parameters go at the end, so a cloned optimizer's state still lines up.
+        BasicOptimizer<T>* optimizer = arena->getOptimizer();
+        arena = std::make_unique<BasicParameterArena<T>>(layers, optimizer ? optimizer->clone() : nullptr);
+    }
 }
 
-void NeuralNet::setLoss(std::shared_ptr<Loss> loss) {
+template<typename T>
+void BasicNeuralNet<T>::setLoss(std::shared_ptr<BasicLoss<T>> loss) {
     loss_function = loss;
 }
 
-std::vector<double> NeuralNet::predict(const std::vector<double>& input) {
-    std::vector<double> output = input;
+template<typename T>
+std::shared_ptr<BasicLoss<T>> BasicNeuralNet<T>::getLoss() const {
+    return loss_function;
+}
+
+template<typename T>
+void BasicNeuralNet<T>::setOptimizer(std::unique_ptr<BasicOptimizer<T>> optimizer) {
+    arena = std::make_unique<BasicParameterArena<T>>(layers, std::move(optimizer));
+}
+
+template<typename T>
+void BasicNeuralNet<T>::setGradientClipping(double max_norm) {
+    if (!(max_norm >= 0.0)) {
+        throw std::invalid_argument("Maximum gradient norm must not be negative");
+    }
+    max_gradient_norm = max_norm;
+}
+
+template<typename T>
+double BasicNeuralNet<T>::getGradientClipping() const {
+    return max_gradient_norm;
+}
+
+template<typename T>
+BasicParameterArena<T>* BasicNeuralNet<T>::getParameterArena() const {
+    return arena.get();
+}
+
+template<typename T>
+const std::vector<std::shared_ptr<BasicLayer<T>>>& BasicNeuralNet<T>::getLayers() const {
+    return layers;
+}
+
+template<typename T>
+std::vector<T> BasicNeuralNet<T>::predict(const std::vector<T>& input) const {
+    if (layers.empty()) {
+        return input;
+    }
+
+    // Only the returned vector is allocated; hidden activations live in reused scratch.
+    Span<const T> current(input);
+    for (size_t i = 0; i + 1 < layers.size(); ++i) {
+        std::vector<T>& next = predict_scratch<T>[i % 2];
+        next.resize(layers[i]->output_size(current.size()));
+        layers[i]->infer(current, next);
+        current = Span<const T>(next);
+    }
+    std::vector<T> output(layers.back()->output_size(current.size()));
+    layers.back()->infer(current, output);
+
+    return output;
+}
+
+template<typename T>
+size_t BasicNeuralNet<T>::output_size(size_t input_size) const {
+    for (const auto& layer : layers) {
+        input_size = layer->output_size(input_size);
+    }
+
+    return input_size;
+}
+
+template<typename T>
+void BasicNeuralNet<T>::infer_rows(BasicConstMatrixView<T> input, BasicMatrixView<T> output,
+                                   BasicMatrix<T>& ping, BasicMatrix<T>& pong) const {
+    if (layers.empty()) {
+        for (size_t r = 0; r < input.rows; ++r) {
+            std::copy(input.row(r), input.row(r) + input.cols, output.row(r));
+        }
+        return;
+    }
+
+    BasicMatrix<T>* buffers[2] = {&ping, &pong};
+    BasicConstMatrixView<T> current = input;
+    for (size_t i = 0; i + 1 < layers.size(); ++i) {
+        BasicMatrix<T>& next = *buffers[i % 2];
+        next.resize(input.rows, layers[i]->output_size(current.cols));
+        layers[i]->infer_batch(current, next.view());
+        current = next.view();
+    }
+    layers.back()->infer_batch(current, output);
+}
+
+template<typename T>
+BasicMatrix<T> BasicNeuralNet<T>::predict_batch(const BasicMatrix<T>& inputs) const {
+    BasicMatrix<T> outputs(inputs.rows(), output_size(inputs.cols()));
+    BasicMatrix<T> ping;
+    BasicMatrix<T> pong;
+    infer_rows(inputs.view(), outputs.view(), ping, pong);
+
+    return outputs;
+}
+
+template<typename T>
+void BasicNeuralNet<T>::predict_batch(const BasicMatrix<T>& inputs, BasicMatrix<T>& outputs, ThreadPool& pool) const {
+    if (&inputs == &outputs) {
+        throw std::invalid_argument("predict_batch outputs must not alias the inputs");
+    }
+    outputs.resize(inputs.rows(), output_size(inputs.cols()));
+
+    const size_t rows = inputs.rows();
+    const size_t tasks = pool.size() * TASKS_PER_WORKER;
+    const size_t grain = std::max(MIN_ROWS_PER_TASK, (rows + tasks - 1) / tasks);
+    pool.parallel_for(0, rows, grain, [&](size_t lo, size_t hi) {
+        BasicConstMatrixView<T> in(inputs.row(lo), hi - lo, inputs.cols(), inputs.stride());
+        BasicMatrixView<T> out{outputs.row(lo), hi - lo, outputs.cols(), outputs.stride()};
+        infer_rows(in, out, pool_scratch<T>[0], pool_scratch<T>[1]);
+    });
+}
+
+template<typename T>
+std::vector<T> BasicNeuralNet<T>::forward(const std::vector<T>& input) {
+    std::vector<T> output = input;
     for (auto& layer : layers) {
         output = layer->forward(output);
     }
@@ -18,42 +155,173 @@ std::vector<double> NeuralNet::predict(const std::vector<double>& input) {
     return output;
 }
 
-void NeuralNet::train(const std::vector<std::vector<double>>& inputs, const std::vector<std::vector<double>>& targets, int epochs, double learning_rate) {
-    for (int epoch = 0; epoch < epochs; ++epoch) {
-        double total_loss = 0.0;
-        for (size_t i = 0; i < inputs.size(); ++i) {
-            std::vector<double> output = predict(inputs[i]);
+template<typename T>
+BasicMatrix<T> BasicNeuralNet<T>::forward_batch(const BasicMatrix<T>& inputs) {
+    if (layers.empty()) {
+        return inputs;
+    }
+
+    // Starts from the first layer's output rather than a copy of the inputs, so that
+    // every intermediate comes from the layers (and the step arena, if one is active).
+    BasicMatrix<T> output = layers[0]->forward_batch(inputs);
+    for (size_t i = 1; i < layers.size(); ++i) {
+        output = layers[i]->forward_batch(output);
+    }
+
+    return output;
+}
 
-            double loss = loss_function->compute(output, targets[i]);
-            total_loss += loss;
+template<typename T>
+void BasicNeuralNet<T>::train(const std::vector<std::vector<T>>& inputs, const std::vector<std::vector<T>>& targets, int epochs, double learning_rate, size_t batch_size,
+                              size_t accumulation_steps, BasicCheckpointer<T>* checkpointer) {
+    if (batch_size == 0) {
+        throw std::invalid_argument("Batch size must be at least 1");
+    }
+    if (accumulation_steps == 0) {
+        throw std::invalid_argument("Accumulation steps must be at least 1");
+    }
+    if (inputs.size() != targets.size()) {
+        throw std::invalid_argument("Inputs and targets must have the same number of samples");
+    }
+
+    const int first_epoch = checkpointer != nullptr ? checkpointer->getEpoch() : 0;
+    auto end_epoch = [&](int epoch) {
+        const int completed = epoch + 1;
+        if (checkpointer != nullptr && (completed % checkpointer->getInterval() == 0 || completed == epochs)) {
+            checkpointer->save(*this, completed);
+        }
+    };
+
+    const bool deferred = arena || accumulation_steps > 1;
+    if (batch_size == 1 && !deferred) {
+        for (int epoch = first_epoch; epoch < epochs; ++epoch) {
+            double total_loss = 0.0;
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                std::vector<T> output = forward(inputs[i]);
+
+                double loss = loss_function->compute(output, targets[i]);
+                total_loss += loss;
+                
+                std::vector<T> grad = loss_function->gradient(output, targets[i]);
+                for (int j = layers.size() - 1; j >= 0; --j) {
+                    grad = layers[j]->backward(grad, learning_rate);
+                }
+            }
             
-            std::vector<double> grad = loss_function->gradient(output, targets[i]);
-            for (int j = layers.size() - 1; j >= 0; --j) {
-                grad = layers[j]->backward(grad, learning_rate);
+            if (epoch % 1000 == 0) {
+                std::cout << "Epoch " << epoch << ", Average Loss: " << total_loss / inputs.size() << std::endl;
             }
+            end_epoch(epoch);
         }
-        
+        return;
+    }
+
+    if (inputs.empty()) {
+        return;
+    }
+
+    const size_t input_size = inputs[0].size();
+    const size_t target_size = targets[0].size();
+    BasicMatrix<T> batch_inputs;
+    BasicMatrix<T> batch_targets;
+
+    // Without an arena, deferred steps accumulate into one buffer per layer.
+    std::vector<std::vector<T>> layer_gradients;
+    if (deferred && !arena) {
+        for (const auto& layer : layers) {
+            layer_gradients.emplace_back(layer->parameter_count());
+        }
+    }
+    auto gradients_of = [&](size_t j) {
+        return arena ? arena->layerGradients(j) : Span<T>(layer_gradients[j]);
+    };
+
+    const size_t group_size = batch_size * accumulation_steps;
+    for (int epoch = first_epoch; epoch < epochs; ++epoch) {
+        double total_loss = 0.0;
+        for (size_t group = 0; group < inputs.size(); group += group_size) {
+            const size_t group_rows = std::min(group_size, inputs.size() - group);
+            const size_t group_end = group + group_rows;
+            for (size_t start = group; start < group_end; start += batch_size) {
+                // Nothing from the previous mini-batch is alive any more: its gradients
+                // are in the layer or arena buffers and the matrices went out of scope.
+                step_arena.reset();
+                StepArena::Scope scope(step_arena);
+                const size_t rows = std::min(batch_size, group_end - start);
+                batch_inputs.resize(rows, input_size);
+                batch_targets.resize(rows, target_size);
+                for (size_t r = 0; r < rows; ++r) {
+                    if (inputs[start + r].size() != input_size || targets[start + r].size() != target_size) {
+                        throw std::invalid_argument("All samples in a batch must have the same size");
+                    }
+                    std::copy(inputs[start + r].begin(), inputs[start + r].end(), batch_inputs.row(r));
+                    std::copy(targets[start + r].begin(), targets[start + r].end(), batch_targets.row(r));
+                }
+
+                BasicMatrix<T> output = forward_batch(batch_inputs);
+
+                double loss = loss_function->compute_batch(output, batch_targets);
+                total_loss += loss * rows;
+
+                BasicMatrix<T> grad = loss_function->gradient_batch(output, batch_targets);
+                if (!deferred) {
+                    for (int j = layers.size() - 1; j >= 0; --j) {
+                        grad = layers[j]->backward_batch(grad, learning_rate);
+                    }
+                    continue;
+                }
+
+                // Weight each mini-batch by its share of the group, so the summed gradient
+                // is that of the loss averaged over the whole group.
+                if (rows != group_rows) {
+                    const T share = static_cast<T>((double)rows / (double)group_rows);
+                    T* g = grad.data();
+                    for (size_t k = 0; k < grad.size(); ++k) {
+                        g[k] *= share;
+                    }
+                }
+                const bool first = start == group;
+                for (int j = layers.size() - 1; j >= 0; --j) {
+                    grad = first ? layers[j]->compute_gradients(grad, gradients_of(j))
+                                 : layers[j]->accumulate_gradients(grad, gradients_of(j));
+                }
+            }
+
+            if (arena) {
+                if (max_gradient_norm > 0.0) {
+                    arena->clip_gradients(max_gradient_norm);
+                }
+                arena->step(learning_rate);
+            } else if (deferred) {
+                for (size_t j = 0; j < layers.size(); ++j) {
+                    layers[j]->apply_gradients(layer_gradients[j], learning_rate);
+                }
+            }
+        }
+
         if (epoch % 1000 == 0) {
             std::cout << "Epoch " << epoch << ", Average Loss: " << total_loss / inputs.size() << std::endl;
         }
+        end_epoch(epoch);
     }
 }
 
-NeuralNet::NeuralNet(const NeuralNet& other) {
+template<typename T>
+BasicNeuralNet<T>::BasicNeuralNet(const BasicNeuralNet& other) {
     for (const auto& layer : other.layers) {
-        layers.push_back(std::shared_ptr<Layer>(layer->clone()));
+        layers.push_back(std::shared_ptr<BasicLayer<T>>(layer->clone()));
     }
     if (other.loss_function) {
-        loss_function = std::shared_ptr<Loss>(other.loss_function->clone());
+        loss_function = std::shared_ptr<BasicLoss<T>>(other.loss_function->clone());
     } else {
         loss_function = nullptr;
     }
+    if (other.arena) {
+        BasicOptimizer<T>* optimizer = other.arena->getOptimizer();
+        arena = std::make_unique<BasicParameterArena<T>>(layers, optimizer ? optimizer->clone() : nullptr);
+    }
+    max_gradient_norm = other.max_gradient_norm;
 }
 
-void NeuralNet::save(const std::string& filename) const {
-    // Not implemented in this example
-}
-
-void NeuralNet::load(const std::string& filename) {
-    // Not implemented in this example
-}
\ No newline at end of file
+template class BasicNeuralNet<float>;
+template class BasicNeuralNet<double>;
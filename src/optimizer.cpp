@@ -1,51 +1,126 @@
 #include "optimizer.hpp"
-#include <cmath>
 #include <algorithm>
+#include <stdexcept>
 
-SGD::SGD(double lr, double mom) 
+namespace {
+    void check_slice(size_t weights_size, size_t gradients_size, size_t offset, size_t state_size) {
+        if (weights_size != gradients_size) {
+            throw std::invalid_argument("Weights and gradients must have the same size");
+        }
+        if (offset + weights_size > state_size) {
+            throw std::invalid_argument("Slice exceeds the parameter block passed to begin_step");
+        }
+    }
+}
+
+template<typename T>
+void BasicOptimizer<T>::update(Span<T> weights, Span<const T> gradients) {
+    if (weights.size() != gradients.size()) {
+        throw std::invalid_argument("Weights and gradients must have the same size");
+    }
+
+    begin_step(weights.size());
+    update_slice(weights, gradients, 0);
+}
+
+template<typename T>
+BasicSGD<T>::BasicSGD(double lr, double mom) 
     : learning_rate(lr), momentum(mom) {}
 
-void SGD::update(std::vector<double>& weights, const std::vector<double>& gradients) {
-    if (velocity.size() != weights.size()) {
-        velocity.resize(weights.size(), 0.0);
+template<typename T>
+void BasicSGD<T>::begin_step(size_t size) {
+    if (velocity.size() != size) {
+        velocity.resize(size, T(0));
     }
-    
+}
+
+template<typename T>
+void BasicSGD<T>::update_slice(Span<T> weights, Span<const T> gradients, size_t offset) {
+    check_slice(weights.size(), gradients.size(), offset, velocity.size());
+
+    const T mom = static_cast<T>(momentum);
+    const T lr = static_cast<T>(learning_rate);
+    T* vel = velocity.data() + offset;
     for (size_t i = 0; i < weights.size(); ++i) {
-        velocity[i] = momentum * velocity[i] - learning_rate * gradients[i];
-        weights[i] += velocity[i];
+        vel[i] = mom * vel[i] - lr * gradients[i];
+        weights[i] += vel[i];
     }
 }
 
-std::unique_ptr<Optimizer> SGD::clone() const {
-    auto cloned = std::make_unique<SGD>(learning_rate, momentum);
+template<typename T>
+std::unique_ptr<BasicOptimizer<T>> BasicSGD<T>::clone() const {
+    auto cloned = std::make_unique<BasicSGD<T>>(learning_rate, momentum);
     cloned->velocity = velocity;
     return cloned;
 }
 
-Adam::Adam(double lr, double b1, double b2, double eps)
-    : learning_rate(lr), beta1(b1), beta2(b2), epsilon(eps), t(0) {}
+template<typename T>
+BasicOptimizerState<T> BasicSGD<T>::getState() const {
+    BasicOptimizerState<T> state;
+    state.buffers.push_back(velocity);
+    return state;
+}
 
-void Adam::update(std::vector<double>& weights, const std::vector<double>& gradients) {
-    if (m.size() != weights.size()) {
-        m.resize(weights.size(), 0.0);
-        v.resize(weights.size(), 0.0);
+template<typename T>
+void BasicSGD<T>::setState(const BasicOptimizerState<T>& state) {
+    if (state.buffers.size() != 1) {
+        throw std::invalid_argument("SGD state must have exactly one buffer");
+    }
+    velocity = state.buffers[0];
+}
+
+template<typename T>
+BasicAdam<T>::BasicAdam(double lr, double b1, double b2, double eps, double wd)
+    : learning_rate(lr), beta1(b1), beta2(b2), epsilon(eps), weight_decay(wd), t(0), coefficients() {}
+
+template<typename T>
+void BasicAdam<T>::begin_step(size_t size) {
+    if (m.size() != size) {
+        m.resize(size, T(0));
+        v.resize(size, T(0));
     }
     
     t++;
-    
-    for (size_t i = 0; i < weights.size(); ++i) {
-        m[i] = beta1 * m[i] + (1.0 - beta1) * gradients[i];
-        
-        v[i] = beta2 * v[i] + (1.0 - beta2) * gradients[i] * gradients[i];
-        
-        double m_hat = m[i] / (1.0 - std::pow(beta1, t));
-        
-        double v_hat = v[i] / (1.0 - std::pow(beta2, t));
-        
-        weights[i] -= learning_rate * m_hat / (std::sqrt(v_hat) + epsilon);
-    }
+    coefficients = Simd::adam_coefficients(learning_rate, beta1, beta2, epsilon, weight_decay, t);
+}
+
+template<typename T>
+void BasicAdam<T>::update_slice(Span<T> weights, Span<const T> gradients, size_t offset) {
+    check_slice(weights.size(), gradients.size(), offset, m.size());
+
+    Simd::adam(weights.data(), gradients.data(), m.data() + offset, v.data() + offset, weights.size(), coefficients);
 }
 
-std::unique_ptr<Optimizer> Adam::clone() const {
-    return std::make_unique<Adam>(*this);
+template<typename T>
+std::unique_ptr<BasicOptimizer<T>> BasicAdam<T>::clone() const {
+    return std::make_unique<BasicAdam<T>>(*this);
 }
+
+template<typename T>
+BasicOptimizerState<T> BasicAdam<T>::getState() const {
+    BasicOptimizerState<T> state;
+    state.buffers.push_back(m);
+    state.buffers.push_back(v);
+    state.step = t;
+    return state;
+}
+
+template<typename T>
+void BasicAdam<T>::setState(const BasicOptimizerState<T>& state) {
+    if (state.buffers.size() != 2 || state.buffers[0].size() != state.buffers[1].size()) {
+        throw std::invalid_argument("Adam state must have two buffers of equal size");
+    }
+    if (state.step < 0) {
+        throw std::invalid_argument("Adam timestep must not be negative");
+    }
+    m = state.buffers[0];
+    v = state.buffers[1];
+    t = state.step;
+}
+
+template class BasicOptimizer<float>;
+template class BasicOptimizer<double>;
+template class BasicSGD<float>;
+template class BasicSGD<double>;
+template class BasicAdam<float>;
+template class BasicAdam<double>;
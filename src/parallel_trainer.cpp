@@ -0,0 +1,188 @@
+#include "parallel_trainer.hpp"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+    // Elements per task in the gradient reduction, so even the last tree level is
+    // spread over the pool.
+    constexpr size_t REDUCE_CHUNK = 4096;
+}
+
+ParallelTrainer::ParallelTrainer(NeuralNet& model, ThreadPool& pool, size_t num_shards) : model(model), pool(pool) {
+    if (!model.getLoss()) {
+        throw std::invalid_argument("ParallelTrainer needs a network with a loss function");
+    }
+    if (num_shards == 0) {
+        num_shards = pool.size();
+    }
+
+    offsets.push_back(0);
+    for (const auto& layer : model.getLayers()) {
+        offsets.push_back(offsets.back() + layer->parameter_count());
+    }
+
+    // Replicas only compute gradients, so they are built from layer clones without the
+    // model's parameter arena and its optimizer state.
+    replicas.resize(num_shards);
+    for (NeuralNet& replica : replicas) {
+        for (const auto& layer : model.getLayers()) {
+            replica.addLayer(std::shared_ptr<Layer>(layer->clone()));
+        }
+        replica.setLoss(std::shared_ptr<Loss>(model.getLoss()->clone()));
+    }
+    gradients.assign(num_shards, std::vector<double>(offsets.back()));
+    shard_inputs.resize(num_shards);
+    shard_targets.resize(num_shards);
+    shard_losses.assign(num_shards, 0.0);
+}
+
+size_t ParallelTrainer::shard_count() const {
+    return replicas.size();
+}
+
+void ParallelTrainer::run_shard(size_t shard, const Matrix& inputs, const Matrix& targets) {
+    const auto& layers = replicas[shard].getLayers();
+    const auto& master = model.getLayers();
+    for (size_t j = 0; j < layers.size(); ++j) {
+        layers[j]->copy_parameters_from(*master[j]);
+    }
+
+    const size_t batch = inputs.rows();
+    const size_t lo = shard * batch / replicas.size();
+    const size_t hi = (shard + 1) * batch / replicas.size();
+    std::vector<double>& grads = gradients[shard];
+    if (lo == hi) {
+        std::fill(grads.begin(), grads.end(), 0.0);
+        shard_losses[shard] = 0.0;
+        return;
+    }
+
+    Matrix& x = shard_inputs[shard];
+    Matrix& t = shard_targets[shard];
+    x.resize(hi - lo, inputs.cols());
+    t.resize(hi - lo, targets.cols());
+    std::copy(inputs.row(lo), inputs.row(lo) + x.size(), x.data());
+    std::copy(targets.row(lo), targets.row(lo) + t.size(), t.data());
+
+    Matrix output = x;
+    for (const auto& layer : layers) {
+        output = layer->forward_batch(output);
+    }
+
+    Loss& loss = *replicas[shard].getLoss();
+    shard_losses[shard] = loss.compute_batch(output, t) * (double)(hi - lo);
+
+    // gradient_batch averages over this shard; rescale so the shards sum to the full-batch mean
+    Matrix grad = loss.gradient_batch(output, t);
+    const double scale = (double)(hi - lo) / (double)batch;
+    for (size_t k = 0; k < grad.size(); ++k) {
+        grad.data()[k] *= scale;
+    }
+
+    for (size_t j = layers.size(); j-- > 0;) {
+        grad = layers[j]->compute_gradients(grad, Span<double>(grads.data() + offsets[j], offsets[j + 1] - offsets[j]));
+    }
+}
+
+void ParallelTrainer::reduce_gradients() {
+    const size_t shards = gradients.size();
+    const size_t n = offsets.back();
+    const size_t chunks = (n + REDUCE_CHUNK - 1) / REDUCE_CHUNK;
+
+    // Level by level, buffer r absorbs buffer r + stride, so every element is summed
+    // in the same order on every run.
+    for (size_t stride = 1; stride < shards; stride *= 2) {
+        const size_t pairs = (shards - stride + 2 * stride - 1) / (2 * stride);
+        pool.parallel_for(0, pairs * chunks, 1, [&](size_t lo, size_t hi) {
+            for (size_t task = lo; task < hi; ++task) {
+                const size_t r = (task / chunks) * 2 * stride;
+                const size_t begin = (task % chunks) * REDUCE_CHUNK;
+                const size_t end = std::min(n, begin + REDUCE_CHUNK);
+                double* dst = gradients[r].data();
+                const double* src = gradients[r + stride].data();
+                for (size_t k = begin; k < end; ++k) {
+                    dst[k] += src[k];
+                }
+            }
+        });
+    }
+}
+
+double ParallelTrainer::train_batch(const Matrix& inputs, const Matrix& targets, double learning_rate) {
+    if (inputs.rows() != targets.rows()) {
+        throw std::invalid_argument("Inputs and targets must have the same number of rows");
+    }
+    if (inputs.rows() == 0) {
+        return 0.0;
+    }
+
+    pool.parallel_for(0, replicas.size(), 1, [&](size_t lo, size_t hi) {
+        for (size_t s = lo; s < hi; ++s) {
+            run_shard(s, inputs, targets);
+        }
+    });
+    reduce_gradients();
+
+    // The arena lays the layers out in the same order as the gradient buffers.
+    if (ParameterArena* arena = model.getParameterArena()) {
+        std::copy(gradients[0].begin(), gradients[0].end(), arena->getGradients().begin());
+        if (model.getGradientClipping() > 0.0) {
+            arena->clip_gradients(model.getGradientClipping());
+        }
+        arena->step(learning_rate);
+    } else {
+        const auto& layers = model.getLayers();
+        for (size_t j = 0; j < layers.size(); ++j) {
+            layers[j]->apply_gradients(Span<const double>(gradients[0].data() + offsets[j], offsets[j + 1] - offsets[j]),
+                                       learning_rate);
+        }
+    }
+
+    double total = 0.0;
+    for (double loss : shard_losses) {
+        total += loss;
+    }
+
+    return total / (double)inputs.rows();
+}
+
+void ParallelTrainer::train(const std::vector<std::vector<double>>& inputs, const std::vector<std::vector<double>>& targets,
+                            int epochs, double learning_rate, size_t batch_size) {
+    if (batch_size == 0) {
+        throw std::invalid_argument("Batch size must be at least 1");
+    }
+    if (inputs.size() != targets.size()) {
+        throw std::invalid_argument("Inputs and targets must have the same number of samples");
+    }
+    if (inputs.empty()) {
+        return;
+    }
+
+    const size_t input_size = inputs[0].size();
+    const size_t target_size = targets[0].size();
+    Matrix batch_inputs;
+    Matrix batch_targets;
+
+    for (int epoch = 0; epoch < epochs; ++epoch) {
+        double total_loss = 0.0;
+        for (size_t start = 0; start < inputs.size(); start += batch_size) {
+            const size_t rows = std::min(batch_size, inputs.size() - start);
+            batch_inputs.resize(rows, input_size);
+            batch_targets.resize(rows, target_size);
+            for (size_t r = 0; r < rows; ++r) {
+                if (inputs[start + r].size() != input_size || targets[start + r].size() != target_size) {
+                    throw std::invalid_argument("All samples in a batch must have the same size");
+                }
+                std::copy(inputs[start + r].begin(), inputs[start + r].end(), batch_inputs.row(r));
+                std::copy(targets[start + r].begin(), targets[start + r].end(), batch_targets.row(r));
+            }
+
+            total_loss += train_batch(batch_inputs, batch_targets, learning_rate) * rows;
+        }
+
+        if (epoch % 1000 == 0) {
+            std::cout << "Epoch " << epoch << ", Average Loss: " << total_loss / inputs.size() << std::endl;
+        }
+    }
+}
@@ -0,0 +1,100 @@
+#include "parameter_arena.hpp"
+#include <cmath>
+#include <stdexcept>
+
+template<typename T>
+BasicParameterArena<T>::BasicParameterArena(const std::vector<std::shared_ptr<BasicLayer<T>>>& layers,
+                                            std::unique_ptr<BasicOptimizer<T>> optimizer)
+    : optimizer(std::move(optimizer)) {
+    offsets.reserve(layers.size() + 1);
+    size_t total = 0;
+    for (const auto& layer : layers) {
+        offsets.push_back(total);
+        total += layer->parameter_count();
+    }
+    offsets.push_back(total);
+
+    parameters = std::make_shared<std::vector<T, AlignedAllocator<T>>>(total);
+    gradients.assign(total, T(0));
+    for (size_t l = 0; l < layers.size(); ++l) {
+        Span<T> slice(parameters->data() + offsets[l], offsets[l + 1] - offsets[l]);
+        layers[l]->bind_parameters(slice, parameters);
+    }
+}
+
+template<typename T>
+size_t BasicParameterArena<T>::size() const {
+    return parameters->size();
+}
+
+template<typename T>
+Span<T> BasicParameterArena<T>::getParameters() {
+    return Span<T>(parameters->data(), parameters->size());
+}
+
+template<typename T>
+Span<const T> BasicParameterArena<T>::getParameters() const {
+    return Span<const T>(parameters->data(), parameters->size());
+}
+
+template<typename T>
+Span<T> BasicParameterArena<T>::getGradients() {
+    return Span<T>(gradients.data(), gradients.size());
+}
+
+template<typename T>
+Span<const T> BasicParameterArena<T>::getGradients() const {
+    return Span<const T>(gradients.data(), gradients.size());
+}
+
+template<typename T>
+Span<T> BasicParameterArena<T>::layerGradients(size_t layer) {
+    if (layer + 1 >= offsets.size()) {
+        throw std::out_of_range("Layer index out of range");
+    }
+
+    return Span<T>(gradients.data() + offsets[layer], offsets[layer + 1] - offsets[layer]);
+}
+
+template<typename T>
+BasicOptimizer<T>* BasicParameterArena<T>::getOptimizer() const {
+    return optimizer.get();
+}
+
+template<typename T>
+double BasicParameterArena<T>::clip_gradients(double max_norm) {
+    if (!(max_norm > 0.0)) {
+        throw std::invalid_argument("Maximum gradient norm must be positive");
+    }
+
+    double sum = 0.0;
+    for (T g : gradients) {
+        sum += (double)g * g;
+    }
+    const double norm = std::sqrt(sum);
+    if (norm > max_norm) {
+        const T scale = static_cast<T>(max_norm / norm);
+        for (T& g : gradients) {
+            g *= scale;
+        }
+    }
+
+    return norm;
+}
+
+template<typename T>
+void BasicParameterArena<T>::step(double learning_rate) {
+    if (optimizer) {
+        optimizer->update(getParameters(), getGradients());
+        return;
+    }
+
+    const T lr = static_cast<T>(learning_rate);
+    T* w = parameters->data();
+    for (size_t k = 0; k < gradients.size(); ++k) {
+        w[k] -= lr * gradients[k];
+    }
+}
+
+template class BasicParameterArena<float>;
+template class BasicParameterArena<double>;
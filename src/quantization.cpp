@@ -0,0 +1,69 @@
+#include "quantization.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Quantization {
+    namespace {
+        template<typename T>
+        std::vector<double> calibrate_impl(const BasicNeuralNet<T>& net, const BasicMatrix<T>& calibration_inputs) {
+            std::vector<double> ranges;
+            BasicMatrix<T> current = calibration_inputs;
+            BasicMatrix<T> next;
+            for (const auto& layer : net.getLayers()) {
+                double range = 0.0;
+                const T* x = current.data();
+                for (size_t k = 0; k < current.size(); ++k) {
+                    range = std::max(range, (double)std::fabs(x[k]));
+                }
+                ranges.push_back(range);
+
+                next.resize(current.rows(), layer->output_size(current.cols()));
+                layer->infer_batch(current.view(), next.view());
+                std::swap(current, next);
+            }
+
+            return ranges;
+        }
+
+        template<typename T>
+        BasicNeuralNet<T> quantize_impl(const BasicNeuralNet<T>& net, const BasicMatrix<T>& calibration_inputs) {
+            if (calibration_inputs.empty()) {
+                throw std::invalid_argument("Calibration needs at least one sample");
+            }
+
+            const std::vector<double> ranges = calibrate_impl(net, calibration_inputs);
+            const auto& layers = net.getLayers();
+            BasicNeuralNet<T> quantized;
+            for (size_t l = 0; l < layers.size(); ++l) {
+                const BasicDense<T>* dense = dynamic_cast<const BasicDense<T>*>(layers[l].get());
+                if (dense != nullptr) {
+                    quantized.addLayer(std::make_shared<BasicQuantizedDense<T>>(*dense, static_cast<T>(ranges[l])));
+                } else {
+                    quantized.addLayer(std::shared_ptr<BasicLayer<T>>(layers[l]->clone()));
+                }
+            }
+            if (net.getLoss()) {
+                quantized.setLoss(std::shared_ptr<BasicLoss<T>>(net.getLoss()->clone()));
+            }
+
+            return quantized;
+        }
+    }
+
+    std::vector<double> calibrate(const NeuralNet& net, const Matrix& calibration_inputs) {
+        return calibrate_impl(net, calibration_inputs);
+    }
+
+    std::vector<double> calibrate(const NeuralNetF& net, const MatrixF& calibration_inputs) {
+        return calibrate_impl(net, calibration_inputs);
+    }
+
+    NeuralNet quantize(const NeuralNet& net, const Matrix& calibration_inputs) {
+        return quantize_impl(net, calibration_inputs);
+    }
+
+    NeuralNetF quantize(const NeuralNetF& net, const MatrixF& calibration_inputs) {
+        return quantize_impl(net, calibration_inputs);
+    }
+}
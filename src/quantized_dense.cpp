@@ -0,0 +1,205 @@
+#include "quantized_dense.hpp"
+#include "gemm.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    // Largest quantized magnitude; -128 is left unused so the range is symmetric.
+    constexpr int QMAX = 127;
+
+    // Per-thread scratch for the quantized inputs and int32 products, reused across calls.
+    thread_local std::vector<std::int8_t, AlignedAllocator<std::int8_t>> quantized_scratch;
+    thread_local std::vector<std::int32_t, AlignedAllocator<std::int32_t>> product_scratch;
+
+    // Scale that maps [-range, range] onto [-QMAX, QMAX]; an all-zero range maps to 1.
+    double scale_for(double range) {
+        return range > 0.0 ? range / QMAX : 1.0;
+    }
+
+    template<typename T>
+    std::int8_t quantize(T x, T inv_scale) {
+        const T q = std::nearbyint(x * inv_scale);
+        return (std::int8_t)std::max<T>(-QMAX, std::min<T>(QMAX, q));
+    }
+}
+
+template<typename T>
+BasicQuantizedDense<T>::BasicQuantizedDense(const BasicDense<T>& dense, T input_range)
+    : num_inputs(dense.getWeights().cols()), num_outputs(dense.getWeights().rows()),
+      weights(num_inputs * num_outputs), weight_scales(num_outputs), output_scales(num_outputs),
+      biases(dense.getBiases().begin(), dense.getBiases().end()), input_scale(static_cast<T>(scale_for(input_range))) {
+    if (!(input_range >= T(0)) || !std::isfinite(input_range)) {
+        throw std::invalid_argument("Input range must be finite and non-negative");
+    }
+
+    const BasicMatrix<T>& w = dense.getWeights();
+    for (size_t i = 0; i < num_outputs; ++i) {
+        const T* row = w.row(i);
+        T range = T(0);
+        for (size_t j = 0; j < num_inputs; ++j) {
+            range = std::max(range, std::fabs(row[j]));
+        }
+
+        weight_scales[i] = static_cast<T>(scale_for(range));
+        output_scales[i] = input_scale * weight_scales[i];
+        const T inv_scale = T(1) / weight_scales[i];
+        std::int8_t* q = weights.data() + i * num_inputs;
+        for (size_t j = 0; j < num_inputs; ++j) {
+            q[j] = quantize(row[j], inv_scale);
+        }
+    }
+}
+
+template<typename T>
+const std::vector<std::int8_t, AlignedAllocator<std::int8_t>>& BasicQuantizedDense<T>::getWeights() const {
+    return weights;
+}
+
+template<typename T>
+const std::vector<T>& BasicQuantizedDense<T>::getWeightScales() const {
+    return weight_scales;
+}
+
+template<typename T>
+T BasicQuantizedDense<T>::getInputScale() const {
+    return input_scale;
+}
+
+template<typename T>
+const std::vector<T>& BasicQuantizedDense<T>::getBiases() const {
+    return biases;
+}
+
+template<typename T>
+void BasicQuantizedDense<T>::run(BasicConstMatrixView<T> input, BasicMatrixView<T> output) const {
+    const size_t rows = input.rows;
+    quantized_scratch.resize(rows * num_inputs);
+    product_scratch.resize(rows * num_outputs);
+
+    const T inv_scale = T(1) / input_scale;
+    for (size_t r = 0; r < rows; ++r) {
+        const T* x = input.row(r);
+        std::int8_t* q = quantized_scratch.data() + r * num_inputs;
+        for (size_t j = 0; j < num_inputs; ++j) {
+            q[j] = quantize(x[j], inv_scale);
+        }
+    }
+
+    Gemm::gemm_s8(rows, num_outputs, num_inputs, quantized_scratch.data(), num_inputs, weights.data(), num_inputs,
+                  product_scratch.data(), num_outputs);
+
+    for (size_t r = 0; r < rows; ++r) {
+        const std::int32_t* acc = product_scratch.data() + r * num_outputs;
+        T* y = output.row(r);
+        for (size_t i = 0; i < num_outputs; ++i) {
+            y[i] = (T)acc[i] * output_scales[i] + biases[i];
+        }
+    }
+}
+
+template<typename T>
+std::vector<T> BasicQuantizedDense<T>::forward(const std::vector<T>& input) {
+    std::vector<T> output(output_size(input.size()));
+    infer(input, output);
+
+    return output;
+}
+
+template<typename T>
+std::vector<T> BasicQuantizedDense<T>::backward(const std::vector<T>&, double) {
+    throw std::runtime_error("QuantizedDense layers are inference-only");
+}
+
+template<typename T>
+BasicMatrix<T> BasicQuantizedDense<T>::forward_batch(const BasicMatrix<T>& input) {
+    BasicMatrix<T> output(input.rows(), num_outputs);
+    infer_batch(input.view(), output.view());
+
+    return output;
+}
+
+template<typename T>
+BasicMatrix<T> BasicQuantizedDense<T>::backward_batch(const BasicMatrix<T>&, double) {
+    throw std::runtime_error("QuantizedDense layers are inference-only");
+}
+
+template<typename T>
+void BasicQuantizedDense<T>::forward_hogwild(Span<const T> input, Span<T> output) const {
+    infer(input, output);
+}
+
+template<typename T>
+void BasicQuantizedDense<T>::backward_hogwild(Span<const T>, Span<const T>, Span<T>, double) {
+    throw std::runtime_error("QuantizedDense layers are inference-only");
+}
+
+template<typename T>
+size_t BasicQuantizedDense<T>::parameter_count() const {
+    return 0;
+}
+
+template<typename T>
+BasicMatrix<T> BasicQuantizedDense<T>::compute_gradients(const BasicMatrix<T>&, Span<T>) {
+    throw std::runtime_error("QuantizedDense layers are inference-only");
+}
+
+template<typename T>
+BasicMatrix<T> BasicQuantizedDense<T>::accumulate_gradients(const BasicMatrix<T>&, Span<T>) {
+    throw std::runtime_error("QuantizedDense layers are inference-only");
+}
+
+template<typename T>
+void BasicQuantizedDense<T>::apply_gradients(Span<const T>, double) {
+}
+
+template<typename T>
+void BasicQuantizedDense<T>::copy_parameters_from(const BasicLayer<T>& source) {
+    const BasicQuantizedDense<T>* other = dynamic_cast<const BasicQuantizedDense<T>*>(&source);
+    if (other == nullptr) {
+        throw std::invalid_argument("Can only copy parameters from another QuantizedDense layer");
+    }
+    if (other->num_inputs != num_inputs || other->num_outputs != num_outputs) {
+        throw std::invalid_argument("QuantizedDense layer shape does not match");
+    }
+    *this = *other;
+}
+
+template<typename T>
+size_t BasicQuantizedDense<T>::output_size(size_t input_size) const {
+    if (input_size != num_inputs) {
+        throw std::invalid_argument("Input size does not match the layer input size");
+    }
+
+    return num_outputs;
+}
+
+template<typename T>
+void BasicQuantizedDense<T>::infer(Span<const T> input, Span<T> output) const {
+    run(BasicConstMatrixView<T>(input.data(), 1, num_inputs, num_inputs),
+        BasicMatrixView<T>{output.data(), 1, num_outputs, num_outputs});
+}
+
+template<typename T>
+void BasicQuantizedDense<T>::infer_batch(BasicConstMatrixView<T> input, BasicMatrixView<T> output) const {
+    if (input.cols != num_inputs || output.cols != num_outputs || output.rows != input.rows) {
+        throw std::invalid_argument("Batch shapes do not match the layer");
+    }
+
+    run(input, output);
+}
+
+template<typename T>
+void BasicQuantizedDense<T>::bind_parameters(Span<T> storage, std::shared_ptr<void>) {
+    if (!storage.empty()) {
+        throw std::invalid_argument("QuantizedDense layers have no parameters to bind");
+    }
+}
+
+template<typename T>
+std::unique_ptr<BasicLayer<T>> BasicQuantizedDense<T>::clone() const {
+    return std::make_unique<BasicQuantizedDense<T>>(*this);
+}
+
+template class BasicQuantizedDense<float>;
+template class BasicQuantizedDense<double>;
@@ -1,40 +1,183 @@
 #include "replay_buffer.hpp"
 #include <stdexcept>
 #include <algorithm>
+#include <limits>
+
+namespace {
+    // Marks an empty entry of the drawn-slot set.
+    constexpr size_t NO_SLOT = std::numeric_limits<size_t>::max();
+}
 
 ReplayBuffer::ReplayBuffer(size_t capacity)
-    : capacity(capacity), position(0), current_size(0), gen(std::random_device{}()) {
-    memory.reserve(capacity);
+    : capacity(capacity), state_size(0), position(0), current_size(0), sampling(SamplingMode::WithoutReplacement),
+      gen(std::random_device{}()) {
+    if (capacity == 0) {
+        throw std::invalid_argument("Replay buffer capacity must be at least 1");
+    }
+}
+
+ReplayBuffer::ReplayBuffer(size_t capacity, size_t state_size) : ReplayBuffer(capacity) {
+    if (state_size == 0) {
+        throw std::invalid_argument("Replay buffer state size must be at least 1");
+    }
+    allocate(state_size);
 }
 
-void ReplayBuffer::push(const Experience& experience) {
+void ReplayBuffer::allocate(size_t size) {
+    state_size = size;
+    states.resize(capacity, state_size);
+    next_states.resize(capacity, state_size);
+    actions.resize(capacity);
+    rewards.resize(capacity);
+    dones.resize(capacity);
+}
+
+size_t ReplayBuffer::push(const Experience& experience) {
+    return push(experience.state, experience.action, experience.reward, experience.next_state, experience.done);
+}
+
+size_t ReplayBuffer::push(Span<const double> state, int action, double reward, Span<const double> next_state, bool done) {
+    if (state_size == 0) {
+        if (state.empty()) {
+            throw std::invalid_argument("Experience states must not be empty");
+        }
+        allocate(state.size());
+    }
+    if (state.size() != state_size || next_state.size() != state_size) {
+        throw std::invalid_argument("Experience state size does not match the replay buffer");
+    }
+
+    std::copy(state.begin(), state.end(), states.row(position));
+    std::copy(next_state.begin(), next_state.end(), next_states.row(position));
+    actions[position] = action;
+    rewards[position] = reward;
+    dones[position] = done ? 1 : 0;
+
+    const size_t slot = position;
+    position = (position + 1) % capacity;
     if (current_size < capacity) {
-        memory.push_back(experience);
         current_size++;
-    } else {
-        memory[position] = experience;
     }
-    position = (position + 1) % capacity;
+
+    return slot;
 }
 
-std::vector<Experience> ReplayBuffer::sample(size_t batch_size) {
+void ReplayBuffer::draw_indices(size_t batch_size, std::vector<size_t>& indices) {
     if (current_size < batch_size) {
         throw std::runtime_error("Not enough experiences in memory to sample a batch.");
     }
 
+    indices.clear();
+    if (sampling == SamplingMode::Scan) {
+        // Selection sampling: keep each slot with probability (still needed) / (still left).
+        for (size_t i = 0; i < current_size && indices.size() < batch_size; ++i) {
+            std::uniform_int_distribution<size_t> dist(0, current_size - i - 1);
+            if (dist(gen) < batch_size - indices.size()) {
+                indices.push_back(i);
+            }
+        }
+    } else if (sampling == SamplingMode::WithReplacement) {
+        std::uniform_int_distribution<size_t> dist(0, current_size - 1);
+        for (size_t k = 0; k < batch_size; ++k) {
+            indices.push_back(dist(gen));
+        }
+    } else {
+        // Floyd's algorithm: for j = n - k .. n - 1 draw t from [0, j] and take t, or j if t
+        // was already taken. Every k-subset is equally likely and there is one draw per
+        // sample; a hash set at most half full keeps the membership test O(1).
+        size_t table = 2;
+        while (table < 2 * batch_size) {
+            table *= 2;
+        }
+        drawn.assign(table, NO_SLOT);
+        const size_t mask = table - 1;
+        auto insert = [&](size_t slot) {
+            size_t h = (slot * 0x9E3779B97F4A7C15ull) & mask;
+            while (drawn[h] != NO_SLOT) {
+                if (drawn[h] == slot) {
+                    return false;
+                }
+                h = (h + 1) & mask;
+            }
+            drawn[h] = slot;
+            return true;
+        };
+        for (size_t j = current_size - batch_size; j < current_size; ++j) {
+            std::uniform_int_distribution<size_t> dist(0, j);
+            const size_t t = dist(gen);
+            const size_t slot = insert(t) ? t : j;
+            if (slot == j) {
+                insert(j);
+            }
+            indices.push_back(slot);
+        }
+    }
+}
+
+std::vector<Experience> ReplayBuffer::sample(size_t batch_size) {
+    draw_indices(batch_size, sampled);
+
     std::vector<Experience> batch;
     batch.reserve(batch_size);
-
-    std::sample(memory.begin(), memory.begin() + current_size, std::back_inserter(batch),
-                batch_size, gen);
+    for (size_t index : sampled) {
+        const double* state = states.row(index);
+        const double* next_state = next_states.row(index);
+        batch.push_back({std::vector<double>(state, state + state_size), actions[index], rewards[index],
+                         std::vector<double>(next_state, next_state + state_size), dones[index] != 0});
+    }
 
     return batch;
 }
 
+void ReplayBuffer::sample(size_t batch_size, ReplayBatch& batch) {
+    draw_indices(batch_size, batch.indices);
+    gather(batch.indices, batch);
+    batch.weights.clear();
+}
+
+void ReplayBuffer::gather(Span<const size_t> indices, ReplayBatch& batch) const {
+    for (size_t index : indices) {
+        if (index >= current_size) {
+            throw std::out_of_range("Replay buffer slot is not in use");
+        }
+    }
+    if (indices.data() != batch.indices.data()) {
+        batch.indices.assign(indices.begin(), indices.end());
+    }
+    batch.discounts.clear();
+
+    const size_t batch_size = indices.size();
+    batch.states.resize(batch_size, state_size);
+    batch.next_states.resize(batch_size, state_size);
+    batch.actions.resize(batch_size);
+    batch.rewards.resize(batch_size);
+    batch.dones.resize(batch_size);
+    for (size_t r = 0; r < batch_size; ++r) {
+        const size_t index = batch.indices[r];
+        std::copy(states.row(index), states.row(index) + state_size, batch.states.row(r));
+        std::copy(next_states.row(index), next_states.row(index) + state_size, batch.next_states.row(r));
+        batch.actions[r] = actions[index];
+        batch.rewards[r] = rewards[index];
+        batch.dones[r] = dones[index];
+    }
+}
+
+void ReplayBuffer::setSampling(SamplingMode mode) {
+    sampling = mode;
+}
+
+SamplingMode ReplayBuffer::getSampling() const {
+    return sampling;
+}
+
 size_t ReplayBuffer::size() const {
     return current_size;
 }
 
+size_t ReplayBuffer::getStateSize() const {
+    return state_size;
+}
+
 bool ReplayBuffer::is_ready(size_t batch_size) const {
     return current_size >= batch_size;
 }
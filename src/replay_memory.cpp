@@ -0,0 +1,145 @@
+#include "replay_memory.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+PriorityTree::PriorityTree(size_t capacity) : leaves(1) {
+    if (capacity == 0) {
+        throw std::invalid_argument("Priority tree capacity must be at least 1");
+    }
+    while (leaves < capacity) {
+        leaves *= 2;
+    }
+    sums.assign(2 * leaves, 0.0);
+    minimums.assign(2 * leaves, std::numeric_limits<double>::infinity());
+}
+
+void PriorityTree::set(size_t index, double priority) {
+    if (index >= leaves) {
+        throw std::out_of_range("Priority tree index out of range");
+    }
+    if (!(priority > 0.0) || !std::isfinite(priority)) {
+        throw std::invalid_argument("Priorities must be positive and finite");
+    }
+
+    size_t node = leaves + index;
+    sums[node] = priority;
+    minimums[node] = priority;
+    for (node /= 2; node >= 1; node /= 2) {
+        sums[node] = sums[2 * node] + sums[2 * node + 1];
+        minimums[node] = std::min(minimums[2 * node], minimums[2 * node + 1]);
+    }
+}
+
+double PriorityTree::get(size_t index) const {
+    return index < leaves ? sums[leaves + index] : 0.0;
+}
+
+double PriorityTree::total() const {
+    return sums[1];
+}
+
+double PriorityTree::min() const {
+    return minimums[1];
+}
+
+size_t PriorityTree::find(double mass) const {
+    if (!(sums[1] > 0.0)) {
+        throw std::runtime_error("Priority tree is empty");
+    }
+
+    // Rounding in the inner sums can leave mass just past a subtree's total; never step
+    // into a subtree without priority, so the walk always ends on a slot in use.
+    mass = std::max(mass, 0.0);
+    size_t node = 1;
+    while (node < leaves) {
+        const size_t left = 2 * node;
+        if (sums[left + 1] <= 0.0 || mass < sums[left]) {
+            node = left;
+        } else {
+            mass -= sums[left];
+            node = left + 1;
+        }
+    }
+
+    return node - leaves;
+}
+
+ReplayMemory::ReplayMemory(size_t capacity, size_t state_size, double alpha, double epsilon)
+    : storage(capacity, state_size), priorities(capacity), alpha(alpha), epsilon(epsilon), max_priority(1.0),
+      gen(std::random_device{}()) {
+    if (!(alpha >= 0.0)) {
+        throw std::invalid_argument("Priority exponent must not be negative");
+    }
+    if (!(epsilon > 0.0)) {
+        throw std::invalid_argument("Priority epsilon must be positive");
+    }
+}
+
+void ReplayMemory::push(const Experience& experience) {
+    push(experience.state, experience.action, experience.reward, experience.next_state, experience.done);
+}
+
+void ReplayMemory::push(Span<const double> state, int action, double reward, Span<const double> next_state, bool done) {
+    const size_t slot = storage.push(state, action, reward, next_state, done);
+    priorities.set(slot, max_priority);
+}
+
+void ReplayMemory::sample(size_t batch_size, double beta, ReplayBatch& batch) {
+    if (storage.size() < batch_size) {
+        throw std::runtime_error("Not enough experiences in memory to sample a batch.");
+    }
+    if (!(beta >= 0.0)) {
+        throw std::invalid_argument("Importance-sampling exponent must not be negative");
+    }
+
+    const double total = priorities.total();
+    const double segment = total / (double)batch_size;
+    std::uniform_real_distribution<double> offset(0.0, 1.0);
+    batch.indices.resize(batch_size);
+    for (size_t k = 0; k < batch_size; ++k) {
+        batch.indices[k] = priorities.find(((double)k + offset(gen)) * segment);
+    }
+    storage.gather(batch.indices, batch);
+
+    // w_i = (N * P(i))^-beta / max_j w_j, and the largest weight belongs to the smallest
+    // priority, so the ratio reduces to (p_i / p_min)^-beta.
+    const double smallest = priorities.min();
+    batch.weights.resize(batch_size);
+    for (size_t k = 0; k < batch_size; ++k) {
+        batch.weights[k] = std::pow(priorities.get(batch.indices[k]) / smallest, -beta);
+    }
+}
+
+void ReplayMemory::update_priorities(Span<const size_t> indices, Span<const double> errors) {
+    if (indices.size() != errors.size()) {
+        throw std::invalid_argument("Each index needs exactly one priority");
+    }
+    for (size_t k = 0; k < indices.size(); ++k) {
+        if (indices[k] >= storage.size()) {
+            throw std::out_of_range("Replay memory slot is not in use");
+        }
+        if (!(errors[k] >= 0.0) || !std::isfinite(errors[k])) {
+            throw std::invalid_argument("Priorities must be non-negative and finite");
+        }
+    }
+
+    for (size_t k = 0; k < indices.size(); ++k) {
+        const double priority = std::pow(errors[k] + epsilon, alpha);
+        priorities.set(indices[k], priority);
+        max_priority = std::max(max_priority, priority);
+    }
+}
+
+double ReplayMemory::getPriority(size_t index) const {
+    return priorities.get(index);
+}
+
+size_t ReplayMemory::size() const {
+    return storage.size();
+}
+
+bool ReplayMemory::is_ready(size_t batch_size) const {
+    return storage.size() >= batch_size;
+}
@@ -0,0 +1,438 @@
+#include "neuralnet.hpp"
+#include "dense.hpp"
+#include "activation.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Binary model file, version 3. All fields are in the byte order of the machine that
+ * wrote the file, which the byte_order field lets the reader verify.
+ *
+ *     offset 0      FileHeader (64 bytes)
+ *     offset 64     LayerRecord[layer_count] (64 bytes each)
+ *     ...           blobs, each starting on a 64-byte boundary
+ *
+ * A Dense record points at its weights (rows x cols, row-major, stride == cols) and
+ * biases (rows) by absolute file offset. Since mmap returns page-aligned memory, the
+ * blobs keep the 64-byte alignment of owned Matrix storage once mapped.
+ *
+ * Version 2 adds the number of completed training epochs to the header and, for Dense
+ * layers with optimizers, the offsets of two optimizer state blobs (weights, biases):
+ * a StateRecord followed by buffer_count buffers of length elements each. Offset 0
+ * means no state. Version 1 files are read as having neither.
+ *
+ * Version 3 adds the offset of the optimizer state of the network's parameter arena
+ * to the header, in the same blob format; its buffers cover every parameter of the
+ * network in arena order. Older files are read as having none.
+ */
+
+namespace {
+    constexpr char MAGIC[8] = {'N', 'P', 'M', 'O', 'D', 'E', 'L', '\0'};
+    constexpr std::uint32_t FORMAT_VERSION = 3;
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+    constexpr std::uint64_t BLOB_ALIGNMENT = 64;
+
+    enum class LayerKind : std::uint32_t {
+        Dense = 1,
+        Activation = 2
+    };
+
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint32_t scalar_size;
+        std::uint32_t layer_count;
+        std::uint64_t file_size;
+        std::uint64_t epoch;
+        std::uint64_t network_state_offset;
+        std::uint64_t reserved[2];
+    };
+
+    struct LayerRecord {
+        std::uint32_t kind;
+        std::uint32_t activation;
+        std::uint64_t rows;
+        std::uint64_t cols;
+        std::uint64_t weights_offset;
+        std::uint64_t biases_offset;
+        double alpha;
+        std::uint64_t weight_state_offset;
+        std::uint64_t bias_state_offset;
+    };
+
+    struct StateRecord {
+        std::uint32_t buffer_count;
+        std::int32_t step;
+        std::uint64_t length;
+        std::uint64_t reserved[6];
+    };
+
+    static_assert(sizeof(FileHeader) == 64, "FileHeader must stay 64 bytes");
+    static_assert(sizeof(LayerRecord) == 64, "LayerRecord must stay 64 bytes");
+    static_assert(sizeof(StateRecord) == 64, "StateRecord must stay 64 bytes");
+
+    std::uint64_t align_up(std::uint64_t offset) {
+        return (offset + BLOB_ALIGNMENT - 1) / BLOB_ALIGNMENT * BLOB_ALIGNMENT;
+    }
+
+    // A read-only file mapped copy-on-write; unmapped when the last matrix using it goes away.
+    class FileMapping {
+        private:
+            void* address;
+            std::size_t length;
+
+        public:
+            explicit FileMapping(const std::string& filename) : address(MAP_FAILED), length(0) {
+                const int fd = ::open(filename.c_str(), O_RDONLY);
+                if (fd < 0) {
+                    throw std::runtime_error("Cannot open model file " + filename + ": " + std::strerror(errno));
+                }
+                struct stat info;
+                if (::fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(FileHeader)) {
+                    ::close(fd);
+                    throw std::runtime_error("Model file " + filename + " is too small");
+                }
+                length = (std::size_t)info.st_size;
+                address = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                ::close(fd);
+                if (address == MAP_FAILED) {
+                    throw std::runtime_error("Cannot map model file " + filename + ": " + std::strerror(errno));
+                }
+            }
+
+            FileMapping(const FileMapping&) = delete;
+            FileMapping& operator=(const FileMapping&) = delete;
+
+            ~FileMapping() {
+                ::munmap(address, length);
+            }
+
+            unsigned char* data() const { return static_cast<unsigned char*>(address); }
+            std::size_t size() const { return length; }
+    };
+
+    // A span of bytes to write at a given file offset.
+    struct Blob {
+        std::uint64_t offset;
+        const void* data;
+        std::uint64_t bytes;
+    };
+
+    // Checks that [offset, offset + count * element) lies inside the file and is aligned.
+    void check_blob(std::uint64_t offset, std::uint64_t count, std::uint64_t element, std::size_t file_size) {
+        if (offset % BLOB_ALIGNMENT != 0 || offset > file_size || count > (file_size - offset) / element) {
+            throw std::runtime_error("Model file is corrupt: blob out of bounds");
+        }
+    }
+
+    // Validates the header of a mapped file holding scalars of scalar_size bytes and returns it.
+    FileHeader read_header(const FileMapping& mapping, const std::string& filename, std::size_t scalar_size) {
+        FileHeader header;
+        std::memcpy(&header, mapping.data(), sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+            throw std::runtime_error(filename + " is not a model file");
+        }
+        if (header.version == 0 || header.version > FORMAT_VERSION) {
+            throw std::runtime_error("Unsupported model file version " + std::to_string(header.version));
+        }
+        if (header.byte_order != BYTE_ORDER_MARK) {
+            throw std::runtime_error("Model file was written on a machine with a different byte order");
+        }
+        if (header.scalar_size != scalar_size) {
+            throw std::runtime_error("Model file was saved with a different scalar type");
+        }
+        if (header.file_size != mapping.size() ||
+            header.layer_count > (mapping.size() - sizeof(FileHeader)) / sizeof(LayerRecord)) {
+            throw std::runtime_error("Model file is truncated or corrupt");
+        }
+        if (header.version < 2) {
+            header.epoch = 0;
+        }
+        if (header.version < 3) {
+            header.network_state_offset = 0;
+        }
+
+        return header;
+    }
+
+    // Reads and validates layer record l of a mapped file.
+    LayerRecord read_record(const FileMapping& mapping, const FileHeader& header, std::uint32_t l, std::size_t scalar_size) {
+        LayerRecord record;
+        std::memcpy(&record, mapping.data() + sizeof(FileHeader) + l * sizeof(LayerRecord), sizeof(record));
+        if (header.version < 2) {
+            record.weight_state_offset = 0;
+            record.bias_state_offset = 0;
+        }
+
+        if (record.kind == (std::uint32_t)LayerKind::Dense) {
+            if (record.rows == 0 || record.cols == 0 ||
+                record.cols > std::numeric_limits<std::uint64_t>::max() / record.rows) {
+                throw std::runtime_error("Model file is corrupt: invalid Dense shape");
+            }
+            check_blob(record.weights_offset, record.rows * record.cols, scalar_size, mapping.size());
+            check_blob(record.biases_offset, record.rows, scalar_size, mapping.size());
+        } else if (record.kind == (std::uint32_t)LayerKind::Activation) {
+            if (record.activation >= (std::uint32_t)ActivationType::Custom) {
+                throw std::runtime_error("Model file is corrupt: unknown activation type");
+            }
+        } else {
+            throw std::runtime_error("Model file is corrupt: unknown layer kind " + std::to_string(record.kind));
+        }
+
+        return record;
+    }
+
+    // Reads the optimizer state blob at offset.
+    template<typename T>
+    BasicOptimizerState<T> read_state(const FileMapping& mapping, std::uint64_t offset) {
+        check_blob(offset, 1, sizeof(StateRecord), mapping.size());
+        StateRecord record;
+        std::memcpy(&record, mapping.data() + offset, sizeof(record));
+        const std::uint64_t start = offset + sizeof(StateRecord);
+        if (record.buffer_count != 0 && record.length > std::numeric_limits<std::uint64_t>::max() / record.buffer_count) {
+            throw std::runtime_error("Model file is corrupt: invalid optimizer state");
+        }
+        check_blob(start, record.buffer_count * record.length, sizeof(T), mapping.size());
+
+        BasicOptimizerState<T> state;
+        state.step = record.step;
+        const T* values = reinterpret_cast<const T*>(mapping.data() + start);
+        for (std::uint32_t b = 0; b < record.buffer_count; ++b) {
+            state.buffers.emplace_back(values + b * record.length, values + (b + 1) * record.length);
+        }
+
+        return state;
+    }
+
+    // Appends an optimizer state blob at the next aligned offset and returns its offset.
+    template<typename T>
+    std::uint64_t plan_state(const BasicOptimizerState<T>& state, std::vector<StateRecord>& records,
+                             std::vector<Blob>& blobs, std::uint64_t& offset) {
+        const std::uint64_t length = state.buffers.empty() ? 0 : state.buffers[0].size();
+        for (const auto& buffer : state.buffers) {
+            if (buffer.size() != length) {
+                throw std::invalid_argument("Optimizer state buffers must have the same size");
+            }
+        }
+
+        StateRecord record;
+        std::memset(&record, 0, sizeof(record));
+        record.buffer_count = (std::uint32_t)state.buffers.size();
+        record.step = state.step;
+        record.length = length;
+        records.push_back(record);
+
+        const std::uint64_t start = align_up(offset);
+        blobs.push_back({start, &records.back(), sizeof(StateRecord)});
+        offset = start + sizeof(StateRecord);
+        for (const auto& buffer : state.buffers) {
+            blobs.push_back({offset, buffer.data(), buffer.size() * sizeof(T)});
+            offset += buffer.size() * sizeof(T);
+        }
+
+        return start;
+    }
+}
+
+template<typename T>
+void BasicNeuralNet<T>::save(const std::string& filename, int epoch) const {
+    if (epoch < 0) {
+        throw std::invalid_argument("Epoch must not be negative");
+    }
+
+    std::vector<LayerRecord> records(layers.size());
+    std::vector<Blob> blobs;
+    std::vector<BasicOptimizerState<T>> states;
+    std::vector<StateRecord> state_records;
+    states.reserve(2 * layers.size() + 1);
+    state_records.reserve(2 * layers.size() + 1);
+    std::uint64_t offset = sizeof(FileHeader) + layers.size() * sizeof(LayerRecord);
+
+    for (size_t l = 0; l < layers.size(); ++l) {
+        LayerRecord& record = records[l];
+        std::memset(&record, 0, sizeof(record));
+        if (const auto* dense = dynamic_cast<const BasicDense<T>*>(layers[l].get())) {
+            const BasicMatrix<T>& weights = dense->getWeights();
+            Span<const T> biases = dense->getBiases();
+            record.kind = (std::uint32_t)LayerKind::Dense;
+            record.rows = weights.rows();
+            record.cols = weights.cols();
+            record.weights_offset = align_up(offset);
+            blobs.push_back({record.weights_offset, weights.data(), weights.size() * sizeof(T)});
+            record.biases_offset = align_up(record.weights_offset + weights.size() * sizeof(T));
+            blobs.push_back({record.biases_offset, biases.data(), biases.size() * sizeof(T)});
+            offset = record.biases_offset + biases.size() * sizeof(T);
+
+            if (dense->getWeightOptimizer() != nullptr) {
+                states.push_back(dense->getWeightOptimizer()->getState());
+                record.weight_state_offset = plan_state(states.back(), state_records, blobs, offset);
+            }
+            if (dense->getBiasOptimizer() != nullptr) {
+                states.push_back(dense->getBiasOptimizer()->getState());
+                record.bias_state_offset = plan_state(states.back(), state_records, blobs, offset);
+            }
+        } else if (const auto* activation = dynamic_cast<const BasicActivation<T>*>(layers[l].get())) {
+            if (activation->getType() == ActivationType::Custom) {
+                throw std::invalid_argument("Cannot save layer " + std::to_string(l) + ": custom activations are not serializable");
+            }
+            record.kind = (std::uint32_t)LayerKind::Activation;
+            record.activation = (std::uint32_t)activation->getType();
+            record.alpha = activation->getAlpha();
+        } else {
+            throw std::invalid_argument("Cannot save layer " + std::to_string(l) + ": only Dense and Activation layers are serializable");
+        }
+    }
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    if (arena && arena->getOptimizer() != nullptr) {
+        states.push_back(arena->getOptimizer()->getState());
+        header.network_state_offset = plan_state(states.back(), state_records, blobs, offset);
+    }
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.scalar_size = sizeof(T);
+    header.layer_count = (std::uint32_t)layers.size();
+    header.file_size = offset;
+    header.epoch = (std::uint64_t)epoch;
+
+    // Written beside the target and renamed over it, so readers never see a partial file
+    // and existing mappings of the old file keep their contents.
+    const std::string temporary = filename + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot create model file " + temporary);
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(records.data()), (std::streamsize)(records.size() * sizeof(LayerRecord)));
+
+        static const char zeros[BLOB_ALIGNMENT] = {};
+        std::uint64_t written = sizeof(FileHeader) + records.size() * sizeof(LayerRecord);
+        for (const Blob& blob : blobs) {
+            out.write(zeros, (std::streamsize)(blob.offset - written));
+            out.write(static_cast<const char*>(blob.data), (std::streamsize)blob.bytes);
+            written = blob.offset + blob.bytes;
+        }
+
+        out.close();
+        if (!out) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Failed to write model file " + temporary);
+        }
+    }
+    if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Cannot replace model file " + filename);
+    }
+}
+
+template<typename T>
+void BasicNeuralNet<T>::load(const std::string& filename) {
+    auto mapping = std::make_shared<FileMapping>(filename);
+    const FileHeader header = read_header(*mapping, filename, sizeof(T));
+
+    std::vector<std::shared_ptr<BasicLayer<T>>> loaded;
+    loaded.reserve(header.layer_count);
+    for (std::uint32_t l = 0; l < header.layer_count; ++l) {
+        const LayerRecord record = read_record(*mapping, header, l, sizeof(T));
+        if (record.kind == (std::uint32_t)LayerKind::Dense) {
+            T* weights = reinterpret_cast<T*>(mapping->data() + record.weights_offset);
+            const T* biases = reinterpret_cast<const T*>(mapping->data() + record.biases_offset);
+            loaded.push_back(std::make_shared<BasicDense<T>>(
+                BasicMatrix<T>(weights, record.rows, record.cols, mapping),
+                std::vector<T>(biases, biases + record.rows)));
+        } else {
+            loaded.push_back(std::make_shared<BasicActivation<T>>((ActivationType)record.activation, record.alpha));
+        }
+    }
+
+    layers = std::move(loaded);
+    arena.reset();
+}
+
+template<typename T>
+int BasicNeuralNet<T>::restore(const std::string& filename) {
+    FileMapping mapping(filename);
+    const FileHeader header = read_header(mapping, filename, sizeof(T));
+    if (header.layer_count != layers.size() || header.epoch > (std::uint64_t)std::numeric_limits<int>::max()) {
+        throw std::runtime_error("Checkpoint does not match the network");
+    }
+
+    // Check the whole topology and read every optimizer state before touching any layer.
+    std::vector<LayerRecord> records;
+    std::vector<BasicOptimizerState<T>> weight_states(header.layer_count);
+    std::vector<BasicOptimizerState<T>> bias_states(header.layer_count);
+    for (std::uint32_t l = 0; l < header.layer_count; ++l) {
+        const LayerRecord record = read_record(mapping, header, l, sizeof(T));
+        bool matches = false;
+        if (const auto* dense = dynamic_cast<const BasicDense<T>*>(layers[l].get())) {
+            matches = record.kind == (std::uint32_t)LayerKind::Dense && record.rows == dense->getWeights().rows() &&
+                      record.cols == dense->getWeights().cols();
+        } else if (const auto* activation = dynamic_cast<const BasicActivation<T>*>(layers[l].get())) {
+            matches = record.kind == (std::uint32_t)LayerKind::Activation &&
+                      record.activation == (std::uint32_t)activation->getType();
+        }
+        if (!matches) {
+            throw std::runtime_error("Checkpoint does not match layer " + std::to_string(l) + " of the network");
+        }
+        if (record.kind == (std::uint32_t)LayerKind::Dense) {
+            if (record.weight_state_offset != 0) {
+                weight_states[l] = read_state<T>(mapping, record.weight_state_offset);
+            }
+            if (record.bias_state_offset != 0) {
+                bias_states[l] = read_state<T>(mapping, record.bias_state_offset);
+            }
+        }
+        records.push_back(record);
+    }
+    BasicOptimizerState<T> network_state;
+    if (header.network_state_offset != 0) {
+        network_state = read_state<T>(mapping, header.network_state_offset);
+    }
+
+    for (std::uint32_t l = 0; l < header.layer_count; ++l) {
+        auto* dense = dynamic_cast<BasicDense<T>*>(layers[l].get());
+        if (dense == nullptr) {
+            continue;
+        }
+        const LayerRecord& record = records[l];
+        T* weights = reinterpret_cast<T*>(mapping.data() + record.weights_offset);
+        const T* biases = reinterpret_cast<const T*>(mapping.data() + record.biases_offset);
+        dense->setWeights(BasicMatrix<T>(weights, record.rows, record.cols, nullptr));
+        dense->setBiases(Span<const T>(biases, record.rows));
+
+        if (record.weight_state_offset != 0 && dense->getWeightOptimizer() != nullptr) {
+            dense->getWeightOptimizer()->setState(weight_states[l]);
+        }
+        if (record.bias_state_offset != 0 && dense->getBiasOptimizer() != nullptr) {
+            dense->getBiasOptimizer()->setState(bias_states[l]);
+        }
+    }
+    if (header.network_state_offset != 0 && arena && arena->getOptimizer() != nullptr) {
+        arena->getOptimizer()->setState(network_state);
+    }
+
+    return (int)header.epoch;
+}
+
+template void BasicNeuralNet<float>::save(const std::string& filename, int epoch) const;
+template void BasicNeuralNet<double>::save(const std::string& filename, int epoch) const;
+template void BasicNeuralNet<float>::load(const std::string& filename);
+template void BasicNeuralNet<double>::load(const std::string& filename);
+template int BasicNeuralNet<float>::restore(const std::string& filename);
+template int BasicNeuralNet<double>::restore(const std::string& filename);
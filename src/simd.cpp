@@ -0,0 +1,745 @@
+#include "simd.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_HAS_X86_PATHS 1
+#include <immintrin.h>
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define SIMD_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define SIMD_HAS_X86_PATHS 0
+#endif
+
+namespace Simd {
+    namespace {
+        struct KernelTable {
+            void (*exp)(const double*, double*, std::size_t);
+            void (*sigmoid)(const double*, double*, std::size_t);
+            void (*tanh)(const double*, double*, std::size_t);
+            void (*softmax)(const double*, double*, std::size_t);
+            void (*exp_f)(const float*, float*, std::size_t);
+            void (*sigmoid_f)(const float*, float*, std::size_t);
+            void (*tanh_f)(const float*, float*, std::size_t);
+            void (*adam)(double*, const double*, double*, double*, std::size_t, const AdamCoefficients&);
+            void (*adam_f)(float*, const float*, float*, float*, std::size_t, const AdamCoefficients&);
+        };
+
+        // Range reduction and polynomial constants shared by the vector paths.
+        // exp(x) = 2^n * exp(r) with n = round(x / ln2) and |r| <= ln2 / 2, where
+        // exp(r) is evaluated as its degree-12 Taylor polynomial (truncation error
+        // below 2e-16 on that interval). ln2 is split into a high part with 32 trailing
+        // zero bits and a low part, so n * ln2_hi is exact.
+        constexpr double LOG2E = 1.4426950408889634074;
+        constexpr double LN2_HI = 6.93147180369123816490e-01;
+        constexpr double LN2_LO = 1.90821492927058770002e-10;
+        constexpr double EXP_MIN_INPUT = -750.0;
+        constexpr double EXP_MAX_INPUT = 710.0;
+        constexpr double EXP_COEFFS[13] = {
+            1.0,
+            1.0,
+            1.0 / 2.0,
+            1.0 / 6.0,
+            1.0 / 24.0,
+            1.0 / 120.0,
+            1.0 / 720.0,
+            1.0 / 5040.0,
+            1.0 / 40320.0,
+            1.0 / 362880.0,
+            1.0 / 3628800.0,
+            1.0 / 39916800.0,
+            1.0 / 479001600.0
+        };
+
+        // The float paths use the same reduction with a degree-7 Taylor polynomial
+        // (truncation error below 5e-9 for |r| <= ln2 / 2, under a float ulp). ln2_hi
+        // is 355 / 512, 9 significant bits, and |n| <= 150 needs 8 more, so n * ln2_hi
+        // is exact for every n in range.
+        constexpr float LOG2E_F = 1.44269504f;
+        constexpr float LN2_HI_F = 0.693359375f;
+        constexpr float LN2_LO_F = -2.12194440e-4f;
+        constexpr float EXP_MIN_INPUT_F = -104.0f;
+        constexpr float EXP_MAX_INPUT_F = 89.0f;
+        constexpr float EXP_COEFFS_F[8] = {
+            1.0f,
+            1.0f,
+            1.0f / 2.0f,
+            1.0f / 6.0f,
+            1.0f / 24.0f,
+            1.0f / 120.0f,
+            1.0f / 720.0f,
+            1.0f / 5040.0f
+        };
+
+        // ---- Scalar reference ------------------------------------------------------
+
+        template<typename T>
+        void exp_scalar(const T* input, T* output, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                output[i] = std::exp(input[i]);
+            }
+        }
+
+        template<typename T>
+        void sigmoid_scalar(const T* input, T* output, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                output[i] = T(1) / (T(1) + std::exp(-input[i]));
+            }
+        }
+
+        template<typename T>
+        void tanh_scalar(const T* input, T* output, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                output[i] = std::tanh(input[i]);
+            }
+        }
+
+        void softmax_scalar(const double* input, double* output, std::size_t n) {
+            if (n == 0) {
+                return;
+            }
+            double max_val = *std::max_element(input, input + n);
+            double sum_exp = 0.0;
+            for (std::size_t i = 0; i < n; ++i) {
+                output[i] = std::exp(input[i] - max_val);
+                sum_exp += output[i];
+            }
+            const double inv = 1.0 / sum_exp;
+            for (std::size_t i = 0; i < n; ++i) {
+                output[i] *= inv;
+            }
+        }
+
+        // One fused Adam/AdamW element update; the vector paths apply the same formula lane-wise.
+        template<typename T>
+        inline void adam_element(T& w, T g, T& m, T& v, T b1, T b2, T one_minus_b1, T one_minus_b2,
+                                 T step_size, T correction2, T epsilon, T keep) {
+            m = b1 * m + one_minus_b1 * g;
+            v = b2 * v + one_minus_b2 * g * g;
+            w = w * keep - step_size * m / (std::sqrt(v) * correction2 + epsilon);
+        }
+
+        template<typename T>
+        void adam_scalar(T* weights, const T* gradients, T* m, T* v, std::size_t n, const AdamCoefficients& c) {
+            const T b1 = static_cast<T>(c.beta1);
+            const T b2 = static_cast<T>(c.beta2);
+            const T one_minus_b1 = static_cast<T>(1.0 - c.beta1);
+            const T one_minus_b2 = static_cast<T>(1.0 - c.beta2);
+            const T step_size = static_cast<T>(c.step_size);
+            const T correction2 = static_cast<T>(c.inv_sqrt_correction2);
+            const T epsilon = static_cast<T>(c.epsilon);
+            const T keep = static_cast<T>(1.0 - c.decay);
+            for (std::size_t i = 0; i < n; ++i) {
+                adam_element(weights[i], gradients[i], m[i], v[i], b1, b2, one_minus_b1, one_minus_b2,
+                             step_size, correction2, epsilon, keep);
+            }
+        }
+
+        constexpr KernelTable SCALAR_TABLE = {exp_scalar<double>, sigmoid_scalar<double>, tanh_scalar<double>, softmax_scalar,
+                                              exp_scalar<float>, sigmoid_scalar<float>, tanh_scalar<float>,
+                                              adam_scalar<double>, adam_scalar<float>};
+
+#if SIMD_HAS_X86_PATHS
+        // ---- AVX2 + FMA ------------------------------------------------------------
+
+        SIMD_TARGET_AVX2 inline __m256d exp_avx2(__m256d x) {
+            // max/min with the constant first keep NaN inputs as NaN
+            x = _mm256_min_pd(_mm256_set1_pd(EXP_MAX_INPUT), _mm256_max_pd(_mm256_set1_pd(EXP_MIN_INPUT), x));
+            __m256d n = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(LOG2E)),
+                                        _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            __m256d r = _mm256_fnmadd_pd(n, _mm256_set1_pd(LN2_HI), x);
+            r = _mm256_fnmadd_pd(n, _mm256_set1_pd(LN2_LO), r);
+
+            __m256d p = _mm256_set1_pd(EXP_COEFFS[12]);
+            for (int k = 11; k >= 0; --k) {
+                p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(EXP_COEFFS[k]));
+            }
+
+            // 2^n is applied as 2^n1 * 2^n2 with n1 + n2 = n, so every factor stays a
+            // normal double even when the result overflows or is subnormal.
+            const __m256d n1 = _mm256_floor_pd(_mm256_mul_pd(n, _mm256_set1_pd(0.5)));
+            const __m256d n2 = _mm256_sub_pd(n, n1);
+            const __m256d bias = _mm256_set1_pd(4503599627370496.0 + 1023.0);  // 2^52 + exponent bias
+            const __m256i e1 = _mm256_slli_epi64(_mm256_castpd_si256(_mm256_add_pd(n1, bias)), 52);
+            const __m256i e2 = _mm256_slli_epi64(_mm256_castpd_si256(_mm256_add_pd(n2, bias)), 52);
+            p = _mm256_mul_pd(p, _mm256_castsi256_pd(e1));
+            return _mm256_mul_pd(p, _mm256_castsi256_pd(e2));
+        }
+
+        SIMD_TARGET_AVX2 inline __m256d sigmoid_avx2(__m256d x) {
+            const __m256d one = _mm256_set1_pd(1.0);
+            const __m256d e = exp_avx2(_mm256_sub_pd(_mm256_setzero_pd(), x));
+            return _mm256_div_pd(one, _mm256_add_pd(one, e));
+        }
+
+        // tanh(x) = sign(x) * (1 - t) / (1 + t) with t = exp(-2|x|) in (0, 1].
+        SIMD_TARGET_AVX2 inline __m256d tanh_avx2(__m256d x) {
+            const __m256d one = _mm256_set1_pd(1.0);
+            const __m256d sign_mask = _mm256_set1_pd(-0.0);
+            const __m256d a = _mm256_andnot_pd(sign_mask, x);
+            const __m256d t = exp_avx2(_mm256_mul_pd(a, _mm256_set1_pd(-2.0)));
+            const __m256d y = _mm256_div_pd(_mm256_sub_pd(one, t), _mm256_add_pd(one, t));
+            return _mm256_or_pd(y, _mm256_and_pd(sign_mask, x));
+        }
+
+        struct ExpAvx2 {
+            SIMD_TARGET_AVX2 __m256d operator()(__m256d x) const { return exp_avx2(x); }
+        };
+
+        struct SigmoidAvx2 {
+            SIMD_TARGET_AVX2 __m256d operator()(__m256d x) const { return sigmoid_avx2(x); }
+        };
+
+        struct TanhAvx2 {
+            SIMD_TARGET_AVX2 __m256d operator()(__m256d x) const { return tanh_avx2(x); }
+        };
+
+        // Applies a 4-wide operation over a buffer; the tail goes through a padded block.
+        template<typename Op>
+        SIMD_TARGET_AVX2 inline void map_avx2(Op op, const double* input, double* output, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                _mm256_storeu_pd(output + i, op(_mm256_loadu_pd(input + i)));
+            }
+            if (i < n) {
+                alignas(32) double tail[4] = {0.0, 0.0, 0.0, 0.0};
+                std::memcpy(tail, input + i, (n - i) * sizeof(double));
+                _mm256_store_pd(tail, op(_mm256_load_pd(tail)));
+                std::memcpy(output + i, tail, (n - i) * sizeof(double));
+            }
+        }
+
+        SIMD_TARGET_AVX2 void exp_avx2_buffer(const double* input, double* output, std::size_t n) {
+            map_avx2(ExpAvx2{}, input, output, n);
+        }
+
+        SIMD_TARGET_AVX2 void sigmoid_avx2_buffer(const double* input, double* output, std::size_t n) {
+            map_avx2(SigmoidAvx2{}, input, output, n);
+        }
+
+        SIMD_TARGET_AVX2 void tanh_avx2_buffer(const double* input, double* output, std::size_t n) {
+            map_avx2(TanhAvx2{}, input, output, n);
+        }
+
+        SIMD_TARGET_AVX2 void softmax_avx2_buffer(const double* input, double* output, std::size_t n) {
+            if (n == 0) {
+                return;
+            }
+            const double max_val = *std::max_element(input, input + n);
+            const __m256d shift = _mm256_set1_pd(max_val);
+            __m256d acc = _mm256_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const __m256d e = exp_avx2(_mm256_sub_pd(_mm256_loadu_pd(input + i), shift));
+                _mm256_storeu_pd(output + i, e);
+                acc = _mm256_add_pd(acc, e);
+            }
+            alignas(32) double lanes[4];
+            _mm256_store_pd(lanes, acc);
+            double sum_exp = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            for (; i < n; ++i) {
+                output[i] = std::exp(input[i] - max_val);
+                sum_exp += output[i];
+            }
+            const __m256d inv = _mm256_set1_pd(1.0 / sum_exp);
+            i = 0;
+            for (; i + 4 <= n; i += 4) {
+                _mm256_storeu_pd(output + i, _mm256_mul_pd(_mm256_loadu_pd(output + i), inv));
+            }
+            for (; i < n; ++i) {
+                output[i] *= 1.0 / sum_exp;
+            }
+        }
+
+        SIMD_TARGET_AVX2 inline __m256 exp_avx2_f(__m256 x) {
+            x = _mm256_min_ps(_mm256_set1_ps(EXP_MAX_INPUT_F), _mm256_max_ps(_mm256_set1_ps(EXP_MIN_INPUT_F), x));
+            __m256 n = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(LOG2E_F)),
+                                       _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            __m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(LN2_HI_F), x);
+            r = _mm256_fnmadd_ps(n, _mm256_set1_ps(LN2_LO_F), r);
+
+            __m256 p = _mm256_set1_ps(EXP_COEFFS_F[7]);
+            for (int k = 6; k >= 0; --k) {
+                p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(EXP_COEFFS_F[k]));
+            }
+
+            // 2^n in two normal factors, as in exp_avx2; n / 2 + 127 fits the 8 exponent bits
+            const __m256 n1 = _mm256_floor_ps(_mm256_mul_ps(n, _mm256_set1_ps(0.5f)));
+            const __m256 n2 = _mm256_sub_ps(n, n1);
+            const __m256 bias = _mm256_set1_ps(8388608.0f + 127.0f);  // 2^23 + exponent bias
+            const __m256i e1 = _mm256_slli_epi32(_mm256_castps_si256(_mm256_add_ps(n1, bias)), 23);
+            const __m256i e2 = _mm256_slli_epi32(_mm256_castps_si256(_mm256_add_ps(n2, bias)), 23);
+            p = _mm256_mul_ps(p, _mm256_castsi256_ps(e1));
+            return _mm256_mul_ps(p, _mm256_castsi256_ps(e2));
+        }
+
+        SIMD_TARGET_AVX2 inline __m256 sigmoid_avx2_f(__m256 x) {
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256 e = exp_avx2_f(_mm256_sub_ps(_mm256_setzero_ps(), x));
+            return _mm256_div_ps(one, _mm256_add_ps(one, e));
+        }
+
+        SIMD_TARGET_AVX2 inline __m256 tanh_avx2_f(__m256 x) {
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+            const __m256 a = _mm256_andnot_ps(sign_mask, x);
+            const __m256 t = exp_avx2_f(_mm256_mul_ps(a, _mm256_set1_ps(-2.0f)));
+            const __m256 y = _mm256_div_ps(_mm256_sub_ps(one, t), _mm256_add_ps(one, t));
+            return _mm256_or_ps(y, _mm256_and_ps(sign_mask, x));
+        }
+
+        struct ExpAvx2F {
+            SIMD_TARGET_AVX2 __m256 operator()(__m256 x) const { return exp_avx2_f(x); }
+        };
+
+        struct SigmoidAvx2F {
+            SIMD_TARGET_AVX2 __m256 operator()(__m256 x) const { return sigmoid_avx2_f(x); }
+        };
+
+        struct TanhAvx2F {
+            SIMD_TARGET_AVX2 __m256 operator()(__m256 x) const { return tanh_avx2_f(x); }
+        };
+
+        // Applies an 8-wide float operation over a buffer; the tail goes through a padded block.
+        template<typename Op>
+        SIMD_TARGET_AVX2 inline void map_avx2_f(Op op, const float* input, float* output, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                _mm256_storeu_ps(output + i, op(_mm256_loadu_ps(input + i)));
+            }
+            if (i < n) {
+                alignas(32) float tail[8] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+                std::memcpy(tail, input + i, (n - i) * sizeof(float));
+                _mm256_store_ps(tail, op(_mm256_load_ps(tail)));
+                std::memcpy(output + i, tail, (n - i) * sizeof(float));
+            }
+        }
+
+        SIMD_TARGET_AVX2 void exp_avx2_buffer_f(const float* input, float* output, std::size_t n) {
+            map_avx2_f(ExpAvx2F{}, input, output, n);
+        }
+
+        SIMD_TARGET_AVX2 void sigmoid_avx2_buffer_f(const float* input, float* output, std::size_t n) {
+            map_avx2_f(SigmoidAvx2F{}, input, output, n);
+        }
+
+        SIMD_TARGET_AVX2 void tanh_avx2_buffer_f(const float* input, float* output, std::size_t n) {
+            map_avx2_f(TanhAvx2F{}, input, output, n);
+        }
+
+        SIMD_TARGET_AVX2 void adam_avx2(double* weights, const double* gradients, double* m, double* v, std::size_t n,
+                                        const AdamCoefficients& c) {
+            const __m256d b1 = _mm256_set1_pd(c.beta1);
+            const __m256d b2 = _mm256_set1_pd(c.beta2);
+            const __m256d one_minus_b1 = _mm256_set1_pd(1.0 - c.beta1);
+            const __m256d one_minus_b2 = _mm256_set1_pd(1.0 - c.beta2);
+            const __m256d step_size = _mm256_set1_pd(c.step_size);
+            const __m256d correction2 = _mm256_set1_pd(c.inv_sqrt_correction2);
+            const __m256d epsilon = _mm256_set1_pd(c.epsilon);
+            const __m256d keep = _mm256_set1_pd(1.0 - c.decay);
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const __m256d g = _mm256_loadu_pd(gradients + i);
+                const __m256d m_new = _mm256_fmadd_pd(b1, _mm256_loadu_pd(m + i), _mm256_mul_pd(one_minus_b1, g));
+                const __m256d v_new = _mm256_fmadd_pd(b2, _mm256_loadu_pd(v + i), _mm256_mul_pd(one_minus_b2, _mm256_mul_pd(g, g)));
+                const __m256d denom = _mm256_fmadd_pd(_mm256_sqrt_pd(v_new), correction2, epsilon);
+                const __m256d w = _mm256_mul_pd(_mm256_loadu_pd(weights + i), keep);
+                _mm256_storeu_pd(m + i, m_new);
+                _mm256_storeu_pd(v + i, v_new);
+                _mm256_storeu_pd(weights + i, _mm256_fnmadd_pd(step_size, _mm256_div_pd(m_new, denom), w));
+            }
+            adam_scalar(weights + i, gradients + i, m + i, v + i, n - i, c);
+        }
+
+        SIMD_TARGET_AVX2 void adam_avx2_f(float* weights, const float* gradients, float* m, float* v, std::size_t n,
+                                          const AdamCoefficients& c) {
+            const __m256 b1 = _mm256_set1_ps((float)c.beta1);
+            const __m256 b2 = _mm256_set1_ps((float)c.beta2);
+            const __m256 one_minus_b1 = _mm256_set1_ps((float)(1.0 - c.beta1));
+            const __m256 one_minus_b2 = _mm256_set1_ps((float)(1.0 - c.beta2));
+            const __m256 step_size = _mm256_set1_ps((float)c.step_size);
+            const __m256 correction2 = _mm256_set1_ps((float)c.inv_sqrt_correction2);
+            const __m256 epsilon = _mm256_set1_ps((float)c.epsilon);
+            const __m256 keep = _mm256_set1_ps((float)(1.0 - c.decay));
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                const __m256 g = _mm256_loadu_ps(gradients + i);
+                const __m256 m_new = _mm256_fmadd_ps(b1, _mm256_loadu_ps(m + i), _mm256_mul_ps(one_minus_b1, g));
+                const __m256 v_new = _mm256_fmadd_ps(b2, _mm256_loadu_ps(v + i), _mm256_mul_ps(one_minus_b2, _mm256_mul_ps(g, g)));
+                const __m256 denom = _mm256_fmadd_ps(_mm256_sqrt_ps(v_new), correction2, epsilon);
+                const __m256 w = _mm256_mul_ps(_mm256_loadu_ps(weights + i), keep);
+                _mm256_storeu_ps(m + i, m_new);
+                _mm256_storeu_ps(v + i, v_new);
+                _mm256_storeu_ps(weights + i, _mm256_fnmadd_ps(step_size, _mm256_div_ps(m_new, denom), w));
+            }
+            adam_scalar(weights + i, gradients + i, m + i, v + i, n - i, c);
+        }
+
+        constexpr KernelTable AVX2_TABLE = {exp_avx2_buffer, sigmoid_avx2_buffer, tanh_avx2_buffer, softmax_avx2_buffer,
+                                            exp_avx2_buffer_f, sigmoid_avx2_buffer_f, tanh_avx2_buffer_f,
+                                            adam_avx2, adam_avx2_f};
+
+        // ---- AVX-512F ----------------------------------------------------------------
+
+        // GCC 12 reports a false -Wmaybe-uninitialized inside the AVX-512 intrinsic
+        // headers (their internal _mm512_undefined_pd placeholder) when they are inlined.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+        SIMD_TARGET_AVX512 inline __m512d exp_avx512(__m512d x) {
+            x = _mm512_min_pd(_mm512_set1_pd(EXP_MAX_INPUT), _mm512_max_pd(_mm512_set1_pd(EXP_MIN_INPUT), x));
+            __m512d n = _mm512_roundscale_pd(_mm512_mul_pd(x, _mm512_set1_pd(LOG2E)),
+                                             _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            __m512d r = _mm512_fnmadd_pd(n, _mm512_set1_pd(LN2_HI), x);
+            r = _mm512_fnmadd_pd(n, _mm512_set1_pd(LN2_LO), r);
+
+            __m512d p = _mm512_set1_pd(EXP_COEFFS[12]);
+            for (int k = 11; k >= 0; --k) {
+                p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(EXP_COEFFS[k]));
+            }
+
+            // scalef computes p * 2^n with correct overflow and subnormal handling
+            return _mm512_scalef_pd(p, n);
+        }
+
+        SIMD_TARGET_AVX512 inline __m512d sigmoid_avx512(__m512d x) {
+            const __m512d one = _mm512_set1_pd(1.0);
+            const __m512d e = exp_avx512(_mm512_sub_pd(_mm512_setzero_pd(), x));
+            return _mm512_div_pd(one, _mm512_add_pd(one, e));
+        }
+
+        SIMD_TARGET_AVX512 inline __m512d tanh_avx512(__m512d x) {
+            const __m512d one = _mm512_set1_pd(1.0);
+            const __m512d a = _mm512_abs_pd(x);
+            const __m512d t = exp_avx512(_mm512_mul_pd(a, _mm512_set1_pd(-2.0)));
+            const __m512d y = _mm512_div_pd(_mm512_sub_pd(one, t), _mm512_add_pd(one, t));
+            const __m512i sign = _mm512_and_epi64(_mm512_castpd_si512(x), _mm512_set1_epi64((long long)0x8000000000000000ULL));
+            return _mm512_castsi512_pd(_mm512_or_epi64(_mm512_castpd_si512(y), sign));
+        }
+
+        struct ExpAvx512 {
+            SIMD_TARGET_AVX512 __m512d operator()(__m512d x) const { return exp_avx512(x); }
+        };
+
+        struct SigmoidAvx512 {
+            SIMD_TARGET_AVX512 __m512d operator()(__m512d x) const { return sigmoid_avx512(x); }
+        };
+
+        struct TanhAvx512 {
+            SIMD_TARGET_AVX512 __m512d operator()(__m512d x) const { return tanh_avx512(x); }
+        };
+
+        struct ScaleAvx512 {
+            double factor;
+            SIMD_TARGET_AVX512 __m512d operator()(__m512d x) const { return _mm512_mul_pd(x, _mm512_set1_pd(factor)); }
+        };
+
+        // Applies an 8-wide operation over a buffer; the tail uses masked loads and stores.
+        template<typename Op>
+        SIMD_TARGET_AVX512 inline void map_avx512(Op op, const double* input, double* output, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                _mm512_storeu_pd(output + i, op(_mm512_loadu_pd(input + i)));
+            }
+            if (i < n) {
+                const __mmask8 mask = (__mmask8)((1u << (n - i)) - 1u);
+                _mm512_mask_storeu_pd(output + i, mask, op(_mm512_maskz_loadu_pd(mask, input + i)));
+            }
+        }
+
+        SIMD_TARGET_AVX512 void exp_avx512_buffer(const double* input, double* output, std::size_t n) {
+            map_avx512(ExpAvx512{}, input, output, n);
+        }
+
+        SIMD_TARGET_AVX512 void sigmoid_avx512_buffer(const double* input, double* output, std::size_t n) {
+            map_avx512(SigmoidAvx512{}, input, output, n);
+        }
+
+        SIMD_TARGET_AVX512 void tanh_avx512_buffer(const double* input, double* output, std::size_t n) {
+            map_avx512(TanhAvx512{}, input, output, n);
+        }
+
+        SIMD_TARGET_AVX512 void softmax_avx512_buffer(const double* input, double* output, std::size_t n) {
+            if (n == 0) {
+                return;
+            }
+            const double max_val = *std::max_element(input, input + n);
+            const __m512d shift = _mm512_set1_pd(max_val);
+            __m512d acc = _mm512_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                const __m512d e = exp_avx512(_mm512_sub_pd(_mm512_loadu_pd(input + i), shift));
+                _mm512_storeu_pd(output + i, e);
+                acc = _mm512_add_pd(acc, e);
+            }
+            if (i < n) {
+                const __mmask8 mask = (__mmask8)((1u << (n - i)) - 1u);
+                const __m512d e = exp_avx512(_mm512_sub_pd(_mm512_maskz_loadu_pd(mask, input + i), shift));
+                _mm512_mask_storeu_pd(output + i, mask, e);
+                acc = _mm512_add_pd(acc, _mm512_maskz_mov_pd(mask, e));
+            }
+            map_avx512(ScaleAvx512{1.0 / _mm512_reduce_add_pd(acc)}, output, output, n);
+        }
+
+        SIMD_TARGET_AVX512 inline __m512 exp_avx512_f(__m512 x) {
+            x = _mm512_min_ps(_mm512_set1_ps(EXP_MAX_INPUT_F), _mm512_max_ps(_mm512_set1_ps(EXP_MIN_INPUT_F), x));
+            __m512 n = _mm512_roundscale_ps(_mm512_mul_ps(x, _mm512_set1_ps(LOG2E_F)),
+                                            _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            __m512 r = _mm512_fnmadd_ps(n, _mm512_set1_ps(LN2_HI_F), x);
+            r = _mm512_fnmadd_ps(n, _mm512_set1_ps(LN2_LO_F), r);
+
+            __m512 p = _mm512_set1_ps(EXP_COEFFS_F[7]);
+            for (int k = 6; k >= 0; --k) {
+                p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(EXP_COEFFS_F[k]));
+            }
+
+            return _mm512_scalef_ps(p, n);
+        }
+
+        SIMD_TARGET_AVX512 inline __m512 sigmoid_avx512_f(__m512 x) {
+            const __m512 one = _mm512_set1_ps(1.0f);
+            const __m512 e = exp_avx512_f(_mm512_sub_ps(_mm512_setzero_ps(), x));
+            return _mm512_div_ps(one, _mm512_add_ps(one, e));
+        }
+
+        SIMD_TARGET_AVX512 inline __m512 tanh_avx512_f(__m512 x) {
+            const __m512 one = _mm512_set1_ps(1.0f);
+            const __m512 a = _mm512_abs_ps(x);
+            const __m512 t = exp_avx512_f(_mm512_mul_ps(a, _mm512_set1_ps(-2.0f)));
+            const __m512 y = _mm512_div_ps(_mm512_sub_ps(one, t), _mm512_add_ps(one, t));
+            const __m512i sign = _mm512_and_epi32(_mm512_castps_si512(x), _mm512_set1_epi32((int)0x80000000u));
+            return _mm512_castsi512_ps(_mm512_or_epi32(_mm512_castps_si512(y), sign));
+        }
+
+        struct ExpAvx512F {
+            SIMD_TARGET_AVX512 __m512 operator()(__m512 x) const { return exp_avx512_f(x); }
+        };
+
+        struct SigmoidAvx512F {
+            SIMD_TARGET_AVX512 __m512 operator()(__m512 x) const { return sigmoid_avx512_f(x); }
+        };
+
+        struct TanhAvx512F {
+            SIMD_TARGET_AVX512 __m512 operator()(__m512 x) const { return tanh_avx512_f(x); }
+        };
+
+        // Applies a 16-wide float operation over a buffer; the tail uses masked loads and stores.
+        template<typename Op>
+        SIMD_TARGET_AVX512 inline void map_avx512_f(Op op, const float* input, float* output, std::size_t n) {
+            std::size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                _mm512_storeu_ps(output + i, op(_mm512_loadu_ps(input + i)));
+            }
+            if (i < n) {
+                const __mmask16 mask = (__mmask16)((1u << (n - i)) - 1u);
+                _mm512_mask_storeu_ps(output + i, mask, op(_mm512_maskz_loadu_ps(mask, input + i)));
+            }
+        }
+
+        SIMD_TARGET_AVX512 void exp_avx512_buffer_f(const float* input, float* output, std::size_t n) {
+            map_avx512_f(ExpAvx512F{}, input, output, n);
+        }
+
+        SIMD_TARGET_AVX512 void sigmoid_avx512_buffer_f(const float* input, float* output, std::size_t n) {
+            map_avx512_f(SigmoidAvx512F{}, input, output, n);
+        }
+
+        SIMD_TARGET_AVX512 void tanh_avx512_buffer_f(const float* input, float* output, std::size_t n) {
+            map_avx512_f(TanhAvx512F{}, input, output, n);
+        }
+
+        SIMD_TARGET_AVX512 void adam_avx512(double* weights, const double* gradients, double* m, double* v, std::size_t n,
+                                            const AdamCoefficients& c) {
+            const __m512d b1 = _mm512_set1_pd(c.beta1);
+            const __m512d b2 = _mm512_set1_pd(c.beta2);
+            const __m512d one_minus_b1 = _mm512_set1_pd(1.0 - c.beta1);
+            const __m512d one_minus_b2 = _mm512_set1_pd(1.0 - c.beta2);
+            const __m512d step_size = _mm512_set1_pd(c.step_size);
+            const __m512d correction2 = _mm512_set1_pd(c.inv_sqrt_correction2);
+            const __m512d epsilon = _mm512_set1_pd(c.epsilon);
+            const __m512d keep = _mm512_set1_pd(1.0 - c.decay);
+            for (std::size_t i = 0; i < n; i += 8) {
+                const __mmask8 mask = n - i >= 8 ? (__mmask8)0xFF : (__mmask8)((1u << (n - i)) - 1u);
+                const __m512d g = _mm512_maskz_loadu_pd(mask, gradients + i);
+                const __m512d m_new = _mm512_fmadd_pd(b1, _mm512_maskz_loadu_pd(mask, m + i), _mm512_mul_pd(one_minus_b1, g));
+                const __m512d v_new = _mm512_fmadd_pd(b2, _mm512_maskz_loadu_pd(mask, v + i), _mm512_mul_pd(one_minus_b2, _mm512_mul_pd(g, g)));
+                const __m512d denom = _mm512_fmadd_pd(_mm512_sqrt_pd(v_new), correction2, epsilon);
+                const __m512d w = _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, weights + i), keep);
+                _mm512_mask_storeu_pd(m + i, mask, m_new);
+                _mm512_mask_storeu_pd(v + i, mask, v_new);
+                _mm512_mask_storeu_pd(weights + i, mask, _mm512_fnmadd_pd(step_size, _mm512_div_pd(m_new, denom), w));
+            }
+        }
+
+        SIMD_TARGET_AVX512 void adam_avx512_f(float* weights, const float* gradients, float* m, float* v, std::size_t n,
+                                              const AdamCoefficients& c) {
+            const __m512 b1 = _mm512_set1_ps((float)c.beta1);
+            const __m512 b2 = _mm512_set1_ps((float)c.beta2);
+            const __m512 one_minus_b1 = _mm512_set1_ps((float)(1.0 - c.beta1));
+            const __m512 one_minus_b2 = _mm512_set1_ps((float)(1.0 - c.beta2));
+            const __m512 step_size = _mm512_set1_ps((float)c.step_size);
+            const __m512 correction2 = _mm512_set1_ps((float)c.inv_sqrt_correction2);
+            const __m512 epsilon = _mm512_set1_ps((float)c.epsilon);
+            const __m512 keep = _mm512_set1_ps((float)(1.0 - c.decay));
+            for (std::size_t i = 0; i < n; i += 16) {
+                const __mmask16 mask = n - i >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (n - i)) - 1u);
+                const __m512 g = _mm512_maskz_loadu_ps(mask, gradients + i);
+                const __m512 m_new = _mm512_fmadd_ps(b1, _mm512_maskz_loadu_ps(mask, m + i), _mm512_mul_ps(one_minus_b1, g));
+                const __m512 v_new = _mm512_fmadd_ps(b2, _mm512_maskz_loadu_ps(mask, v + i), _mm512_mul_ps(one_minus_b2, _mm512_mul_ps(g, g)));
+                const __m512 denom = _mm512_fmadd_ps(_mm512_sqrt_ps(v_new), correction2, epsilon);
+                const __m512 w = _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, weights + i), keep);
+                _mm512_mask_storeu_ps(m + i, mask, m_new);
+                _mm512_mask_storeu_ps(v + i, mask, v_new);
+                _mm512_mask_storeu_ps(weights + i, mask, _mm512_fnmadd_ps(step_size, _mm512_div_ps(m_new, denom), w));
+            }
+        }
+
+        constexpr KernelTable AVX512_TABLE = {exp_avx512_buffer, sigmoid_avx512_buffer, tanh_avx512_buffer, softmax_avx512_buffer,
+                                              exp_avx512_buffer_f, sigmoid_avx512_buffer_f, tanh_avx512_buffer_f,
+                                              adam_avx512, adam_avx512_f};
+#pragma GCC diagnostic pop
+#endif
+
+        const KernelTable* table_for(Isa isa) {
+#if SIMD_HAS_X86_PATHS
+            switch (isa) {
+                case Isa::AVX512: return &AVX512_TABLE;
+                case Isa::AVX2:   return &AVX2_TABLE;
+                case Isa::Scalar: break;
+            }
+#else
+            (void)isa;
+#endif
+            return &SCALAR_TABLE;
+        }
+
+        Isa probe_isa() {
+#if SIMD_HAS_X86_PATHS
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) {
+                return Isa::AVX512;
+            }
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+                return Isa::AVX2;
+            }
+#endif
+            return Isa::Scalar;
+        }
+
+        struct ActiveKernels {
+            std::atomic<Isa> isa;
+            std::atomic<const KernelTable*> table;
+
+            ActiveKernels() : isa(detect_isa()), table(table_for(detect_isa())) {}
+        };
+
+        ActiveKernels& active() {
+            static ActiveKernels kernels;
+            return kernels;
+        }
+
+        const KernelTable& kernels() {
+            return *active().table.load(std::memory_order_relaxed);
+        }
+    }
+
+    Isa detect_isa() {
+        static const Isa detected = probe_isa();
+        return detected;
+    }
+
+    Isa active_isa() {
+        return active().isa.load(std::memory_order_relaxed);
+    }
+
+    bool set_isa(Isa isa) {
+        if ((int)isa > (int)detect_isa()) {
+            return false;
+        }
+        active().isa.store(isa, std::memory_order_relaxed);
+        active().table.store(table_for(isa), std::memory_order_relaxed);
+        return true;
+    }
+
+    void exp(const double* input, double* output, std::size_t n) {
+        kernels().exp(input, output, n);
+    }
+
+    void sigmoid(const double* input, double* output, std::size_t n) {
+        kernels().sigmoid(input, output, n);
+    }
+
+    void tanh(const double* input, double* output, std::size_t n) {
+        kernels().tanh(input, output, n);
+    }
+
+    void softmax(const double* input, double* output, std::size_t n) {
+        kernels().softmax(input, output, n);
+    }
+
+    AdamCoefficients adam_coefficients(double learning_rate, double beta1, double beta2, double epsilon,
+                                       double weight_decay, int step) {
+        AdamCoefficients c;
+        c.beta1 = beta1;
+        c.beta2 = beta2;
+        c.step_size = learning_rate / (1.0 - std::pow(beta1, step));
+        c.inv_sqrt_correction2 = 1.0 / std::sqrt(1.0 - std::pow(beta2, step));
+        c.epsilon = epsilon;
+        c.decay = learning_rate * weight_decay;
+        return c;
+    }
+
+    void adam(double* weights, const double* gradients, double* m, double* v, std::size_t n, const AdamCoefficients& c) {
+        kernels().adam(weights, gradients, m, v, n, c);
+    }
+
+    void adam(float* weights, const float* gradients, float* m, float* v, std::size_t n, const AdamCoefficients& c) {
+        kernels().adam_f(weights, gradients, m, v, n, c);
+    }
+
+    namespace {
+        // Elements widened per step in the float softmax; the double copy stays in L1.
+        constexpr std::size_t FLOAT_CHUNK = 256;
+    }
+
+    void exp(const float* input, float* output, std::size_t n) {
+        kernels().exp_f(input, output, n);
+    }
+
+    void sigmoid(const float* input, float* output, std::size_t n) {
+        kernels().sigmoid_f(input, output, n);
+    }
+
+    void tanh(const float* input, float* output, std::size_t n) {
+        kernels().tanh_f(input, output, n);
+    }
+
+    void softmax(const float* input, float* output, std::size_t n) {
+        if (n == 0) {
+            return;
+        }
+
+        const double max_val = *std::max_element(input, input + n);
+        const auto exp_kernel = kernels().exp;
+        alignas(64) double buffer[FLOAT_CHUNK];
+        double sum = 0.0;
+        for (std::size_t i0 = 0; i0 < n; i0 += FLOAT_CHUNK) {
+            const std::size_t len = std::min(FLOAT_CHUNK, n - i0);
+            for (std::size_t i = 0; i < len; ++i) {
+                buffer[i] = input[i0 + i] - max_val;
+            }
+            exp_kernel(buffer, buffer, len);
+            for (std::size_t i = 0; i < len; ++i) {
+                sum += buffer[i];
+                output[i0 + i] = static_cast<float>(buffer[i]);
+            }
+        }
+
+        const double inv = 1.0 / sum;
+        for (std::size_t i = 0; i < n; ++i) {
+            output[i] = static_cast<float>(output[i] * inv);
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#include "step_arena.hpp"
+#include <algorithm>
+
+namespace {
+    // Every allocation starts on a cache line, like owned Matrix storage.
+    constexpr std::size_t ARENA_ALIGNMENT = 64;
+
+    // The arena used by scratch_matrix on this thread, set by StepArena::Scope.
+    thread_local StepArena* active_arena = nullptr;
+}
+
+StepArena::Scope::Scope(StepArena& arena) : previous(active_arena) {
+    active_arena = &arena;
+}
+
+StepArena::Scope::~Scope() {
+    active_arena = previous;
+}
+
+StepArena::StepArena(std::size_t block_size)
+    : current(0), offset(0), block_size(std::max(block_size, ARENA_ALIGNMENT)), block_allocations(0) {}
+
+void* StepArena::allocate(std::size_t bytes) {
+    bytes = std::max<std::size_t>((bytes + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT, ARENA_ALIGNMENT);
+
+    // Move on to the next kept block if it can hold the request; otherwise insert a new
+    // block after the current one, so the blocks stay in the order a step uses them.
+    if (blocks.empty()) {
+        blocks.emplace_back(std::max(block_size, bytes));
+        ++block_allocations;
+    } else if (offset + bytes > blocks[current].size()) {
+        if (current + 1 >= blocks.size() || blocks[current + 1].size() < bytes) {
+            blocks.insert(blocks.begin() + current + 1, Block(std::max(block_size, bytes)));
+            ++block_allocations;
+        }
+        ++current;
+        offset = 0;
+    }
+
+    void* result = blocks[current].data() + offset;
+    offset += bytes;
+
+    return result;
+}
+
+void StepArena::reset() {
+    current = 0;
+    offset = 0;
+}
+
+std::size_t StepArena::used() const {
+    std::size_t total = offset;
+    for (std::size_t b = 0; b < current; ++b) {
+        total += blocks[b].size();
+    }
+
+    return total;
+}
+
+std::size_t StepArena::capacity() const {
+    std::size_t total = 0;
+    for (const Block& block : blocks) {
+        total += block.size();
+    }
+
+    return total;
+}
+
+std::size_t StepArena::getBlockAllocations() const {
+    return block_allocations;
+}
+
+StepArena* StepArena::active() {
+    return active_arena;
+}
@@ -0,0 +1,191 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <exception>
+
+namespace {
+    // Identifies the pool and deque owned by the current thread, if it is a worker.
+    thread_local const ThreadPool* current_pool = nullptr;
+    thread_local size_t current_index = 0;
+}
+
+ThreadPool::ThreadPool(size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < num_threads; ++i) {
+        queues.push_back(std::make_unique<TaskQueue>());
+    }
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        stopping = true;
+    }
+    task_available.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::size() const {
+    return workers.size();
+}
+
+bool ThreadPool::try_take(std::function<void()>& task) {
+    if (queued.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    const size_t n = queues.size();
+    size_t start = next_queue.load(std::memory_order_relaxed);
+    if (current_pool == this) {
+        TaskQueue& own = *queues[current_index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        start = current_index + 1;
+    }
+
+    for (size_t k = 0; k < n; ++k) {
+        TaskQueue& victim = *queues[(start + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::run_task(std::function<void()>& task) {
+    task();
+    task = nullptr;
+    if (unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        all_done.notify_all();
+    }
+}
+
+void ThreadPool::worker_loop(size_t index) {
+    current_pool = this;
+    current_index = index;
+
+    std::function<void()> task;
+    while (true) {
+        if (try_take(task)) {
+            run_task(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(state_mutex);
+        task_available.wait(lock, [this]() { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    unfinished.fetch_add(1, std::memory_order_relaxed);
+    const size_t index = current_pool == this ? current_index
+                                              : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    {
+        TaskQueue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+        queued.fetch_add(1, std::memory_order_release);
+    }
+
+    // Taking the state lock orders the increment before any worker's predicate check
+    { std::lock_guard<std::mutex> lock(state_mutex); }
+    task_available.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::function<void()> task;
+    while (unfinished.load() > 0) {
+        if (try_take(task)) {
+            run_task(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(state_mutex);
+        all_done.wait(lock, [this]() { return unfinished.load() == 0 || queued.load() > 0; });
+    }
+}
+
+void ThreadPool::parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body) {
+    if (begin >= end) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    const size_t chunks = (end - begin + grain - 1) / grain;
+
+    // Completion state for this call; remaining counts chunks handed to the pool
+    struct Join {
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t remaining;
+        std::exception_ptr error;
+    } join;
+    join.remaining = chunks - 1;
+
+    auto run_chunk = [&body, &join](size_t lo, size_t hi) {
+        try {
+            body(lo, hi);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(join.mutex);
+            if (!join.error) {
+                join.error = std::current_exception();
+            }
+        }
+    };
+
+    for (size_t c = 1; c < chunks; ++c) {
+        const size_t lo = begin + c * grain;
+        const size_t hi = std::min(end, lo + grain);
+        submit([&run_chunk, &join, lo, hi]() {
+            run_chunk(lo, hi);
+            std::lock_guard<std::mutex> lock(join.mutex);
+            if (--join.remaining == 0) {
+                join.done.notify_all();
+            }
+        });
+    }
+
+    // The caller runs the first chunk, then helps with whatever is still queued
+    run_chunk(begin, std::min(end, begin + grain));
+    std::function<void()> task;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(join.mutex);
+            if (join.remaining == 0) {
+                break;
+            }
+        }
+        if (try_take(task)) {
+            run_task(task);
+            continue;
+        }
+
+        // Every chunk has been taken by someone; wait for the ones still running
+        std::unique_lock<std::mutex> lock(join.mutex);
+        join.done.wait(lock, [&join]() { return join.remaining == 0; });
+        break;
+    }
+
+    if (join.error) {
+        std::rethrow_exception(join.error);
+    }
+}
@@ -10,6 +10,9 @@ namespace Utils {
         // Use a thread-local random engine and distribution for better performance and thread safety
         thread_local std::mt19937 gen(std::random_device{}());
         thread_local std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+        constexpr double INV_SQRT2 = 0.70710678118654752440;
+        constexpr double INV_SQRT_2PI = 0.39894228040143267794;
     }
 
     double sigmoid(double x) {
@@ -55,6 +58,25 @@ namespace Utils {
         return (x > 0) ? 1.0 : alpha;
     }
 
+    double gelu(double x) {
+        return 0.5 * x * (1.0 + std::erf(x * INV_SQRT2));
+    }
+
+    double gelu_derivative(double x) {
+        double cdf = 0.5 * (1.0 + std::erf(x * INV_SQRT2));
+        double pdf = INV_SQRT_2PI * std::exp(-0.5 * x * x);
+        return cdf + x * pdf;
+    }
+
+    double silu(double x) {
+        return x * sigmoid(x);
+    }
+
+    double silu_derivative(double x) {
+        double s = sigmoid(x);
+        return s * (1.0 + x * (1.0 - s));
+    }
+
     void softmax(std::vector<double>& input) {
         if (input.empty()) {
             return;
@@ -5,6 +5,8 @@
 #include "../include/utils.hpp"
 #include <vector>
 #include <functional>
+#include <stdexcept>
+#include <cmath>
 
 /**
  * @brief Tests for Activation layer functionality
@@ -178,5 +180,129 @@ TestFramework::TestSuite runActivationTests() {
         TestFramework::assertVectorDoubleEqual(output1, output2, 1e-10, "Cloned layer should produce the same output");
     });
 
+    // Test batched forward/backward against the per-sample path
+    suite.runTest("Activation Batch", []() {
+        Activation batchLayer(Utils::tanh, Utils::tanh_derivative);
+        Activation sampleLayer(Utils::tanh, Utils::tanh_derivative);
+
+        Matrix input(2, 3);
+        Matrix gradOutput(2, 3);
+        for (size_t k = 0; k < input.size(); ++k) {
+            input.data()[k] = -1.5 + 0.6 * k;
+            gradOutput.data()[k] = 0.1 * (k + 1);
+        }
+
+        Matrix output = batchLayer.forward_batch(input);
+        Matrix gradInput = batchLayer.backward_batch(gradOutput, 0.1);
+
+        for (size_t r = 0; r < input.rows(); ++r) {
+            std::vector<double> x(input.row(r), input.row(r) + input.cols());
+            std::vector<double> g(gradOutput.row(r), gradOutput.row(r) + gradOutput.cols());
+            std::vector<double> y = sampleLayer.forward(x);
+            std::vector<double> gin = sampleLayer.backward(g, 0.1);
+            TestFramework::assertVectorDoubleEqual(y, std::vector<double>(output.row(r), output.row(r) + output.cols()),
+                                                  1e-12, "Batch forward should match per-sample forward");
+            TestFramework::assertVectorDoubleEqual(gin, std::vector<double>(gradInput.row(r), gradInput.row(r) + gradInput.cols()),
+                                                  1e-12, "Batch backward should match per-sample backward");
+        }
+    });
+
+    // Test built-in kernels against the scalar Utils functions
+    suite.runTest("Built-in Activation Kernels", []() {
+        struct Case {
+            ActivationType type;
+            std::function<double(double)> f;
+            std::function<double(double)> df;
+        };
+        std::vector<Case> cases = {
+            {ActivationType::Sigmoid, Utils::sigmoid, Utils::sigmoid_derivative},
+            {ActivationType::ReLU, Utils::relu, Utils::relu_derivative},
+            {ActivationType::LeakyReLU, [](double x) { return Utils::leaky_relu(x, 0.01); },
+                                        [](double x) { return Utils::leaky_relu_derivative(x, 0.01); }},
+            {ActivationType::Tanh, Utils::tanh, Utils::tanh_derivative},
+            {ActivationType::GELU, Utils::gelu, Utils::gelu_derivative},
+            {ActivationType::SiLU, Utils::silu, Utils::silu_derivative},
+        };
+
+        std::vector<double> input = {-3.0, -1.5, -0.2, 0.0, 0.3, 1.0, 2.5, 6.0};
+        std::vector<double> gradOutput = {0.5, -1.0, 2.0, 0.25, 1.0, -0.5, 0.75, 1.5};
+
+        for (const auto& c : cases) {
+            Activation layer(c.type);
+            TestFramework::assertTrue(layer.getType() == c.type, "Layer should report its activation type");
+
+            std::vector<double> output = layer.forward(input);
+            std::vector<double> gradInput = layer.backward(gradOutput, 0.1);
+            for (size_t i = 0; i < input.size(); ++i) {
+                TestFramework::assertDoubleEqual(c.f(input[i]), output[i], 1e-12, "Kernel forward incorrect");
+                TestFramework::assertDoubleEqual(c.df(input[i]) * gradOutput[i], gradInput[i], 1e-12,
+                                                 "Kernel backward incorrect");
+            }
+        }
+
+        Activation leaky(ActivationType::LeakyReLU, 0.2);
+        TestFramework::assertDoubleEqual(-0.4, leaky.forward({-2.0})[0], 1e-12, "Leaky ReLU should use the given alpha");
+
+        TestFramework::assertThrows<std::invalid_argument>([]() {
+            Activation custom(ActivationType::Custom);
+        }, "Custom type without callables should throw");
+    });
+
+    // Test that Utils function pointers map to built-in kernels and other callables stay custom
+    suite.runTest("Activation Type Detection", []() {
+        Activation sigmoidLayer(Utils::sigmoid, Utils::sigmoid_derivative);
+        Activation reluLayer(Utils::relu, Utils::relu_derivative);
+        Activation tanhLayer(Utils::tanh, Utils::tanh_derivative);
+        TestFramework::assertTrue(sigmoidLayer.getType() == ActivationType::Sigmoid, "Utils::sigmoid should map to Sigmoid");
+        TestFramework::assertTrue(reluLayer.getType() == ActivationType::ReLU, "Utils::relu should map to ReLU");
+        TestFramework::assertTrue(tanhLayer.getType() == ActivationType::Tanh, "Utils::tanh should map to Tanh");
+
+        Activation custom([](double x) { return x * x; }, [](double x) { return 2.0 * x; });
+        TestFramework::assertTrue(custom.getType() == ActivationType::Custom, "Lambdas should use the custom path");
+        TestFramework::assertVectorDoubleEqual({4.0, 9.0}, custom.forward({2.0, -3.0}), 1e-12, "Custom forward incorrect");
+        TestFramework::assertVectorDoubleEqual({4.0, -6.0}, custom.backward({1.0, 1.0}, 0.1), 1e-12, "Custom backward incorrect");
+    });
+
+    // Test softmax forward and its Jacobian-vector product
+    suite.runTest("Softmax Activation", []() {
+        Activation softmax(ActivationType::Softmax);
+
+        std::vector<double> input = {1.0, 2.0, 0.5, -1.0};
+        std::vector<double> output = softmax.forward(input);
+
+        std::vector<double> expected = input;
+        Utils::softmax(expected);
+        TestFramework::assertVectorDoubleEqual(expected, output, 1e-12, "Softmax forward incorrect");
+
+        // Backward against central differences of L = dot(g, softmax(x))
+        std::vector<double> gradOutput = {0.3, -0.2, 1.0, 0.5};
+        std::vector<double> gradInput = softmax.backward(gradOutput, 0.1);
+        const double h = 1e-6;
+        for (size_t i = 0; i < input.size(); ++i) {
+            std::vector<double> plus = input;
+            std::vector<double> minus = input;
+            plus[i] += h;
+            minus[i] -= h;
+            Utils::softmax(plus);
+            Utils::softmax(minus);
+            double numeric = 0.0;
+            for (size_t j = 0; j < input.size(); ++j) {
+                numeric += gradOutput[j] * (plus[j] - minus[j]) / (2.0 * h);
+            }
+            TestFramework::assertDoubleEqual(numeric, gradInput[i], 1e-7, "Softmax backward incorrect");
+        }
+
+        // Batched softmax normalizes each row independently
+        Activation batchSoftmax(ActivationType::Softmax);
+        Matrix batch(2, 3);
+        batch(0, 0) = 1.0; batch(0, 1) = 2.0; batch(0, 2) = 3.0;
+        batch(1, 0) = -5.0; batch(1, 1) = 0.0; batch(1, 2) = 5.0;
+        Matrix batchOut = batchSoftmax.forward_batch(batch);
+        for (size_t r = 0; r < 2; ++r) {
+            double sum = batchOut(r, 0) + batchOut(r, 1) + batchOut(r, 2);
+            TestFramework::assertDoubleEqual(1.0, sum, 1e-12, "Each softmax row should sum to 1");
+        }
+    });
+
     return suite;
 }
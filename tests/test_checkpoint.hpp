@@ -0,0 +1,152 @@
+#pragma once
+
+#include "test_framework.hpp"
+#include "test_fixtures.hpp"
+#include "../include/checkpoint.hpp"
+#include "../include/dense.hpp"
+#include "../include/activation.hpp"
+#include "../include/loss.hpp"
+#include "../include/optimizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    /**
+     * @brief Asserts that two networks of the same shape hold bit-identical parameters and optimizer state
+     */
+    void checkSameTrainingState(const NeuralNet& expected, const NeuralNet& actual) {
+        assertSameParameters(expected, actual, 0.0, "Parameters should match exactly");
+        for (size_t l = 0; l < expected.getLayers().size(); ++l) {
+            const auto* a = dynamic_cast<const Dense*>(expected.getLayers()[l].get());
+            const auto* b = dynamic_cast<const Dense*>(actual.getLayers()[l].get());
+            if (a == nullptr) continue;
+            BasicOptimizerState<double> sa = a->getWeightOptimizer()->getState();
+            BasicOptimizerState<double> sb = b->getWeightOptimizer()->getState();
+            TestFramework::assertTrue(sa.buffers == sb.buffers && sa.step == sb.step, "Weight optimizer state should match exactly");
+            sa = a->getBiasOptimizer()->getState();
+            sb = b->getBiasOptimizer()->getState();
+            TestFramework::assertTrue(sa.buffers == sb.buffers && sa.step == sb.step, "Bias optimizer state should match exactly");
+        }
+    }
+}
+
+/**
+ * @brief Tests for training checkpoints
+ * @return TestSuite with the results
+ */
+TestFramework::TestSuite runCheckpointTests() {
+    TestFramework::TestSuite suite("Checkpoint");
+
+    suite.runTest("Restore Copies Parameters And Optimizer State", []() {
+        const std::string path = scratchPath("restore", ".ckpt");
+        const Adam adam(0.01);
+        std::vector<std::vector<double>> inputs;
+        std::vector<std::vector<double>> targets;
+        makeRegressionData(10, 4, inputs, targets);
+
+        NeuralNet net = makeRegressionNet(4, 6, 2, &adam);
+        net.train(inputs, targets, 2, 0.01);
+        net.save(path, 2);
+
+        NeuralNet restored = makeRegressionNet(4, 6, 2, &adam);
+        TestFramework::assertEqual(2, restored.restore(path), "Restore should return the recorded epoch");
+        checkSameTrainingState(net, restored);
+
+        // The mapped loader accepts files with optimizer state and ignores it
+        NeuralNet loaded;
+        loaded.load(path);
+        TestFramework::assertTrue(dynamic_cast<const Dense*>(loaded.getLayers()[0].get())->getWeightOptimizer() == nullptr,
+                                  "Loaded layers should start without an optimizer");
+
+        NeuralNet other;
+        other.addLayer(std::make_shared<Dense>(4, 5));
+        TestFramework::assertThrows<std::runtime_error>([&]() { other.restore(path); },
+                                                        "A network of another shape should be rejected");
+        TestFramework::assertEqual((size_t)5, other.getLayers()[0]->output_size(4), "A rejected restore should leave the network unchanged");
+        std::remove(path.c_str());
+    });
+
+    suite.runTest("Corrupt Optimizer State Leaves The Network Unchanged", []() {
+        const std::string path = scratchPath("corrupt_state", ".ckpt");
+        const Adam adam(0.01);
+        std::vector<std::vector<double>> inputs;
+        std::vector<std::vector<double>> targets;
+        makeRegressionData(10, 4, inputs, targets);
+
+        NeuralNet net = makeRegressionNet(4, 6, 2, &adam);
+        net.train(inputs, targets, 2, 0.01);
+        net.save(path, 2);
+
+        // Point the bias state of the last Dense layer (record 2, after the 64-byte
+        // header; field at byte 56 of the record) past the end of the file.
+        const std::uint64_t past_end = std::filesystem::file_size(path) + 64;
+        patchFile(path, 64 + 2 * 64 + 56, &past_end, sizeof(past_end));
+
+        NeuralNet fresh = makeRegressionNet(4, 6, 2, &adam);
+        NeuralNet before(fresh);
+        TestFramework::assertThrows<std::runtime_error>([&]() { fresh.restore(path); },
+                                                        "A corrupt optimizer state should be rejected");
+        checkSameTrainingState(before, fresh);
+        std::remove(path.c_str());
+    });
+
+    suite.runTest("Training Resumes Bit-Exactly", []() {
+        std::vector<std::vector<double>> inputs;
+        std::vector<std::vector<double>> targets;
+        makeRegressionData(10, 4, inputs, targets);
+
+        const size_t batch_sizes[] = {1, 4};
+        std::vector<std::unique_ptr<Optimizer>> optimizers;
+        optimizers.push_back(std::make_unique<Adam>(0.01));
+        optimizers.push_back(std::make_unique<SGD>(0.05, 0.9));
+
+        for (size_t c = 0; c < optimizers.size(); ++c) {
+            const std::string path = scratchPath("resume_" + std::to_string(c), ".ckpt");
+            std::remove(path.c_str());
+            NeuralNet interrupted = makeRegressionNet(4, 6, 2, optimizers[c].get());
+            NeuralNet uninterrupted(interrupted);
+
+            uninterrupted.train(inputs, targets, 6, 0.05, batch_sizes[c]);
+            {
+                Checkpointer checkpointer(path, 2);
+                TestFramework::assertFalse(checkpointer.restore(interrupted), "No checkpoint should exist yet");
+                interrupted.train(inputs, targets, 3, 0.05, batch_sizes[c], 1, &checkpointer);
+                checkpointer.wait();
+                TestFramework::assertEqual(3, checkpointer.getEpoch(), "The last epoch should always be checkpointed");
+            }
+
+            // A new process rebuilds the network with fresh random weights and resumes
+            NeuralNet resumed = makeRegressionNet(4, 6, 2, optimizers[c].get());
+            Checkpointer checkpointer(path, 2);
+            TestFramework::assertTrue(checkpointer.restore(resumed), "The checkpoint should be restored");
+            TestFramework::assertEqual(3, checkpointer.getEpoch(), "Training should resume after epoch 3");
+            resumed.train(inputs, targets, 6, 0.05, batch_sizes[c], 1, &checkpointer);
+            checkpointer.wait();
+
+            checkSameTrainingState(uninterrupted, resumed);
+            std::remove(path.c_str());
+        }
+    });
+
+    suite.runTest("Checkpointer Reports Write Errors", []() {
+        const SGD sgd(0.1);
+        NeuralNet net = makeRegressionNet(4, 6, 2, &sgd);
+        Checkpointer checkpointer((std::filesystem::temp_directory_path() / "neuroplus_missing_dir" / "x.ckpt").string());
+        checkpointer.save(net, 1);
+        TestFramework::assertThrows<std::runtime_error>([&]() { checkpointer.wait(); },
+                                                        "A failed background write should surface on wait");
+        checkpointer.wait();
+
+        TestFramework::assertThrows<std::invalid_argument>([&]() { Checkpointer bad("unused", 0); },
+                                                           "Interval must be positive");
+    });
+
+    return suite;
+}
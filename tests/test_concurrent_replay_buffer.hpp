@@ -0,0 +1,149 @@
+#pragma once
+
+#include "test_framework.hpp"
+#include "../include/concurrent_replay_buffer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Puts slots of a ConcurrentReplayBuffer into states that only arise inside a push
+ */
+struct ConcurrentReplayBufferProbe {
+    /**
+     * @brief Makes a slot look like an actor is still writing it
+     */
+    static void begin_write(ConcurrentReplayBuffer& buffer, size_t slot) {
+        buffer.versions[slot].fetch_add(1);
+    }
+
+    /**
+     * @brief Finishes the write begun by begin_write
+     */
+    static void end_write(ConcurrentReplayBuffer& buffer, size_t slot) {
+        buffer.versions[slot].fetch_sub(1);
+    }
+};
+
+/**
+ * @brief Tests for the multi-producer replay buffer
+ * @return TestSuite with the results
+ */
+TestFramework::TestSuite runConcurrentReplayBufferTests() {
+    TestFramework::TestSuite suite("ConcurrentReplayBuffer");
+
+    // Actors push while the learner samples; no transition is lost, torn or duplicated
+    suite.runTest("Concurrent Push And Sample", []() {
+        const int producers = 4;
+        const int pushes = 5000;
+        ConcurrentReplayBuffer buffer(producers * pushes, 2);
+
+        std::atomic<int> running{producers};
+        std::vector<std::thread> actors;
+        for (int p = 0; p < producers; ++p) {
+            actors.emplace_back([&buffer, &running, p, pushes]() {
+                for (int seq = 0; seq < pushes; ++seq) {
+                    buffer.push(std::vector<double>{(double)p, (double)seq}, p, (double)seq,
+                                std::vector<double>{(double)p, seq + 1.0}, seq % 7 == 0);
+                }
+                running--;
+            });
+        }
+
+        // Every transition in every batch must be one that was pushed whole
+        ReplayBatch batch;
+        bool consistent = true;
+        while (running > 0) {
+            if (!buffer.is_ready(16)) {
+                continue;
+            }
+            buffer.sample(16, batch);
+            for (size_t r = 0; r < 16; ++r) {
+                const double seq = batch.states(r, 1);
+                consistent = consistent && batch.states(r, 0) == batch.actions[r] && batch.rewards[r] == seq &&
+                             batch.next_states(r, 0) == batch.actions[r] && batch.next_states(r, 1) == seq + 1.0 &&
+                             batch.dones[r] == (((int)seq % 7 == 0) ? 1 : 0);
+            }
+        }
+        for (std::thread& actor : actors) {
+            actor.join();
+        }
+        TestFramework::assertTrue(consistent, "Sampled transitions should never be torn");
+
+        // Drawing the whole buffer shows every push exactly once, in slot order per producer
+        TestFramework::assertEqual((size_t)(producers * pushes), buffer.size(), "No transition should be lost");
+        buffer.sample(producers * pushes, batch);
+        std::vector<int> seq_at(producers * pushes, -1);
+        std::vector<int> producer_at(producers * pushes, -1);
+        for (size_t r = 0; r < batch.actions.size(); ++r) {
+            seq_at[batch.indices[r]] = (int)batch.states(r, 1);
+            producer_at[batch.indices[r]] = batch.actions[r];
+        }
+        std::vector<int> next(producers, 0);
+        for (size_t slot = 0; slot < seq_at.size(); ++slot) {
+            const int p = producer_at[slot];
+            consistent = consistent && p >= 0 && seq_at[slot] == next[p];
+            if (p >= 0) {
+                next[p]++;
+            }
+        }
+        TestFramework::assertTrue(consistent, "Each producer's transitions should be stored once and in order");
+    });
+
+    // A full buffer overwrites its oldest transitions, like ReplayBuffer
+    suite.runTest("Concurrent Overwrite And Validation", []() {
+        ConcurrentReplayBuffer buffer(4, 1);
+        for (int i = 0; i < 10; ++i) {
+            buffer.push(std::vector<double>{(double)i}, i, 0.0, std::vector<double>{0.0}, false);
+        }
+        TestFramework::assertEqual((size_t)4, buffer.size(), "Size should be capped at the capacity");
+
+        ReplayBatch batch;
+        buffer.sample(4, batch);
+        std::vector<int> actions(batch.actions.begin(), batch.actions.end());
+        std::sort(actions.begin(), actions.end());
+        TestFramework::assertTrue(actions == std::vector<int>{6, 7, 8, 9}, "Only the newest transitions should be kept");
+        for (size_t r = 0; r < 4; ++r) {
+            TestFramework::assertEqual(batch.actions[r] % 4, (int)batch.indices[r], "Transitions should fill the slots in push order");
+        }
+
+        TestFramework::assertThrows<std::runtime_error>([&]() { buffer.sample(5, batch); },
+                                                        "Sampling more than stored should throw");
+        TestFramework::assertThrows<std::invalid_argument>(
+            [&]() { buffer.push(std::vector<double>{1.0, 2.0}, 0, 0.0, std::vector<double>{1.0, 2.0}, false); },
+            "A different state size should be rejected");
+        TestFramework::assertThrows<std::invalid_argument>([]() { ConcurrentReplayBuffer empty(4, 0); },
+                                                           "A zero state size should be rejected");
+    });
+
+    // Sampling still returns when most of the window is mid-write and every draw is likely rejected
+    suite.runTest("Sampling Around Slots In Flight", []() {
+        ConcurrentReplayBuffer buffer(64, 1);
+        for (int i = 0; i < 64; ++i) {
+            buffer.push(std::vector<double>{(double)i}, i, 0.0, std::vector<double>{0.0}, false);
+        }
+        for (size_t slot = 3; slot < 64; ++slot) {
+            ConcurrentReplayBufferProbe::begin_write(buffer, slot);
+        }
+
+        ReplayBatch batch;
+        for (int round = 0; round < 200; ++round) {
+            buffer.sample(1, batch);
+            TestFramework::assertTrue(batch.indices[0] < 3, "Only finished slots should be sampled");
+        }
+        buffer.sample(3, batch);
+        std::vector<int> actions(batch.actions.begin(), batch.actions.end());
+        std::sort(actions.begin(), actions.end());
+        TestFramework::assertTrue(actions == std::vector<int>{0, 1, 2}, "A batch of every finished slot should be found");
+
+        for (size_t slot = 3; slot < 64; ++slot) {
+            ConcurrentReplayBufferProbe::end_write(buffer, slot);
+        }
+        buffer.sample(64, batch);
+        TestFramework::assertEqual((size_t)64, batch.actions.size(), "Finished writes should be sampled again");
+    });
+
+    return suite;
+}
@@ -5,6 +5,17 @@
 #include "../include/optimizer.hpp"
 #include <vector>
 #include <memory>
+#include <stdexcept>
+#include <cmath>
+
+namespace {
+
+std::vector<double> denseBiases(const Dense& layer) {
+    Span<const double> biases = layer.getBiases();
+    return std::vector<double>(biases.begin(), biases.end());
+}
+
+}
 
 /**
  * @brief Tests for Dense layer functionality
@@ -55,6 +66,27 @@ TestFramework::TestSuite runDenseTests() {
         TestFramework::assertEqual(1, (int)output.size(), "Output size should be 1");
     });
 
+    // Test Dense layer forward pass with known weights
+    suite.runTest("Dense Forward Pass With Known Weights", []() {
+        Dense layer(3, 2);
+
+        Matrix weights(2, 3);
+        weights(0, 0) = 0.5;  weights(0, 1) = -0.5; weights(0, 2) = 1.0;
+        weights(1, 0) = 2.0;  weights(1, 1) = 0.0;  weights(1, 2) = -1.0;
+        layer.setWeights(weights);
+        layer.setBiases(std::vector<double>{0.1, -0.2});
+
+        std::vector<double> input = {1.0, 2.0, 3.0};
+        std::vector<double> output = layer.forward(input);
+
+        std::vector<double> expected = {0.5 - 1.0 + 3.0 + 0.1, 2.0 - 3.0 - 0.2};
+        TestFramework::assertVectorDoubleEqual(expected, output, 1e-12, "Dense forward pass incorrect");
+
+        TestFramework::assertThrows<std::invalid_argument>([&layer]() {
+            layer.setWeights(Matrix(3, 2));
+        }, "setWeights should reject a matrix of the wrong shape");
+    });
+
     // Test Dense layer backward pass without optimizer
     suite.runTest("Dense Backward Pass (No Optimizer)", []() {
         // Create a dense layer with 2 inputs and 1 output
@@ -174,5 +206,245 @@ TestFramework::TestSuite runDenseTests() {
                                               "Identical layers should produce identical outputs");
     });
 
+    // Test batched forward against the per-sample path
+    suite.runTest("Dense Forward Batch", []() {
+        Dense layer(4, 3);
+
+        Matrix input(5, 4);
+        for (size_t k = 0; k < input.size(); ++k) {
+            input.data()[k] = 0.25 * k - 2.0;
+        }
+
+        Matrix output = layer.forward_batch(input);
+        TestFramework::assertEqual((size_t)5, output.rows(), "Batch output should have one row per sample");
+        TestFramework::assertEqual((size_t)3, output.cols(), "Batch output width should be the layer output size");
+
+        for (size_t r = 0; r < input.rows(); ++r) {
+            std::vector<double> x(input.row(r), input.row(r) + input.cols());
+            std::vector<double> y = layer.forward(x);
+            TestFramework::assertVectorDoubleEqual(y, std::vector<double>(output.row(r), output.row(r) + output.cols()),
+                                                  1e-12, "Batch forward should match per-sample forward");
+        }
+
+        TestFramework::assertThrows<std::invalid_argument>([&layer]() {
+            layer.forward_batch(Matrix(2, 3));
+        }, "Batch with the wrong width should throw");
+    });
+
+    // Test batched backward: one update using gradients summed over the batch
+    suite.runTest("Dense Backward Batch", []() {
+        Dense layer(2, 2);
+        Matrix weights(2, 2);
+        weights(0, 0) = 0.5;  weights(0, 1) = -0.25;
+        weights(1, 0) = 1.0;  weights(1, 1) = 0.75;
+        layer.setWeights(weights);
+        layer.setBiases(std::vector<double>{0.1, -0.1});
+
+        Matrix input(2, 2);
+        input(0, 0) = 1.0; input(0, 1) = 2.0;
+        input(1, 0) = -1.0; input(1, 1) = 0.5;
+        Matrix gradOutput(2, 2);
+        gradOutput(0, 0) = 0.2; gradOutput(0, 1) = -0.4;
+        gradOutput(1, 0) = 0.6; gradOutput(1, 1) = 0.1;
+
+        const double lr = 0.1;
+        layer.forward_batch(input);
+        Matrix gradInput = layer.backward_batch(gradOutput, lr);
+
+        // grad_input = G * W (computed with the weights before the update)
+        for (size_t r = 0; r < 2; ++r) {
+            for (size_t j = 0; j < 2; ++j) {
+                double expected = gradOutput(r, 0) * weights(0, j) + gradOutput(r, 1) * weights(1, j);
+                TestFramework::assertDoubleEqual(expected, gradInput(r, j), 1e-12, "Batch input gradient incorrect");
+            }
+        }
+
+        // W -= lr * G^T * X, b -= lr * sum_rows(G)
+        const Matrix& updated = layer.getWeights();
+        for (size_t i = 0; i < 2; ++i) {
+            for (size_t j = 0; j < 2; ++j) {
+                double dw = gradOutput(0, i) * input(0, j) + gradOutput(1, i) * input(1, j);
+                TestFramework::assertDoubleEqual(weights(i, j) - lr * dw, updated(i, j), 1e-12, "Batch weight update incorrect");
+            }
+        }
+        TestFramework::assertDoubleEqual(0.1 - lr * 0.8, layer.getBiases()[0], 1e-12, "Batch bias update incorrect");
+        TestFramework::assertDoubleEqual(-0.1 - lr * -0.3, layer.getBiases()[1], 1e-12, "Batch bias update incorrect");
+    });
+
+    // Test that an optimizer updates the layer's own weights and biases
+    suite.runTest("Dense Optimizer Updates Parameters In Place", []() {
+        Dense layer(3, 2);
+        Matrix weights(2, 3);
+        for (size_t k = 0; k < weights.size(); ++k) {
+            weights.data()[k] = 0.1 * (double)k - 0.2;
+        }
+        layer.setWeights(weights);
+        layer.setBiases(std::vector<double>{0.5, -0.5});
+        layer.setOptimizer(std::make_unique<SGD>(0.1, 0.0));
+
+        std::vector<double> input = {1.0, -2.0, 0.5};
+        std::vector<double> grad_output = {0.3, -0.6};
+        const double* storage = layer.getWeights().data();
+
+        // Two steps: the second reuses the optimizer state and gradient scratch
+        for (int step = 0; step < 2; ++step) {
+            layer.forward(input);
+            layer.backward(grad_output, 1.0);
+            for (size_t i = 0; i < 2; ++i) {
+                for (size_t j = 0; j < 3; ++j) {
+                    weights(i, j) -= 0.1 * grad_output[i] * input[j];
+                }
+            }
+        }
+
+        TestFramework::assertTrue(layer.getWeights().data() == storage, "Weights should be updated in place");
+        TestFramework::assertVectorDoubleEqual(std::vector<double>(weights.data(), weights.data() + weights.size()),
+                                              std::vector<double>(layer.getWeights().data(), layer.getWeights().data() + 6),
+                                              1e-12, "Optimizer weight update incorrect");
+        TestFramework::assertVectorDoubleEqual({0.5 - 0.06, -0.5 + 0.12}, denseBiases(layer), 1e-12,
+                                              "Optimizer bias update incorrect");
+    });
+
+    // Test the fused single-pass backward against separate gradient and update passes
+    suite.runTest("Dense Fused Backward Matches Reference", []() {
+        // Wider than one fused segment so rows are updated in several slices
+        const size_t in = 300;
+        const size_t out = 3;
+
+        std::vector<std::unique_ptr<Optimizer>> optimizers;
+        optimizers.push_back(std::make_unique<SGD>(0.05, 0.9));
+        optimizers.push_back(std::make_unique<Adam>(0.01));
+
+        for (const auto& prototype : optimizers) {
+            Dense layer(in, out);
+            layer.setOptimizer(prototype->clone());
+
+            Matrix weights = layer.getWeights();
+            std::vector<double> biases = denseBiases(layer);
+            std::unique_ptr<Optimizer> weight_opt = prototype->clone();
+            std::unique_ptr<Optimizer> bias_opt = prototype->clone();
+
+            std::vector<double> input(in);
+            for (size_t j = 0; j < in; ++j) {
+                input[j] = std::sin(0.1 * (double)j);
+            }
+            std::vector<double> grad_output = {0.5, -0.25, 1.0};
+
+            for (int step = 0; step < 3; ++step) {
+                layer.forward(input);
+                std::vector<double> grad_input = layer.backward(grad_output, 1.0);
+
+                std::vector<double> expected_grad_input(in, 0.0);
+                std::vector<double> weight_gradients(out * in);
+                for (size_t i = 0; i < out; ++i) {
+                    for (size_t j = 0; j < in; ++j) {
+                        expected_grad_input[j] += weights(i, j) * grad_output[i];
+                        weight_gradients[i * in + j] = grad_output[i] * input[j];
+                    }
+                }
+                weight_opt->update(Span<double>(weights.data(), weights.size()), weight_gradients);
+                bias_opt->update(biases, grad_output);
+
+                TestFramework::assertVectorDoubleEqual(expected_grad_input, grad_input, 1e-12,
+                                                      "Fused input gradient incorrect");
+            }
+
+            TestFramework::assertVectorDoubleEqual(std::vector<double>(weights.data(), weights.data() + weights.size()),
+                                                  std::vector<double>(layer.getWeights().data(), layer.getWeights().data() + weights.size()),
+                                                  1e-12, "Fused weight update incorrect");
+            TestFramework::assertVectorDoubleEqual(biases, denseBiases(layer), 1e-12, "Fused bias update incorrect");
+        }
+    });
+
+    // Splitting backward_batch into compute and apply gives the same result
+    suite.runTest("Dense Compute And Apply Gradients", []() {
+        Dense layer(3, 2);
+        auto copy = layer.clone();
+        Dense* split = dynamic_cast<Dense*>(copy.get());
+
+        Matrix input(4, 3);
+        Matrix grad_output(4, 2);
+        for (size_t k = 0; k < input.size(); ++k) input.data()[k] = std::sin(0.5 * (double)k);
+        for (size_t k = 0; k < grad_output.size(); ++k) grad_output.data()[k] = std::cos(0.3 * (double)k);
+
+        layer.forward_batch(input);
+        Matrix expected = layer.backward_batch(grad_output, 0.1);
+
+        TestFramework::assertEqual(size_t(8), split->parameter_count(), "Parameter count should be weights plus biases");
+        std::vector<double> gradients(split->parameter_count());
+        split->forward_batch(input);
+        Matrix grad_input = split->compute_gradients(grad_output, gradients);
+        split->apply_gradients(gradients, 0.1);
+
+        for (size_t k = 0; k < expected.size(); ++k) {
+            TestFramework::assertDoubleEqual(expected.data()[k], grad_input.data()[k], 1e-12, "Input gradient incorrect");
+        }
+        for (size_t k = 0; k < 6; ++k) {
+            TestFramework::assertDoubleEqual(layer.getWeights().data()[k], split->getWeights().data()[k], 1e-12,
+                                             "Weights after apply_gradients incorrect");
+        }
+        TestFramework::assertVectorDoubleEqual(denseBiases(layer), denseBiases(*split), 1e-12, "Biases after apply_gradients incorrect");
+
+        Dense other(3, 2);
+        other.copy_parameters_from(layer);
+        TestFramework::assertVectorDoubleEqual(denseBiases(layer), denseBiases(other), 0.0, "copy_parameters_from should copy biases");
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            Dense(2, 2).copy_parameters_from(layer);
+        }, "Copying from a different shape should throw");
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            std::vector<double> wrong(3);
+            split->compute_gradients(grad_output, wrong);
+        }, "A wrong gradient buffer size should throw");
+    });
+
+    // accumulate_gradients adds to the buffer instead of overwriting it
+    suite.runTest("Dense Accumulate Gradients", []() {
+        Dense layer(3, 2);
+        Matrix input(4, 3);
+        Matrix grad_output(4, 2);
+        for (size_t k = 0; k < input.size(); ++k) input.data()[k] = std::sin(0.7 * (double)k);
+        for (size_t k = 0; k < grad_output.size(); ++k) grad_output.data()[k] = std::cos(0.2 * (double)k);
+
+        layer.forward_batch(input);
+        std::vector<double> once(layer.parameter_count(), 5.0);
+        layer.compute_gradients(grad_output, once);
+        std::vector<double> twice(layer.parameter_count(), 0.0);
+        layer.accumulate_gradients(grad_output, twice);
+        Matrix grad_input = layer.accumulate_gradients(grad_output, twice);
+        Matrix expected = layer.compute_gradients(grad_output, once);
+
+        for (size_t k = 0; k < once.size(); ++k) {
+            TestFramework::assertDoubleEqual(2.0 * once[k], twice[k], 1e-12, "Accumulated gradients should add up");
+        }
+        for (size_t k = 0; k < expected.size(); ++k) {
+            TestFramework::assertDoubleEqual(expected.data()[k], grad_input.data()[k], 1e-12, "Input gradient incorrect");
+        }
+    });
+
+    // The stateless Hogwild backward matches the regular SGD backward on one thread
+    suite.runTest("Dense Hogwild Backward Matches Backward", []() {
+        Dense layer(5, 3);
+        auto copy = layer.clone();
+        Dense* hogwild = dynamic_cast<Dense*>(copy.get());
+
+        std::vector<double> input = {0.5, -1.0, 0.25, 2.0, -0.75};
+        std::vector<double> grad_output = {0.2, 0.0, -0.4};
+
+        std::vector<double> expected_output = layer.forward(input);
+        std::vector<double> output(3);
+        hogwild->forward_hogwild(input, output);
+        TestFramework::assertVectorDoubleEqual(expected_output, output, 1e-12, "Hogwild forward incorrect");
+
+        std::vector<double> expected = layer.backward(grad_output, 0.1);
+        std::vector<double> grad_input(5, 99.0);
+        hogwild->backward_hogwild(input, grad_output, grad_input, 0.1);
+        TestFramework::assertVectorDoubleEqual(expected, grad_input, 1e-12, "Hogwild input gradient incorrect");
+        TestFramework::assertVectorDoubleEqual(denseBiases(layer), denseBiases(*hogwild), 1e-12, "Hogwild bias update incorrect");
+        for (size_t k = 0; k < layer.getWeights().size(); ++k) {
+            TestFramework::assertDoubleEqual(layer.getWeights().data()[k], hogwild->getWeights().data()[k], 1e-12,
+                                             "Hogwild weight update incorrect");
+        }
+    });
+
     return suite;
 }
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "test_framework.hpp"
+#include "../include/neuralnet.hpp"
+#include "../include/dense.hpp"
+#include "../include/activation.hpp"
+#include "../include/loss.hpp"
+#include "../include/optimizer.hpp"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    /**
+     * @brief Returns a path for a scratch file in the system temporary directory
+     */
+    std::string scratchPath(const std::string& name, const std::string& extension) {
+        return (std::filesystem::temp_directory_path() / ("neuroplus_" + name + extension)).string();
+    }
+
+    /**
+     * @brief Overwrites bytes of a file in place
+     */
+    void patchFile(const std::string& path, std::streamoff offset, const void* bytes, size_t count) {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(offset);
+        file.write(static_cast<const char*>(bytes), (std::streamsize)count);
+    }
+
+    /**
+     * @brief Builds an inputs -> hidden -> outputs Dense-Tanh-Dense network with an MSE loss
+     *
+     * With an optimizer, each Dense layer gets its own copy.
+     */
+    NeuralNet makeRegressionNet(size_t inputs, size_t hidden, size_t outputs, const Optimizer* optimizer = nullptr) {
+        NeuralNet net;
+        auto first = std::make_shared<Dense>(inputs, hidden);
+        auto second = std::make_shared<Dense>(hidden, outputs);
+        if (optimizer != nullptr) {
+            first->setOptimizer(optimizer->clone());
+            second->setOptimizer(optimizer->clone());
+        }
+        net.addLayer(first);
+        net.addLayer(std::make_shared<Activation>(ActivationType::Tanh));
+        net.addLayer(second);
+        net.setLoss(std::make_shared<MSELoss>());
+        return net;
+    }
+
+    /**
+     * @brief Deterministic regression samples with input_size (at least 3) inputs and 2 targets
+     */
+    void makeRegressionData(size_t samples, size_t input_size, std::vector<std::vector<double>>& inputs,
+                            std::vector<std::vector<double>>& targets) {
+        for (size_t s = 0; s < samples; ++s) {
+            std::vector<double> x(input_size);
+            for (size_t i = 0; i < x.size(); ++i) x[i] = std::sin(0.7 * (double)(s * input_size + i));
+            inputs.push_back(x);
+            targets.push_back({0.5 * x[0] - 0.2 * x[input_size - 1], 0.3 * x[1] * x[2]});
+        }
+    }
+
+    /**
+     * @brief Asserts that the Dense layers of two networks of the same shape hold the same parameters
+     *
+     * A tolerance of 0 requires them to match exactly.
+     */
+    void assertSameParameters(const NeuralNet& expected, const NeuralNet& actual, double tolerance, const std::string& message) {
+        for (size_t l = 0; l < expected.getLayers().size(); ++l) {
+            const auto* e = dynamic_cast<const Dense*>(expected.getLayers()[l].get());
+            const auto* a = dynamic_cast<const Dense*>(actual.getLayers()[l].get());
+            if (e == nullptr) {
+                continue;
+            }
+            for (size_t k = 0; k < e->getWeights().size(); ++k) {
+                TestFramework::assertDoubleEqual(e->getWeights().data()[k], a->getWeights().data()[k], tolerance, message);
+            }
+            for (size_t k = 0; k < e->getBiases().size(); ++k) {
+                TestFramework::assertDoubleEqual(e->getBiases()[k], a->getBiases()[k], tolerance, message);
+            }
+        }
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "test_framework.hpp"
+#include "../include/frame_replay_buffer.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    /**
+     * @brief Pushes an episode whose observations are {start, start + 1, ...} and whose step t has action start + t and reward t + 1
+     */
+    void pushFrameEpisode(FrameReplayBuffer& buffer, int start, int steps, bool done) {
+        for (int t = 0; t < steps; ++t) {
+            buffer.push(std::vector<double>{(double)(start + t)}, start + t, t + 1.0,
+                        std::vector<double>{(double)(start + t + 1)}, done && t == steps - 1);
+        }
+    }
+}
+
+/**
+ * @brief Tests for frame-deduplicated n-step replay
+ * @return TestSuite with the results
+ */
+TestFramework::TestSuite runFrameReplayBufferTests() {
+    TestFramework::TestSuite suite("FrameReplayBuffer");
+
+    // Consecutive steps share frames and one-step batches match the pushed transitions
+    suite.runTest("Frames Are Shared Within Episodes", []() {
+        FrameReplayBuffer buffer(16, 1, 1, 0.9);
+        pushFrameEpisode(buffer, 0, 5, true);
+        pushFrameEpisode(buffer, 100, 3, false);
+        TestFramework::assertEqual((size_t)8, buffer.size(), "Every push should add a transition");
+        TestFramework::assertEqual((size_t)10, buffer.getFrameCount(), "Each episode should take one frame more than its steps");
+
+        ReplayBatch batch;
+        buffer.sample(8, batch);
+        for (size_t r = 0; r < 8; ++r) {
+            const int action = batch.actions[r];
+            const bool last = action == 4;
+            TestFramework::assertDoubleEqual(action, batch.states(r, 0), 0.0, "State should be the sampled frame");
+            TestFramework::assertDoubleEqual(action + 1.0, batch.next_states(r, 0), 0.0, "Next state should be the following frame");
+            TestFramework::assertDoubleEqual((action % 100) + 1.0, batch.rewards[r], 0.0, "One-step reward should be the step's reward");
+            TestFramework::assertEqual(last ? 1 : 0, (int)batch.dones[r], "Only the last step of the first episode is done");
+            TestFramework::assertDoubleEqual(last ? 0.0 : 0.9, batch.discounts[r], 1e-12, "Discount should be gamma, or 0 after a done");
+        }
+        TestFramework::assertThrows<std::runtime_error>([&]() { buffer.sample(9, batch); },
+                                                        "Sampling more than stored should throw");
+    });
+
+    // Returns are summed at sample time and stop at a done or at the end of the stored episode
+    suite.runTest("N-Step Returns", []() {
+        FrameReplayBuffer buffer(16, 1, 3, 0.5);
+        pushFrameEpisode(buffer, 0, 4, true);
+        pushFrameEpisode(buffer, 100, 2, false);
+
+        // Action, return, discount and next observation of every transition
+        const double expected[][4] = {
+            {0, 1.0 + 0.5 * 2.0 + 0.25 * 3.0, 0.125, 3.0}, {1, 2.0 + 0.5 * 3.0 + 0.25 * 4.0, 0.0, 4.0},
+            {2, 3.0 + 0.5 * 4.0, 0.0, 4.0},                {3, 4.0, 0.0, 4.0},
+            {100, 1.0 + 0.5 * 2.0, 0.25, 102.0},           {101, 2.0, 0.5, 102.0}};
+
+        ReplayBatch batch;
+        buffer.sample(6, batch);
+        for (size_t r = 0; r < 6; ++r) {
+            const int action = batch.actions[r];
+            for (const auto& row : expected) {
+                if ((int)row[0] != action) {
+                    continue;
+                }
+                TestFramework::assertDoubleEqual(row[1], batch.rewards[r], 1e-12, "Reward should be the discounted n-step return");
+                TestFramework::assertDoubleEqual(row[2], batch.discounts[r], 1e-12, "Discount should cover the steps summed");
+                TestFramework::assertDoubleEqual(row[3], batch.next_states(r, 0), 0.0, "Next state should follow the last step summed");
+            }
+            TestFramework::assertEqual(action < 100 && action > 0 ? 1 : 0, (int)batch.dones[r],
+                                       "Returns that reach the done should be done");
+        }
+    });
+
+    // Overwriting the oldest frames drops their steps without breaking newer episodes
+    suite.runTest("Frames Wrap Around", []() {
+        FrameReplayBuffer buffer(6, 1, 2, 1.0);
+        pushFrameEpisode(buffer, 0, 3, true);
+        pushFrameEpisode(buffer, 10, 4, false);
+        TestFramework::assertEqual((size_t)6, buffer.getFrameCount(), "Frames should be capped at the capacity");
+        TestFramework::assertEqual((size_t)4, buffer.size(), "Only the steps of the surviving frames should remain");
+
+        ReplayBatch batch;
+        buffer.sample(4, batch);
+        for (size_t r = 0; r < 4; ++r) {
+            const int action = batch.actions[r];
+            TestFramework::assertTrue(action >= 10 && action <= 13, "Only the newest episode should survive");
+            TestFramework::assertDoubleEqual(std::min(action + 2, 14), batch.next_states(r, 0), 0.0,
+                                             "N-step next states should stay inside the episode");
+        }
+
+        TestFramework::assertThrows<std::invalid_argument>([]() { FrameReplayBuffer tiny(1, 1); },
+                                                           "A single frame should be rejected");
+        TestFramework::assertThrows<std::invalid_argument>([]() { FrameReplayBuffer none(8, 1, 0); },
+                                                           "Zero steps should be rejected");
+        TestFramework::assertThrows<std::invalid_argument>([&]() { buffer.push({{1.0, 2.0}, 0, 0.0, {1.0, 2.0}, false}); },
+                                                           "A different state size should be rejected");
+    });
+
+    return suite;
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "test_framework.hpp"
+#include "../include/gemm.hpp"
+#include "../include/matrix.hpp"
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include <cstdint>
+
+namespace {
+    /**
+     * @brief Fills a matrix with deterministic values in [-1, 1]
+     */
+    void fillPattern(Matrix& m, unsigned seed) {
+        for (size_t k = 0; k < m.size(); ++k) {
+            m.data()[k] = std::sin(0.37 * (double)(k + 1) * (double)seed);
+        }
+    }
+
+    /**
+     * @brief Reference C = alpha * op(A) * op(B) + beta * C using a plain triple loop
+     */
+    void referenceGemm(bool ta, bool tb, double alpha, const Matrix& a, const Matrix& b, double beta, Matrix& c) {
+        const size_t k = ta ? a.rows() : a.cols();
+        for (size_t i = 0; i < c.rows(); ++i) {
+            for (size_t j = 0; j < c.cols(); ++j) {
+                double sum = 0.0;
+                for (size_t p = 0; p < k; ++p) {
+                    double aip = ta ? a(p, i) : a(i, p);
+                    double bpj = tb ? b(j, p) : b(p, j);
+                    sum += aip * bpj;
+                }
+                c(i, j) = alpha * sum + beta * c(i, j);
+            }
+        }
+    }
+
+    /**
+     * @brief Checks gemm against the reference for one shape and transpose combination
+     */
+    void checkGemm(bool ta, bool tb, size_t m, size_t n, size_t k, double alpha, double beta) {
+        Matrix a(ta ? k : m, ta ? m : k);
+        Matrix b(tb ? n : k, tb ? k : n);
+        Matrix c(m, n);
+        fillPattern(a, 1);
+        fillPattern(b, 2);
+        fillPattern(c, 3);
+        Matrix expected = c;
+
+        referenceGemm(ta, tb, alpha, a, b, beta, expected);
+        Gemm::gemm(ta ? Gemm::Transpose::Yes : Gemm::Transpose::No, tb ? Gemm::Transpose::Yes : Gemm::Transpose::No,
+                   alpha, a.view(), b.view(), beta, c.view());
+
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                TestFramework::assertDoubleEqual(expected(i, j), c(i, j), 1e-9 * (double)k,
+                                                 "gemm result differs from reference");
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tests for Gemm functionality
+ * @return TestSuite with the results
+ */
+TestFramework::TestSuite runGemmTests() {
+    TestFramework::TestSuite suite("Gemm");
+
+    // Small shapes take the unblocked path
+    suite.runTest("GEMM Small Shapes", []() {
+        for (int ta = 0; ta < 2; ++ta) {
+            for (int tb = 0; tb < 2; ++tb) {
+                checkGemm(ta, tb, 3, 5, 7, 1.0, 0.0);
+                checkGemm(ta, tb, 1, 1, 1, 2.0, 1.0);
+            }
+        }
+    });
+
+    // Shapes that cross the register tile and cache block boundaries
+    suite.runTest("GEMM Blocked Shapes", []() {
+        for (int ta = 0; ta < 2; ++ta) {
+            for (int tb = 0; tb < 2; ++tb) {
+                checkGemm(ta, tb, 37, 53, 71, 1.0, 0.0);
+                checkGemm(ta, tb, 131, 19, 300, -0.5, 0.25);
+            }
+        }
+        checkGemm(false, true, 200, 130, 520, 1.0, 1.0);
+    });
+
+    // Views with a stride larger than their width
+    suite.runTest("GEMM Strided Views", []() {
+        Matrix big_a(40, 50);
+        Matrix big_b(60, 70);
+        fillPattern(big_a, 4);
+        fillPattern(big_b, 5);
+
+        // A is the 20 x 30 block at (3, 5), B the 30 x 25 block at (7, 11)
+        ConstMatrixView a(big_a.row(3) + 5, 20, 30, big_a.stride());
+        ConstMatrixView b(big_b.row(7) + 11, 30, 25, big_b.stride());
+        Matrix big_c(22, 40, 9.0);
+        MatrixView c{big_c.row(1) + 2, 20, 25, big_c.stride()};
+
+        Gemm::gemm(Gemm::Transpose::No, Gemm::Transpose::No, 1.0, a, b, 0.0, c);
+
+        for (size_t i = 0; i < 20; ++i) {
+            for (size_t j = 0; j < 25; ++j) {
+                double sum = 0.0;
+                for (size_t p = 0; p < 30; ++p) {
+                    sum += a(i, p) * b(p, j);
+                }
+                TestFramework::assertDoubleEqual(sum, c(i, j), 1e-10, "Strided gemm result incorrect");
+            }
+        }
+        TestFramework::assertDoubleEqual(9.0, big_c(0, 0), 1e-12, "gemm should not write outside the view");
+        TestFramework::assertDoubleEqual(9.0, big_c(1, 27), 1e-12, "gemm should not write outside the view");
+
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            Gemm::gemm(Gemm::Transpose::Yes, Gemm::Transpose::No, 1.0, a, b, 0.0, c);
+        }, "Incompatible shapes should throw");
+    });
+
+    // GEMV in both orientations
+    suite.runTest("GEMV", []() {
+        const size_t m = 23;
+        const size_t n = 41;
+        Matrix a(m, n);
+        fillPattern(a, 6);
+        std::vector<double> x_n(n);
+        std::vector<double> x_m(m);
+        for (size_t j = 0; j < n; ++j) x_n[j] = std::cos(0.1 * j);
+        for (size_t i = 0; i < m; ++i) x_m[i] = std::cos(0.2 * i);
+
+        std::vector<double> y(m, 1.0);
+        Gemm::gemv(Gemm::Transpose::No, m, n, 2.0, a.data(), a.stride(), x_n.data(), 0.5, y.data());
+        for (size_t i = 0; i < m; ++i) {
+            double sum = 0.0;
+            for (size_t j = 0; j < n; ++j) sum += a(i, j) * x_n[j];
+            TestFramework::assertDoubleEqual(2.0 * sum + 0.5, y[i], 1e-10, "gemv result incorrect");
+        }
+
+        std::vector<double> yt(n, 1.0);
+        Gemm::gemv(Gemm::Transpose::Yes, m, n, 1.0, a.data(), a.stride(), x_m.data(), 0.0, yt.data());
+        for (size_t j = 0; j < n; ++j) {
+            double sum = 0.0;
+            for (size_t i = 0; i < m; ++i) sum += a(i, j) * x_m[i];
+            TestFramework::assertDoubleEqual(sum, yt[j], 1e-10, "Transposed gemv result incorrect");
+        }
+    });
+
+    // Exact int32 results, including the -128 extreme and lengths off the vector width
+    suite.runTest("Int8 GEMM", []() {
+        const size_t shapes[][3] = {{1, 1, 1}, {3, 5, 15}, {7, 9, 33}, {5, 70, 257}, {2, 300, 100}};
+        for (const auto& shape : shapes) {
+            const size_t m = shape[0], n = shape[1], k = shape[2];
+            const size_t lda = k + 3;
+            std::vector<std::int8_t> a(m * lda);
+            std::vector<std::int8_t> b(n * k);
+            for (size_t i = 0; i < a.size(); ++i) a[i] = (std::int8_t)((int)(i * 37 % 256) - 128);
+            for (size_t i = 0; i < b.size(); ++i) b[i] = (std::int8_t)((int)(i * 91 % 256) - 128);
+            std::vector<std::int32_t> c(m * n, -1);
+
+            Gemm::gemm_s8(m, n, k, a.data(), lda, b.data(), k, c.data(), n);
+            for (size_t i = 0; i < m; ++i) {
+                for (size_t j = 0; j < n; ++j) {
+                    std::int32_t sum = 0;
+                    for (size_t p = 0; p < k; ++p) sum += (std::int32_t)a[i * lda + p] * (std::int32_t)b[j * k + p];
+                    TestFramework::assertEqual(sum, c[i * n + j], "int8 gemm result incorrect");
+                }
+            }
+        }
+
+        const size_t m = 13;
+        const size_t n = 75;
+        std::vector<std::int8_t> a(m * n);
+        std::vector<std::int8_t> x(n);
+        for (size_t i = 0; i < a.size(); ++i) a[i] = (std::int8_t)((int)(i * 53 % 255) - 127);
+        for (size_t j = 0; j < n; ++j) x[j] = (std::int8_t)((int)(j * 29 % 255) - 127);
+        std::vector<std::int32_t> y(m);
+        Gemm::gemv_s8(m, n, a.data(), n, x.data(), y.data());
+        for (size_t i = 0; i < m; ++i) {
+            std::int32_t sum = 0;
+            for (size_t j = 0; j < n; ++j) sum += (std::int32_t)a[i * n + j] * (std::int32_t)x[j];
+            TestFramework::assertEqual(sum, y[i], "int8 gemv result incorrect");
+        }
+    });
+
+    return suite;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "test_framework.hpp"
+#include "../include/hogwild_trainer.hpp"
+#include "../include/activation.hpp"
+#include "../include/dense.hpp"
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <stdexcept>
+
+/**
+ * @brief Tests for HogwildTrainer functionality
+ * @return TestSuite with the results
+ */
+TestFramework::TestSuite runHogwildTrainerTests() {
+    TestFramework::TestSuite suite("HogwildTrainer");
+
+    // Concurrent lock-free updates still drive the loss down
+    suite.runTest("HogwildTrainer Reduces Loss", []() {
+        NeuralNet net;
+        net.addLayer(std::make_shared<Dense>(4, 16));
+        net.addLayer(std::make_shared<Activation>(ActivationType::Tanh));
+        net.addLayer(std::make_shared<Dense>(16, 1));
+        net.setLoss(std::make_shared<MSELoss>());
+
+        std::vector<std::vector<double>> inputs;
+        std::vector<std::vector<double>> targets;
+        for (int i = 0; i < 200; ++i) {
+            std::vector<double> x = {std::sin(0.1 * i), std::cos(0.23 * i), 0.01 * i - 1.0, std::sin(0.05 * i)};
+            inputs.push_back(x);
+            targets.push_back({0.5 * x[0] - 0.25 * x[1] + 0.1 * x[2]});
+        }
+
+        MSELoss mse;
+        double before = 0.0;
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            before += mse.compute(net.predict(inputs[i]), targets[i]);
+        }
+        before /= inputs.size();
+
+        ThreadPool pool(4);
+        HogwildTrainer trainer(net, pool);
+        double last_epoch = trainer.train(inputs, targets, 30, 0.02);
+
+        double after = 0.0;
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            after += mse.compute(net.predict(inputs[i]), targets[i]);
+        }
+        after /= inputs.size();
+
+        TestFramework::assertTrue(std::isfinite(last_epoch), "Reported loss should be finite");
+        TestFramework::assertTrue(after < 0.5 * before, "Hogwild training should reduce the loss");
+    });
+
+    // Invalid setups are rejected
+    suite.runTest("HogwildTrainer Validation", []() {
+        ThreadPool pool(2);
+        NeuralNet no_loss;
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            HogwildTrainer trainer(no_loss, pool);
+        }, "A network without a loss should throw");
+
+        NeuralNet net;
+        net.addLayer(std::make_shared<Dense>(2, 1));
+        net.setLoss(std::make_shared<MSELoss>());
+        HogwildTrainer trainer(net, pool);
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            trainer.train({{1.0, 2.0}}, {{1.0}, {2.0}}, 1, 0.1);
+        }, "Mismatched sample counts should throw");
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            trainer.train({{1.0, 2.0}, {1.0}}, {{1.0}, {2.0}}, 1, 0.1);
+        }, "Inconsistent sample sizes should throw");
+    });
+
+    return suite;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "test_framework.hpp"
+#include "../include/inference_plan.hpp"
+#include "../include/activation.hpp"
+#include "../include/dense.hpp"
+#include <vector>
+#include <memory>
+#include <stdexcept>
+
+/**
+ * @brief Tests for InferencePlan functionality
+ * @return TestSuite with the results
+ */
+TestFramework::TestSuite runInferencePlanTests() {
+    TestFramework::TestSuite suite("InferencePlan");
+
+    // The plan must reproduce predict for every sample and layer mix
+    suite.runTest("InferencePlan Matches Predict", []() {
+        NeuralNet net;
+        net.addLayer(std::make_shared<Dense>(5, 9));
+        net.addLayer(std::make_shared<Activation>(ActivationType::Tanh));
+        net.addLayer(std::make_shared<Dense>(9, 4));
+        net.addLayer(std::make_shared<Activation>(ActivationType::ReLU));
+        net.addLayer(std::make_shared<Dense>(4, 3));
+        net.addLayer(std::make_shared<Activation>(ActivationType::Softmax));
+
+        InferencePlan plan(net, 5);
+        TestFramework::assertEqual(size_t(5), plan.input_size(), "Plan input size incorrect");
+        TestFramework::assertEqual(size_t(3), plan.output_size(), "Plan output size incorrect");
+
+        std::vector<double> output(3);
+        for (int s = 0; s < 10; ++s) {
+            std::vector<double> input = {0.1 * s, -0.2, 0.3 * s - 1.0, 0.5, -0.05 * s};
+            plan.predict(input, output);
+            TestFramework::assertVectorDoubleEqual(net.predict(input), output, 1e-12,
+                                                   "Plan output should match predict");
+        }
+    });
+
+    // Weight changes made through the network are seen by an existing plan
+    suite.runTest("InferencePlan Shares Layers", []() {
+        NeuralNet net;
+        auto dense = std::make_shared<Dense>(2, 1);
+        net.addLayer(dense);
+
+        InferencePlan plan(net, 2);
+        Matrix w(1, 2);
+        w(0, 0) = 2.0;
+        w(0, 1) = -1.0;
+        dense->setWeights(w);
+        dense->setBiases(std::vector<double>{0.5});
+
+        std::vector<double> output(1);
+        plan.predict(std::vector<double>{3.0, 4.0}, output);
+        TestFramework::assertDoubleEqual(2.5, output[0], 1e-12, "Plan should use the updated weights");
+    });
+
+    // Shape errors are reported when planning and when predicting
+    suite.runTest("InferencePlan Size Checks", []() {
+        NeuralNet net;
+        net.addLayer(std::make_shared<Dense>(3, 2));
+        net.addLayer(std::make_shared<Dense>(2, 2));
+
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            InferencePlan plan(net, 4);
+        }, "Planning with the wrong input size should throw");
+
+        InferencePlan plan(net, 3);
+        std::vector<double> input(3, 1.0);
+        std::vector<double> output(2);
+        std::vector<double> short_output(1);
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            plan.predict(std::vector<double>(2, 1.0), output);
+        }, "Wrong input size should throw");
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            plan.predict(input, short_output);
+        }, "Wrong output size should throw");
+
+        NeuralNet empty;
+        InferencePlan identity(empty, 3);
+        std::vector<double> copy(3);
+        identity.predict(input, copy);
+        TestFramework::assertVectorDoubleEqual(input, copy, 0.0, "An empty network should copy its input");
+    });
+
+    return suite;
+}
@@ -130,5 +130,38 @@ TestFramework::TestSuite runLossTests() {
         TestFramework::assertDoubleEqual(4000000.0, result2, 1e-5, "MSE should handle large differences");
     });
 
+    // Test MSELoss batch methods against the per-sample ones
+    suite.runTest("MSELoss Batch", []() {
+        MSELoss loss;
+
+        Matrix predicted(2, 3);
+        Matrix actual(2, 3);
+        std::vector<std::vector<double>> p = {{1.0, 2.0, 3.0}, {0.5, -1.0, 4.0}};
+        std::vector<std::vector<double>> a = {{2.0, 3.0, 4.0}, {0.0, 1.0, 1.0}};
+        for (size_t r = 0; r < 2; ++r) {
+            for (size_t c = 0; c < 3; ++c) {
+                predicted(r, c) = p[r][c];
+                actual(r, c) = a[r][c];
+            }
+        }
+
+        double expected = (loss.compute(p[0], a[0]) + loss.compute(p[1], a[1])) / 2.0;
+        TestFramework::assertDoubleEqual(expected, loss.compute_batch(predicted, actual), 1e-12,
+                                         "Batch MSE should be the mean of per-sample MSEs");
+
+        Matrix grad = loss.gradient_batch(predicted, actual);
+        for (size_t r = 0; r < 2; ++r) {
+            std::vector<double> g = loss.gradient(p[r], a[r]);
+            for (size_t c = 0; c < 3; ++c) {
+                TestFramework::assertDoubleEqual(g[c] / 2.0, grad(r, c), 1e-12,
+                                                 "Batch gradient should be the per-sample gradient divided by batch size");
+            }
+        }
+
+        TestFramework::assertThrows<std::invalid_argument>([&loss, &predicted]() {
+            loss.compute_batch(predicted, Matrix(3, 2));
+        }, "Batches of different shapes should throw");
+    });
+
     return suite;
 }
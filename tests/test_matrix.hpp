@@ -0,0 +1,114 @@
+#pragma once
+
+#include "test_framework.hpp"
+#include "../include/matrix.hpp"
+#include <vector>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief Tests for Matrix functionality
+ * @return TestSuite with the results
+ */
+TestFramework::TestSuite runMatrixTests() {
+    TestFramework::TestSuite suite("Matrix");
+
+    // Test construction and element access
+    suite.runTest("Matrix Construction", []() {
+        Matrix m(3, 4, 1.5);
+
+        TestFramework::assertEqual((size_t)3, m.rows(), "Matrix should have 3 rows");
+        TestFramework::assertEqual((size_t)4, m.cols(), "Matrix should have 4 columns");
+        TestFramework::assertEqual((size_t)12, m.size(), "Matrix should have 12 elements");
+
+        for (size_t i = 0; i < m.rows(); ++i) {
+            for (size_t j = 0; j < m.cols(); ++j) {
+                TestFramework::assertDoubleEqual(1.5, m(i, j), 1e-12, "Matrix should be filled with the initial value");
+            }
+        }
+    });
+
+    // Test that storage is contiguous, row-major and aligned
+    suite.runTest("Matrix Contiguous Row-Major Layout", []() {
+        Matrix m(5, 7);
+        for (size_t i = 0; i < m.rows(); ++i) {
+            for (size_t j = 0; j < m.cols(); ++j) {
+                m(i, j) = (double)(i * 10 + j);
+            }
+        }
+
+        const double* flat = m.data();
+        for (size_t k = 0; k < m.size(); ++k) {
+            TestFramework::assertDoubleEqual((double)((k / 7) * 10 + k % 7), flat[k], 1e-12,
+                                             "Elements should be laid out row after row");
+        }
+
+        TestFramework::assertTrue(m.row(2) == flat + 14, "Row pointer should point into the flat buffer");
+        TestFramework::assertEqual((uintptr_t)0, (uintptr_t)m.data() % 64, "Storage should be 64-byte aligned");
+    });
+
+    // Test stride-aware views over sub-blocks
+    suite.runTest("MatrixView Sub-Block", []() {
+        Matrix m(4, 6);
+        for (size_t i = 0; i < m.rows(); ++i) {
+            for (size_t j = 0; j < m.cols(); ++j) {
+                m(i, j) = (double)(i * m.cols() + j);
+            }
+        }
+
+        // 2 x 3 block starting at (1, 2)
+        MatrixView block{m.row(1) + 2, 2, 3, m.stride()};
+        TestFramework::assertDoubleEqual(m(1, 2), block(0, 0), 1e-12, "Block (0,0) should map to (1,2)");
+        TestFramework::assertDoubleEqual(m(2, 4), block(1, 2), 1e-12, "Block (1,2) should map to (2,4)");
+
+        block(1, 1) = -1.0;
+        TestFramework::assertDoubleEqual(-1.0, m(2, 3), 1e-12, "Writes through a view should reach the matrix");
+
+        ConstMatrixView cview = m.view();
+        TestFramework::assertDoubleEqual(m(3, 5), cview(3, 5), 1e-12, "Const view should see the same elements");
+    });
+
+    // Test resize reuses storage
+    suite.runTest("Matrix Resize", []() {
+        Matrix m(8, 8);
+        const double* before = m.data();
+
+        m.resize(4, 2);
+        TestFramework::assertEqual((size_t)4, m.rows(), "Resized matrix should have 4 rows");
+        TestFramework::assertEqual((size_t)2, m.cols(), "Resized matrix should have 2 columns");
+        TestFramework::assertTrue(m.data() == before, "Shrinking should not reallocate");
+
+        m.fill(3.0);
+        for (size_t k = 0; k < m.size(); ++k) {
+            TestFramework::assertDoubleEqual(3.0, m.data()[k], 1e-12, "fill should set every element");
+        }
+    });
+
+    // Test that a borrowed matrix works in place and that copies own their storage
+    suite.runTest("Matrix Borrowed Storage", []() {
+        auto buffer = std::make_shared<std::vector<double>>(6, 2.0);
+        Matrix borrowed(buffer->data(), 2, 3, buffer);
+
+        TestFramework::assertTrue(borrowed.borrowed(), "Matrix should be borrowed");
+        TestFramework::assertTrue(borrowed.data() == buffer->data(), "Borrowed matrix should not copy");
+        borrowed(1, 2) = 5.0;
+        TestFramework::assertDoubleEqual(5.0, (*buffer)[5], 1e-12, "Writes should reach the external memory");
+
+        Matrix copy = borrowed;
+        TestFramework::assertFalse(copy.borrowed(), "Copies should own their storage");
+        TestFramework::assertDoubleEqual(5.0, copy(1, 2), 1e-12, "Copy should have the same elements");
+
+        Matrix moved = std::move(borrowed);
+        TestFramework::assertTrue(moved.borrowed() && moved.data() == buffer->data(), "Moves should keep the external memory");
+        TestFramework::assertTrue(borrowed.empty(), "Moved-from matrix should be empty");
+
+        moved.resize(2, 3);
+        TestFramework::assertTrue(moved.borrowed(), "Resizing to the same shape should keep the external memory");
+        moved.resize(3, 3);
+        TestFramework::assertFalse(moved.borrowed(), "Resizing to a new shape should detach");
+        TestFramework::assertTrue(buffer.use_count() == 1, "Detached matrices should release the owner");
+    });
+
+    return suite;
+}
@@ -5,9 +5,13 @@
 #include "../include/activation.hpp"
 #include "../include/dense.hpp"
 #include "../include/loss.hpp"
+#include "../include/optimizer.hpp"
 #include "../include/utils.hpp"
+#include <cmath>
 #include <vector>
 #include <memory>
+#include <stdexcept>
+#include <thread>
 
 /**
  * @brief Tests for NeuralNet functionality
@@ -166,5 +170,184 @@ TestFramework::TestSuite runNeuralNetTests() {
         TestFramework::assertTrue(std::isfinite(outputLeakyReLU[0]), "Leaky ReLU network output should be finite");
     });
 
+    // Test mini-batch training
+    suite.runTest("NeuralNet Mini-Batch Training", []() {
+        NeuralNet net;
+        net.addLayer(std::make_shared<Dense>(2, 4));
+        net.addLayer(std::make_shared<Activation>(Utils::tanh, Utils::tanh_derivative));
+        net.addLayer(std::make_shared<Dense>(4, 1));
+        net.setLoss(std::make_shared<MSELoss>());
+
+        std::vector<std::vector<double>> inputs = {{0, 0}, {0, 1}, {1, 0}, {1, 1}, {0.5, 0.5}};
+        std::vector<std::vector<double>> targets = {{0}, {1}, {1}, {2}, {1}};
+
+        MSELoss mse;
+        double before = 0.0;
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            before += mse.compute(net.predict(inputs[i]), targets[i]);
+        }
+
+        // Batch size 2 leaves a partial last batch
+        net.train(inputs, targets, 200, 0.05, 2);
+
+        double after = 0.0;
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            after += mse.compute(net.predict(inputs[i]), targets[i]);
+        }
+        TestFramework::assertTrue(after < before, "Mini-batch training should reduce the loss");
+
+        // Batched prediction matches per-sample prediction
+        Matrix batch(inputs.size(), 2);
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            batch(i, 0) = inputs[i][0];
+            batch(i, 1) = inputs[i][1];
+        }
+        Matrix outputs = net.predict_batch(batch);
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            TestFramework::assertDoubleEqual(net.predict(inputs[i])[0], outputs(i, 0), 1e-12,
+                                             "predict_batch should match predict");
+        }
+
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            net.train(inputs, targets, 1, 0.05, 0);
+        }, "A batch size of 0 should throw");
+    });
+
+    // Accumulating k mini-batches takes the same step as one batch k times larger
+    suite.runTest("NeuralNet Gradient Accumulation", []() {
+        std::vector<std::vector<double>> inputs;
+        std::vector<std::vector<double>> targets;
+        for (int s = 0; s < 11; ++s) {
+            inputs.push_back({std::sin(0.4 * s), std::cos(0.9 * s)});
+            targets.push_back({0.5 * inputs.back()[0] - inputs.back()[1]});
+        }
+
+        for (int adam = 0; adam < 2; ++adam) {
+            NeuralNet large;
+            auto hidden = std::make_shared<Dense>(2, 4);
+            auto output = std::make_shared<Dense>(4, 1);
+            if (adam) {
+                hidden->setOptimizer(std::make_unique<Adam>(0.01));
+                output->setOptimizer(std::make_unique<Adam>(0.01));
+            }
+            large.addLayer(hidden);
+            large.addLayer(std::make_shared<Activation>(ActivationType::Tanh));
+            large.addLayer(output);
+            large.setLoss(std::make_shared<MSELoss>());
+            NeuralNet accumulated(large);
+            NeuralNet uneven(large);
+            NeuralNet arena(large);
+            arena.setOptimizer(adam ? std::make_unique<Adam>(0.01) : nullptr);
+            NeuralNet arena_large(arena);
+
+            // Groups of 6 samples; the last group of 5 is split 2 + 2 + 1 or 3 + 2
+            large.train(inputs, targets, 4, 0.1, 6);
+            accumulated.train(inputs, targets, 4, 0.1, 2, 3);
+            uneven.train(inputs, targets, 4, 0.1, 3, 2);
+            arena_large.train(inputs, targets, 4, 0.1, 6);
+            arena.train(inputs, targets, 4, 0.1, 1, 6);
+
+            const std::vector<double> x = {0.3, -0.7};
+            const double expected = large.predict(x)[0];
+            TestFramework::assertDoubleEqual(expected, accumulated.predict(x)[0], 1e-12, "Accumulation should match the large batch");
+            TestFramework::assertDoubleEqual(expected, uneven.predict(x)[0], 1e-12, "Uneven groups should match the large batch");
+            TestFramework::assertDoubleEqual(arena_large.predict(x)[0], arena.predict(x)[0], 1e-12,
+                                             "Accumulation through the arena should match the large batch");
+        }
+
+        NeuralNet net;
+        net.addLayer(std::make_shared<Dense>(2, 1));
+        net.setLoss(std::make_shared<MSELoss>());
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            net.train(inputs, targets, 1, 0.05, 2, 0);
+        }, "Zero accumulation steps should throw");
+    });
+
+    // predict is const and leaves the training caches alone
+    suite.runTest("NeuralNet Const Predict Leaves Caches", []() {
+        auto dense = std::make_shared<Dense>(3, 2);
+        auto reference = dense->clone();
+        NeuralNet net;
+        net.addLayer(dense);
+        const NeuralNet& shared = net;
+
+        std::vector<double> x = {0.5, -1.0, 2.0};
+        std::vector<double> g = {1.0, -0.5};
+        dense->forward(x);
+        reference->forward(x);
+        shared.predict({9.0, 9.0, 9.0});
+
+        std::vector<double> grad = dense->backward(g, 0.1);
+        std::vector<double> expected = reference->backward(g, 0.1);
+        TestFramework::assertVectorDoubleEqual(expected, grad, 1e-12, "predict should not change the input cache");
+        TestFramework::assertVectorDoubleEqual(reference->clone()->forward(x), dense->forward(x), 1e-12,
+                                               "Weights should be updated from the cached input");
+    });
+
+    // Many threads can predict on one shared network
+    suite.runTest("NeuralNet Concurrent Predict", []() {
+        NeuralNet net;
+        net.addLayer(std::make_shared<Dense>(4, 16));
+        net.addLayer(std::make_shared<Activation>(ActivationType::Sigmoid));
+        net.addLayer(std::make_shared<Dense>(16, 2));
+        const NeuralNet& shared = net;
+
+        std::vector<std::vector<double>> inputs;
+        std::vector<std::vector<double>> expected;
+        for (int i = 0; i < 32; ++i) {
+            inputs.push_back({0.1 * i, -0.05 * i, 1.0, 0.3});
+            expected.push_back(shared.predict(inputs.back()));
+        }
+
+        std::vector<int> mismatches(4, 0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t]() {
+                for (int rep = 0; rep < 200; ++rep) {
+                    for (size_t i = 0; i < inputs.size(); ++i) {
+                        if (shared.predict(inputs[i]) != expected[i]) {
+                            ++mismatches[t];
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (int t = 0; t < 4; ++t) {
+            TestFramework::assertEqual(0, mismatches[t], "Concurrent predictions should match");
+        }
+    });
+
+    // The pooled batch prediction matches the single-threaded one
+    suite.runTest("NeuralNet Pooled Predict Batch", []() {
+        NeuralNet net;
+        net.addLayer(std::make_shared<Dense>(6, 12));
+        net.addLayer(std::make_shared<Activation>(ActivationType::ReLU));
+        net.addLayer(std::make_shared<Dense>(12, 3));
+        net.addLayer(std::make_shared<Activation>(ActivationType::Softmax));
+
+        Matrix inputs(203, 6);
+        for (size_t k = 0; k < inputs.size(); ++k) {
+            inputs.data()[k] = std::sin(0.1 * (double)k);
+        }
+
+        ThreadPool pool(3);
+        Matrix outputs;
+        net.predict_batch(inputs, outputs, pool);
+        Matrix expected = net.predict_batch(inputs);
+        TestFramework::assertEqual(expected.rows(), outputs.rows(), "Pooled output rows incorrect");
+        TestFramework::assertEqual(expected.cols(), outputs.cols(), "Pooled output cols incorrect");
+        for (size_t k = 0; k < expected.size(); ++k) {
+            TestFramework::assertDoubleEqual(expected.data()[k], outputs.data()[k], 1e-12,
+                                             "Pooled predict_batch should match predict_batch");
+        }
+
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            net.predict_batch(inputs, inputs, pool);
+        }, "Aliased outputs should throw");
+    });
+
     return suite;
 }
@@ -3,7 +3,9 @@
 #include "test_framework.hpp"
 #include "../include/optimizer.hpp"
 #include <vector>
+#include <memory>
 #include <cmath>
+#include <stdexcept>
 
 /**
  * @brief Tests for Optimizer functionality
@@ -156,5 +158,85 @@ TestFramework::TestSuite runOptimizerTests() {
         TestFramework::assertTrue(cloned != nullptr, "Clone should be an Adam optimizer");
     });
 
+    // Test updating a slice of a larger buffer in place through a span
+    suite.runTest("Optimizer Update Through Span", []() {
+        SGD optimizer(0.5, 0.0);
+
+        std::vector<double> buffer = {10.0, 1.0, 2.0, 3.0, 20.0};
+        std::vector<double> gradients = {0.2, 0.4, 0.6};
+
+        optimizer.update(Span<double>(buffer.data() + 1, 3), gradients);
+
+        std::vector<double> expected = {10.0, 0.9, 1.8, 2.7, 20.0};
+        TestFramework::assertVectorDoubleEqual(expected, buffer, 1e-12,
+                                              "Span update should only touch the viewed elements");
+
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            optimizer.update(Span<double>(buffer.data(), 2), gradients);
+        }, "Mismatched weight and gradient sizes should throw");
+
+        Adam adam;
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            adam.update(Span<double>(buffer.data(), 2), gradients);
+        }, "Mismatched weight and gradient sizes should throw");
+    });
+
+    // Test that exported state continues a run exactly when imported into a fresh optimizer
+    suite.runTest("Optimizer State Export And Import", []() {
+        std::vector<double> gradients = {0.3, -0.2, 0.1, 0.05};
+        std::vector<std::unique_ptr<Optimizer>> trained;
+        std::vector<std::unique_ptr<Optimizer>> fresh;
+        trained.push_back(std::make_unique<SGD>(0.1, 0.9));
+        fresh.push_back(std::make_unique<SGD>(0.1, 0.9));
+        trained.push_back(std::make_unique<Adam>(0.01));
+        fresh.push_back(std::make_unique<Adam>(0.01));
+
+        for (size_t o = 0; o < trained.size(); ++o) {
+            std::vector<double> weights = {1.0, -1.0, 0.5, 2.0};
+            for (int step = 0; step < 3; ++step) trained[o]->update(weights, gradients);
+
+            fresh[o]->setState(trained[o]->getState());
+            std::vector<double> resumed = weights;
+            for (int step = 0; step < 3; ++step) {
+                trained[o]->update(weights, gradients);
+                fresh[o]->update(resumed, gradients);
+            }
+            TestFramework::assertVectorDoubleEqual(weights, resumed, 0.0, "Imported state should continue the run exactly");
+        }
+
+        TestFramework::assertEqual(6, trained[1]->getState().step, "Adam state should carry the timestep");
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            fresh[0]->setState(trained[1]->getState());
+        }, "SGD should reject Adam state");
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            fresh[1]->setState(trained[0]->getState());
+        }, "Adam should reject SGD state");
+    });
+
+    // Test that AdamW decays the weights independently of the gradient moments
+    suite.runTest("AdamW Decoupled Weight Decay", []() {
+        Adam adamw(0.1, 0.9, 0.999, 1e-8, 0.5);
+        std::vector<double> weights = {2.0, -4.0, 0.0};
+        std::vector<double> gradients = {0.0, 0.0, 0.0};
+        for (int step = 0; step < 3; ++step) adamw.update(weights, gradients);
+
+        // With zero gradients only the decay acts: w *= (1 - lr * wd) per step
+        const double factor = std::pow(1.0 - 0.1 * 0.5, 3);
+        TestFramework::assertVectorDoubleEqual({2.0 * factor, -4.0 * factor, 0.0}, weights, 1e-12,
+                                              "Weights should shrink by the decoupled decay only");
+
+        Adam adam(0.1);
+        Adam decayed(0.1, 0.9, 0.999, 1e-8, 0.5);
+        std::vector<double> plain = {1.0, 1.0};
+        std::vector<double> with_decay = {1.0, 1.0};
+        std::vector<double> grad = {0.2, -0.2};
+        adam.update(plain, grad);
+        decayed.update(with_decay, grad);
+        for (size_t i = 0; i < plain.size(); ++i) {
+            TestFramework::assertDoubleEqual(plain[i] - 0.1 * 0.5 * 1.0, with_decay[i], 1e-12,
+                                             "Decay should be applied to the pre-step weights, separately from the Adam step");
+        }
+    });
+
     return suite;
 }
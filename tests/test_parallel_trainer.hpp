@@ -0,0 +1,104 @@
+#pragma once
+
+#include "test_framework.hpp"
+#include "test_fixtures.hpp"
+#include "../include/parallel_trainer.hpp"
+#include "../include/activation.hpp"
+#include "../include/dense.hpp"
+#include "../include/optimizer.hpp"
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <stdexcept>
+
+/**
+ * @brief Tests for ParallelTrainer functionality
+ * @return TestSuite with the results
+ */
+TestFramework::TestSuite runParallelTrainerTests() {
+    TestFramework::TestSuite suite("ParallelTrainer");
+
+    // Sharded training follows the same trajectory as the serial mini-batch path
+    suite.runTest("ParallelTrainer Matches Serial Training", []() {
+        std::vector<std::vector<double>> inputs;
+        std::vector<std::vector<double>> targets;
+        makeRegressionData(37, 3, inputs, targets);
+
+        const Adam adam(0.01);
+        for (bool use_adam : {false, true}) {
+            NeuralNet serial = makeRegressionNet(3, 8, 2, use_adam ? &adam : nullptr);
+            NeuralNet parallel(serial);
+
+            serial.train(inputs, targets, 5, 0.05, 8);
+            ThreadPool pool(3);
+            ParallelTrainer trainer(parallel, pool);
+            TestFramework::assertEqual(size_t(3), trainer.shard_count(), "Default shard count should match the pool");
+            trainer.train(inputs, targets, 5, 0.05, 8);
+
+            assertSameParameters(serial, parallel, 1e-10, "Parallel training should match serial training");
+        }
+    });
+
+    // With a parameter arena the reduced gradient goes through the arena optimizer and clipping
+    suite.runTest("ParallelTrainer Steps The Parameter Arena", []() {
+        std::vector<std::vector<double>> inputs;
+        std::vector<std::vector<double>> targets;
+        makeRegressionData(37, 3, inputs, targets);
+
+        NeuralNet serial = makeRegressionNet(3, 8, 2);
+        serial.setOptimizer(std::make_unique<Adam>(0.01));
+        serial.setGradientClipping(0.05);
+        NeuralNet parallel(serial);
+
+        serial.train(inputs, targets, 5, 0.05, 8);
+        ThreadPool pool(3);
+        ParallelTrainer trainer(parallel, pool);
+        trainer.train(inputs, targets, 5, 0.05, 8);
+
+        assertSameParameters(serial, parallel, 1e-10, "Parallel training should step the arena like serial training");
+    });
+
+    // Results depend on the shard count only, not on the pool or scheduling
+    suite.runTest("ParallelTrainer Is Deterministic", []() {
+        std::vector<std::vector<double>> inputs;
+        std::vector<std::vector<double>> targets;
+        makeRegressionData(37, 3, inputs, targets);
+
+        NeuralNet first = makeRegressionNet(3, 8, 2);
+        NeuralNet second(first);
+
+        ThreadPool small_pool(2);
+        ThreadPool large_pool(4);
+        ParallelTrainer first_trainer(first, small_pool, 5);
+        ParallelTrainer second_trainer(second, large_pool, 5);
+        first_trainer.train(inputs, targets, 3, 0.05, 16);
+        second_trainer.train(inputs, targets, 3, 0.05, 16);
+
+        assertSameParameters(first, second, 0.0, "Training with the same shard count should be bitwise reproducible");
+    });
+
+    // More shards than rows leaves some shards empty
+    suite.runTest("ParallelTrainer Small Batches", []() {
+        NeuralNet net = makeRegressionNet(3, 8, 2);
+        ThreadPool pool(2);
+        ParallelTrainer trainer(net, pool, 6);
+
+        Matrix inputs(2, 3, 0.5);
+        Matrix targets(2, 2, 0.1);
+        double first = trainer.train_batch(inputs, targets, 0.1);
+        double second = trainer.train_batch(inputs, targets, 0.1);
+        TestFramework::assertTrue(std::isfinite(first), "Loss should be finite");
+        TestFramework::assertTrue(second < first, "Repeated steps on one batch should reduce the loss");
+
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            trainer.train_batch(inputs, Matrix(3, 2), 0.1);
+        }, "Mismatched row counts should throw");
+
+        NeuralNet no_loss;
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            ParallelTrainer invalid(no_loss, pool);
+        }, "A network without a loss should throw");
+    });
+
+    return suite;
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "test_framework.hpp"
+#include "test_fixtures.hpp"
+#include "../include/parameter_arena.hpp"
+#include "../include/neuralnet.hpp"
+#include "../include/dense.hpp"
+#include "../include/activation.hpp"
+#include "../include/loss.hpp"
+#include "../include/optimizer.hpp"
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Tests for the network parameter arena
+ * @return TestSuite with the results
+ */
+TestFramework::TestSuite runParameterArenaTests() {
+    TestFramework::TestSuite suite("ParameterArena");
+
+    suite.runTest("Layers View The Arena", []() {
+        NeuralNet net = makeRegressionNet(3, 5, 2);
+        const std::vector<double> input = {0.2, -0.4, 0.9};
+        const std::vector<double> before = net.predict(input);
+
+        TestFramework::assertTrue(net.getParameterArena() == nullptr, "A new network should have no arena");
+        net.setOptimizer(nullptr);
+        ParameterArena* arena = net.getParameterArena();
+        TestFramework::assertTrue(arena != nullptr, "setOptimizer should create the arena");
+        TestFramework::assertEqual((size_t)(5 * 3 + 5 + 2 * 5 + 2), arena->size(), "Arena should hold every parameter");
+        TestFramework::assertEqual((size_t)0, arena->layerGradients(1).size(), "Activation layers should own no gradients");
+        TestFramework::assertVectorDoubleEqual(before, net.predict(input), 0.0, "Binding should keep the parameter values");
+
+        // Layers are laid out back to back: weights row-major, then biases
+        auto* output = dynamic_cast<Dense*>(net.getLayers()[2].get());
+        TestFramework::assertTrue(output->getWeights().borrowed(), "Bound weights should view the arena");
+        TestFramework::assertTrue(output->getWeights().data() == arena->getParameters().data() + 20, "Weights should follow the first layer");
+        TestFramework::assertTrue(output->getBiases().data() == arena->getParameters().data() + 30, "Biases should follow the weights");
+        arena->getParameters()[30] += 1.0;
+        TestFramework::assertDoubleEqual(before[0] + 1.0, net.predict(input)[0], 1e-12, "Layers should read the arena in place");
+
+        output->setBiases(std::vector<double>{0.0, 0.0});
+        TestFramework::assertDoubleEqual(0.0, arena->getParameters()[30], 0.0, "setBiases should write through to the arena");
+        TestFramework::assertThrows<std::out_of_range>([&]() { arena->layerGradients(3); }, "Layer index past the end should be rejected");
+    });
+
+    suite.runTest("Arena Steps Match Per-Layer Updates", []() {
+        std::vector<std::vector<double>> inputs;
+        std::vector<std::vector<double>> targets;
+        makeRegressionData(12, 3, inputs, targets);
+
+        // Plain gradient descent
+        NeuralNet layered = makeRegressionNet(3, 5, 2);
+        NeuralNet flat(layered);
+        flat.setOptimizer(nullptr);
+        layered.train(inputs, targets, 5, 0.1, 4);
+        flat.train(inputs, targets, 5, 0.1, 4);
+        assertSameParameters(layered, flat, 1e-12, "Parameters should match");
+
+        // Adam is element-wise, so one optimizer over the arena matches one per parameter block
+        Adam adam(0.01);
+        NeuralNet layered_adam = makeRegressionNet(3, 5, 2, &adam);
+        NeuralNet flat_adam(layered_adam);
+        flat_adam.setOptimizer(adam.clone());
+        layered_adam.train(inputs, targets, 5, 0.01, 3);
+        flat_adam.train(inputs, targets, 5, 0.01, 3);
+        assertSameParameters(layered_adam, flat_adam, 1e-12, "Parameters should match");
+        TestFramework::assertEqual(20, flat_adam.getParameterArena()->getOptimizer()->getState().step,
+                                   "One arena step should be taken per batch");
+
+        // With an arena a batch size of 1 also runs through the batched path
+        NeuralNet single = makeRegressionNet(3, 5, 2);
+        NeuralNet single_flat(single);
+        single_flat.setOptimizer(nullptr);
+        single.train(inputs, targets, 3, 0.05);
+        single_flat.train(inputs, targets, 3, 0.05);
+        assertSameParameters(single, single_flat, 1e-12, "Parameters should match");
+    });
+
+    suite.runTest("Gradient Clipping", []() {
+        NeuralNet net = makeRegressionNet(3, 5, 2);
+        net.setOptimizer(nullptr);
+        ParameterArena* arena = net.getParameterArena();
+        Span<double> gradients = arena->getGradients();
+        for (double& g : gradients) g = 0.0;
+        gradients[0] = 3.0;
+        gradients[arena->size() - 1] = 4.0;
+
+        TestFramework::assertDoubleEqual(5.0, arena->clip_gradients(10.0), 1e-12, "Clipping should report the norm");
+        TestFramework::assertDoubleEqual(3.0, gradients[0], 0.0, "Gradients under the limit should be left alone");
+        TestFramework::assertDoubleEqual(5.0, arena->clip_gradients(1.0), 1e-12, "Clipping should report the norm before scaling");
+        TestFramework::assertDoubleEqual(0.6, gradients[0], 1e-12, "Gradients should be scaled to the limit");
+        TestFramework::assertDoubleEqual(0.8, gradients[arena->size() - 1], 1e-12, "Gradients should be scaled to the limit");
+        TestFramework::assertThrows<std::invalid_argument>([&]() { arena->clip_gradients(0.0); }, "A zero limit should be rejected");
+        TestFramework::assertThrows<std::invalid_argument>([&]() { net.setGradientClipping(-1.0); }, "A negative limit should be rejected");
+
+        // A tight limit bounds every parameter change of one plain step to lr * max_norm
+        std::vector<std::vector<double>> inputs;
+        std::vector<std::vector<double>> targets;
+        makeRegressionData(12, 3, inputs, targets);
+        const std::vector<double> before(arena->getParameters().begin(), arena->getParameters().end());
+        net.setGradientClipping(1e-3);
+        net.train(inputs, targets, 1, 1.0, inputs.size());
+        double change = 0.0;
+        for (size_t k = 0; k < before.size(); ++k) {
+            change += (arena->getParameters()[k] - before[k]) * (arena->getParameters()[k] - before[k]);
+        }
+        TestFramework::assertTrue(std::sqrt(change) <= 1e-3 + 1e-12, "The clipped step should be no longer than the limit");
+    });
+
+    suite.runTest("Copies, Added Layers And Checkpoints", []() {
+        std::vector<std::vector<double>> inputs;
+        std::vector<std::vector<double>> targets;
+        makeRegressionData(12, 3, inputs, targets);
+        const std::string path = scratchPath("arena", ".npm");
+
+        NeuralNet net = makeRegressionNet(3, 5, 2);
+        net.setOptimizer(std::make_unique<Adam>(0.01));
+        net.train(inputs, targets, 2, 0.01, 4);
+
+        // A copy owns a separate arena with a copy of the optimizer state
+        NeuralNet copy(net);
+        TestFramework::assertTrue(copy.getParameterArena()->getParameters().data() != net.getParameterArena()->getParameters().data(),
+                                  "A copy should not share the arena");
+        TestFramework::assertTrue(copy.getParameterArena()->getOptimizer()->getState().buffers ==
+                                  net.getParameterArena()->getOptimizer()->getState().buffers, "A copy should keep the optimizer state");
+
+        net.save(path, 2);
+        NeuralNet restored = makeRegressionNet(3, 5, 2);
+        restored.setOptimizer(std::make_unique<Adam>(0.01));
+        TestFramework::assertEqual(2, restored.restore(path), "Restore should return the recorded epoch");
+        assertSameParameters(net, restored, 0.0, "Parameters should match");
+        BasicOptimizerState<double> saved = net.getParameterArena()->getOptimizer()->getState();
+        BasicOptimizerState<double> loaded = restored.getParameterArena()->getOptimizer()->getState();
+        TestFramework::assertTrue(saved.buffers == loaded.buffers && saved.step == loaded.step, "Arena optimizer state should be restored");
+
+        net.train(inputs, targets, 4, 0.01, 4);
+        restored.train(inputs, targets, 4, 0.01, 4);
+        assertSameParameters(net, restored, 0.0, "Parameters should match");
+
+        NeuralNet mapped;
+        mapped.load(path);
+        TestFramework::assertTrue(mapped.getParameterArena() == nullptr, "Loading should drop the arena");
+        std::remove(path.c_str());
+
+        // Adding a layer rebuilds the arena and keeps the existing state in front
+        copy.addLayer(std::make_shared<Dense>(2, 1));
+        TestFramework::assertEqual((size_t)(32 + 3), copy.getParameterArena()->size(), "The arena should grow with the new layer");
+        copy.train(inputs, std::vector<std::vector<double>>(inputs.size(), {0.5}), 1, 0.01, 4);
+        TestFramework::assertEqual((size_t)35, copy.getParameterArena()->getOptimizer()->getState().buffers[0].size(),
+                                   "The optimizer state should cover the whole arena");
+    });
+
+    return suite;
+}
@@ -0,0 +1,251 @@
+#pragma once
+
+#include "test_framework.hpp"
+#include "../include/neuralnet.hpp"
+#include "../include/inference_plan.hpp"
+#include "../include/dense.hpp"
+#include "../include/activation.hpp"
+#include "../include/loss.hpp"
+#include "../include/optimizer.hpp"
+#include "../include/gemm.hpp"
+#include "../include/simd.hpp"
+#include "../include/utils.hpp"
+#include <vector>
+#include <memory>
+#include <cmath>
+
+namespace {
+    /**
+     * @brief Fills a double matrix with deterministic values in [-1, 1]
+     */
+    void fillPrecisionPattern(Matrix& m, unsigned seed) {
+        for (size_t k = 0; k < m.size(); ++k) {
+            m.data()[k] = std::sin(0.61 * (double)(k + 1) * (double)seed);
+        }
+    }
+
+    /**
+     * @brief Converts a double vector to float
+     */
+    std::vector<float> toFloatVector(const std::vector<double>& v) {
+        return std::vector<float>(v.begin(), v.end());
+    }
+
+    /**
+     * @brief Asserts |expected - actual| <= tol for every element of two equally sized buffers
+     */
+    template<typename F>
+    void checkClose(const double* expected, const F* actual, size_t n, double tol, const std::string& message) {
+        for (size_t i = 0; i < n; ++i) {
+            TestFramework::assertDoubleEqual(expected[i], (double)actual[i], tol, message);
+        }
+    }
+
+    /**
+     * @brief Builds matching double and float networks (8 -> 16 -> 12 -> 3) with identical parameters
+     */
+    void makePrecisionNets(NeuralNet& net, NeuralNetF& net_f) {
+        const int sizes[] = {8, 16, 12, 3};
+        const ActivationType acts[] = {ActivationType::Tanh, ActivationType::GELU, ActivationType::Sigmoid};
+        for (int l = 0; l < 3; ++l) {
+            auto dense = std::make_shared<Dense>(sizes[l], sizes[l + 1]);
+            auto dense_f = std::make_shared<DenseF>(sizes[l], sizes[l + 1]);
+            Matrix w(sizes[l + 1], sizes[l]);
+            fillPrecisionPattern(w, l + 1);
+            std::vector<double> b(sizes[l + 1]);
+            for (size_t i = 0; i < b.size(); ++i) b[i] = 0.1 * std::cos((double)(i + l));
+            dense->setWeights(w);
+            dense->setBiases(b);
+            dense_f->setWeights(MatrixF(w));
+            dense_f->setBiases(toFloatVector(b));
+
+            net.addLayer(dense);
+            net.addLayer(std::make_shared<Activation>(acts[l]));
+            net_f.addLayer(dense_f);
+            net_f.addLayer(std::make_shared<ActivationF>(acts[l]));
+        }
+        net.setLoss(std::make_shared<MSELoss>());
+        net_f.setLoss(std::make_shared<MSELossF>());
+    }
+}
+
+/**
+ * @brief Tests that the float instantiations match the double ones within float tolerance
+ * @return TestSuite with the results
+ */
+TestFramework::TestSuite runPrecisionTests() {
+    TestFramework::TestSuite suite("Precision");
+
+    suite.runTest("Float Gemm Matches Double", []() {
+        // Shapes straddle the 16-wide float register tile and the packing blocks
+        const size_t shapes[][3] = {{1, 1, 1}, {5, 17, 3}, {33, 47, 19}, {70, 130, 300}};
+        for (const auto& shape : shapes) {
+            const size_t m = shape[0], n = shape[1], k = shape[2];
+            for (bool tb : {false, true}) {
+                Matrix a(m, k);
+                Matrix b(tb ? n : k, tb ? k : n);
+                Matrix c(m, n);
+                fillPrecisionPattern(a, 1);
+                fillPrecisionPattern(b, 2);
+                fillPrecisionPattern(c, 3);
+                MatrixF a_f(a);
+                MatrixF b_f(b);
+                MatrixF c_f(c);
+
+                const Gemm::Transpose trans_b = tb ? Gemm::Transpose::Yes : Gemm::Transpose::No;
+                Gemm::gemm(Gemm::Transpose::No, trans_b, 0.5, a.view(), b.view(), 0.25, c.view());
+                Gemm::gemm(Gemm::Transpose::No, trans_b, 0.5f, a_f.view(), b_f.view(), 0.25f, c_f.view());
+                checkClose(c.data(), c_f.data(), c.size(), 2e-6 * (double)k, "float gemm differs from double");
+            }
+        }
+    });
+
+    suite.runTest("Float Gemv Matches Double", []() {
+        Matrix a(37, 53);
+        fillPrecisionPattern(a, 4);
+        MatrixF a_f(a);
+        std::vector<double> x(53);
+        for (size_t i = 0; i < x.size(); ++i) x[i] = std::cos(0.3 * (double)i);
+        std::vector<float> x_f = toFloatVector(x);
+
+        std::vector<double> y(37, 0.0);
+        std::vector<float> y_f(37, 0.0f);
+        Gemm::gemv(Gemm::Transpose::No, 37, 53, 1.0, a.data(), a.stride(), x.data(), 0.0, y.data());
+        Gemm::gemv(Gemm::Transpose::No, 37, 53, 1.0f, a_f.data(), a_f.stride(), x_f.data(), 0.0f, y_f.data());
+        checkClose(y.data(), y_f.data(), y.size(), 1e-4, "float gemv differs from double");
+    });
+
+    suite.runTest("Float Simd Kernels Match Double", []() {
+        // Every instruction set the CPU has, since each has its own float kernels
+        for (Simd::Isa isa : {Simd::Isa::Scalar, Simd::Isa::AVX2, Simd::Isa::AVX512}) {
+            if (!Simd::set_isa(isa)) {
+                continue;
+            }
+            std::vector<double> x(301);
+            for (size_t i = 0; i < x.size(); ++i) x[i] = -15.0 + 0.1 * (double)i;
+            std::vector<float> x_f = toFloatVector(x);
+            std::vector<double> y(x.size());
+            std::vector<float> y_f(x.size());
+
+            Simd::sigmoid(x.data(), y.data(), x.size());
+            Simd::sigmoid(x_f.data(), y_f.data(), x_f.size());
+            checkClose(y.data(), y_f.data(), y.size(), 1e-6, "float sigmoid differs from double");
+
+            Simd::tanh(x.data(), y.data(), x.size());
+            Simd::tanh(x_f.data(), y_f.data(), x_f.size());
+            checkClose(y.data(), y_f.data(), y.size(), 1e-6, "float tanh differs from double");
+
+            Simd::softmax(x.data(), y.data(), x.size());
+            Simd::softmax(x_f.data(), y_f.data(), x_f.size());
+            checkClose(y.data(), y_f.data(), y.size(), 1e-6, "float softmax differs from double");
+
+            // In place, as the activation layers use it
+            Simd::exp(x_f.data(), x_f.data(), x_f.size());
+            for (size_t i = 0; i < x.size(); ++i) {
+                TestFramework::assertDoubleEqual(std::exp(x[i]), x_f[i], 1e-6 * std::exp(x[i]), "float exp differs from std::exp");
+            }
+        }
+        Simd::set_isa(Simd::detect_isa());
+    });
+
+    suite.runTest("Float Network Prediction Matches Double", []() {
+        NeuralNet net;
+        NeuralNetF net_f;
+        makePrecisionNets(net, net_f);
+
+        Matrix inputs(40, 8);
+        fillPrecisionPattern(inputs, 5);
+        MatrixF inputs_f(inputs);
+
+        Matrix outputs = net.predict_batch(inputs);
+        MatrixF outputs_f = net_f.predict_batch(inputs_f);
+        checkClose(outputs.data(), outputs_f.data(), outputs.size(), 1e-5, "float predict_batch differs from double");
+
+        std::vector<double> input(inputs.row(3), inputs.row(3) + 8);
+        std::vector<double> output = net.predict(input);
+        std::vector<float> output_f = net_f.predict(toFloatVector(input));
+        checkClose(output.data(), output_f.data(), output.size(), 1e-5, "float predict differs from double");
+
+        InferencePlanF plan(net_f, 8);
+        std::vector<float> planned(plan.output_size());
+        plan.predict(toFloatVector(input), planned);
+        checkClose(output.data(), planned.data(), output.size(), 1e-5, "float inference plan differs from double");
+    });
+
+    suite.runTest("Float Loss Matches Double", []() {
+        Matrix predicted(6, 5);
+        Matrix actual(6, 5);
+        fillPrecisionPattern(predicted, 6);
+        fillPrecisionPattern(actual, 7);
+        MSELoss loss;
+        MSELossF loss_f;
+
+        TestFramework::assertDoubleEqual(loss.compute_batch(predicted, actual),
+                                         loss_f.compute_batch(MatrixF(predicted), MatrixF(actual)), 1e-6,
+                                         "float batch loss differs from double");
+        Matrix grad = loss.gradient_batch(predicted, actual);
+        MatrixF grad_f = loss_f.gradient_batch(MatrixF(predicted), MatrixF(actual));
+        checkClose(grad.data(), grad_f.data(), grad.size(), 1e-7, "float loss gradient differs from double");
+    });
+
+    suite.runTest("Float Optimizers Match Double", []() {
+        std::vector<double> w(23);
+        std::vector<double> g(23);
+        for (size_t i = 0; i < w.size(); ++i) {
+            w[i] = std::sin((double)i);
+            g[i] = 0.5 * std::cos(1.7 * (double)i);
+        }
+
+        std::vector<std::unique_ptr<Optimizer>> optimizers;
+        std::vector<std::unique_ptr<OptimizerF>> optimizers_f;
+        optimizers.push_back(std::make_unique<SGD>(0.05, 0.9));
+        optimizers_f.push_back(std::make_unique<SGDF>(0.05, 0.9));
+        optimizers.push_back(std::make_unique<Adam>(0.01));
+        optimizers_f.push_back(std::make_unique<AdamF>(0.01));
+
+        for (size_t o = 0; o < optimizers.size(); ++o) {
+            std::vector<double> weights = w;
+            std::vector<float> weights_f = toFloatVector(w);
+            std::vector<float> g_f = toFloatVector(g);
+            for (int step = 0; step < 10; ++step) {
+                optimizers[o]->update(weights, g);
+                optimizers_f[o]->update(weights_f, g_f);
+            }
+            checkClose(weights.data(), weights_f.data(), weights.size(), 1e-5, "float optimizer step differs from double");
+        }
+    });
+
+    suite.runTest("Float Training Tracks Double", []() {
+        NeuralNet net;
+        NeuralNetF net_f;
+        makePrecisionNets(net, net_f);
+
+        std::vector<std::vector<double>> inputs;
+        std::vector<std::vector<double>> targets;
+        for (int s = 0; s < 16; ++s) {
+            std::vector<double> x(8);
+            for (size_t i = 0; i < x.size(); ++i) x[i] = std::sin(0.9 * (double)(s * 8 + i));
+            inputs.push_back(x);
+            targets.push_back({0.5 + 0.4 * x[0], 0.5 - 0.3 * x[1], 0.5});
+        }
+        std::vector<std::vector<float>> inputs_f;
+        std::vector<std::vector<float>> targets_f;
+        for (size_t s = 0; s < inputs.size(); ++s) {
+            inputs_f.push_back(toFloatVector(inputs[s]));
+            targets_f.push_back(toFloatVector(targets[s]));
+        }
+
+        for (size_t batch_size : {1, 4}) {
+            net.train(inputs, targets, 5, 0.1, batch_size);
+            net_f.train(inputs_f, targets_f, 5, 0.1, batch_size);
+
+            for (size_t s = 0; s < inputs.size(); ++s) {
+                std::vector<double> output = net.predict(inputs[s]);
+                std::vector<float> output_f = net_f.predict(inputs_f[s]);
+                checkClose(output.data(), output_f.data(), output.size(), 1e-4, "float training diverged from double");
+            }
+        }
+    });
+
+    return suite;
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "test_framework.hpp"
+#include "../include/quantization.hpp"
+#include "../include/quantized_dense.hpp"
+#include "../include/inference_plan.hpp"
+#include "../include/dense.hpp"
+#include "../include/activation.hpp"
+#include "../include/loss.hpp"
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    /**
+     * @brief Builds a small trained-looking network (6 -> 24 -> 16 -> 4) with deterministic weights
+     */
+    template<typename T>
+    BasicNeuralNet<T> makeQuantizationNet() {
+        BasicNeuralNet<T> net;
+        const int sizes[] = {6, 24, 16, 4};
+        for (int l = 0; l < 3; ++l) {
+            auto dense = std::make_shared<BasicDense<T>>(sizes[l], sizes[l + 1]);
+            BasicMatrix<T> w(sizes[l + 1], sizes[l]);
+            for (size_t k = 0; k < w.size(); ++k) {
+                w.data()[k] = static_cast<T>(0.5 * std::sin(0.7 * (double)(k + 1) * (double)(l + 1)));
+            }
+            std::vector<T> b(sizes[l + 1]);
+            for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<T>(0.05 * std::cos((double)i));
+            dense->setWeights(w);
+            dense->setBiases(b);
+            net.addLayer(dense);
+            if (l < 2) {
+                net.addLayer(std::make_shared<BasicActivation<T>>(ActivationType::Tanh));
+            }
+        }
+        net.setLoss(std::make_shared<BasicMSELoss<T>>());
+        return net;
+    }
+
+    /**
+     * @brief Deterministic sample inputs in [-1, 1]
+     */
+    template<typename T>
+    BasicMatrix<T> makeQuantizationInputs(size_t rows, size_t cols, unsigned seed) {
+        BasicMatrix<T> inputs(rows, cols);
+        for (size_t k = 0; k < inputs.size(); ++k) {
+            inputs.data()[k] = static_cast<T>(std::sin(1.3 * (double)(k + 1) * (double)seed));
+        }
+        return inputs;
+    }
+}
+
+/**
+ * @brief Tests for int8 quantization
+ * @return TestSuite with the results
+ */
+TestFramework::TestSuite runQuantizationTests() {
+    TestFramework::TestSuite suite("Quantization");
+
+    suite.runTest("QuantizedDense Per-Channel Scales", []() {
+        Dense dense(3, 2);
+        Matrix w(2, 3);
+        w(0, 0) = 0.5;  w(0, 1) = -1.27; w(0, 2) = 0.0;
+        w(1, 0) = 0.01; w(1, 1) = 0.02;  w(1, 2) = -0.03;
+        dense.setWeights(w);
+        dense.setBiases(std::vector<double>{0.25, -0.5});
+
+        QuantizedDense quantized(dense, 2.54);
+        TestFramework::assertDoubleEqual(0.01, quantized.getWeightScales()[0], 1e-15, "Row 0 scale should be max|w| / 127");
+        TestFramework::assertDoubleEqual(0.03 / 127, quantized.getWeightScales()[1], 1e-15, "Row 1 scale should be max|w| / 127");
+        TestFramework::assertDoubleEqual(0.02, quantized.getInputScale(), 1e-15, "Input scale should be range / 127");
+
+        const auto& q = quantized.getWeights();
+        TestFramework::assertEqual(6, (int)q.size(), "One byte per weight");
+        TestFramework::assertEqual(50, (int)q[0], "Weight quantized incorrectly");
+        TestFramework::assertEqual(-127, (int)q[1], "Largest weight should map to -127");
+        TestFramework::assertEqual(-127, (int)q[5], "Each row uses its own scale");
+
+        // x = {1, 2, 100}: the last input is clamped to the calibrated range 2.54
+        std::vector<double> output = quantized.forward({1.0, 2.0, 100.0});
+        TestFramework::assertDoubleEqual(0.5 * 1.0 - 1.27 * 2.0 + 0.25, output[0], 1e-12, "Quantized output incorrect");
+        // Row 1 weights are not multiples of their scale, so allow one rounding step per weight
+        TestFramework::assertDoubleEqual(0.01 + 0.04 - 0.03 * 2.54 - 0.5, output[1], 1e-4, "Clamped output incorrect");
+    });
+
+    suite.runTest("QuantizedDense Is Inference-Only", []() {
+        Dense dense(4, 3);
+        QuantizedDense quantized(dense, 1.0);
+        TestFramework::assertEqual((size_t)0, quantized.parameter_count(), "No trainable parameters");
+        TestFramework::assertThrows<std::runtime_error>([&]() {
+            quantized.backward({1.0, 1.0, 1.0}, 0.1);
+        }, "backward should throw");
+        TestFramework::assertThrows<std::runtime_error>([&]() {
+            quantized.backward_batch(Matrix(2, 3), 0.1);
+        }, "backward_batch should throw");
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            QuantizedDense bad(dense, -1.0);
+        }, "Negative input range should throw");
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            quantized.output_size(5);
+        }, "Wrong input size should throw");
+    });
+
+    suite.runTest("Calibration Records Layer Input Ranges", []() {
+        NeuralNet net = makeQuantizationNet<double>();
+        Matrix inputs = makeQuantizationInputs<double>(20, 6, 1);
+        std::vector<double> ranges = Quantization::calibrate(net, inputs);
+
+        TestFramework::assertEqual(net.getLayers().size(), ranges.size(), "One range per layer");
+        double expected = 0.0;
+        for (size_t k = 0; k < inputs.size(); ++k) expected = std::max(expected, std::fabs(inputs.data()[k]));
+        TestFramework::assertDoubleEqual(expected, ranges[0], 0.0, "First range should cover the raw inputs");
+        TestFramework::assertTrue(ranges[2] <= 1.0, "Inputs after tanh should be within [-1, 1]");
+    });
+
+    suite.runTest("Quantized Network Matches Original", []() {
+        NeuralNet net = makeQuantizationNet<double>();
+        Matrix calibration = makeQuantizationInputs<double>(128, 6, 3);
+        NeuralNet quantized = Quantization::quantize(net, calibration);
+
+        for (const auto& layer : quantized.getLayers()) {
+            TestFramework::assertTrue(dynamic_cast<const Dense*>(layer.get()) == nullptr, "No Dense layer should remain");
+        }
+        TestFramework::assertTrue(quantized.getLoss() != nullptr, "Loss function should be kept");
+
+        // Drawn from the calibration distribution, so nothing is clamped
+        Matrix inputs = makeQuantizationInputs<double>(32, 6, 3);
+        Matrix expected = net.predict_batch(inputs);
+        Matrix actual = quantized.predict_batch(inputs);
+        for (size_t k = 0; k < expected.size(); ++k) {
+            TestFramework::assertDoubleEqual(expected.data()[k], actual.data()[k], 0.05, "Quantized output too far from original");
+        }
+
+        // The single-sample path and the inference plan agree with the batched one
+        InferencePlan plan(quantized, 6);
+        std::vector<double> planned(plan.output_size());
+        for (size_t r = 0; r < inputs.rows(); ++r) {
+            std::vector<double> input(inputs.row(r), inputs.row(r) + 6);
+            std::vector<double> output = quantized.predict(input);
+            plan.predict(input, planned);
+            for (size_t i = 0; i < output.size(); ++i) {
+                TestFramework::assertDoubleEqual(actual(r, i), output[i], 1e-12, "predict differs from predict_batch");
+                TestFramework::assertDoubleEqual(actual(r, i), planned[i], 1e-12, "InferencePlan differs from predict_batch");
+            }
+        }
+
+        // The original network is untouched and still trainable
+        TestFramework::assertTrue(dynamic_cast<const Dense*>(net.getLayers()[0].get()) != nullptr, "Original should keep Dense layers");
+    });
+
+    suite.runTest("Quantized Float Network Matches Original", []() {
+        NeuralNetF net = makeQuantizationNet<float>();
+        NeuralNetF quantized = Quantization::quantize(net, makeQuantizationInputs<float>(128, 6, 5));
+
+        MatrixF inputs = makeQuantizationInputs<float>(16, 6, 5);
+        MatrixF expected = net.predict_batch(inputs);
+        MatrixF actual = quantized.predict_batch(inputs);
+        for (size_t k = 0; k < expected.size(); ++k) {
+            TestFramework::assertDoubleEqual(expected.data()[k], actual.data()[k], 0.05, "Quantized float output too far from original");
+        }
+    });
+
+    return suite;
+}
@@ -110,5 +110,94 @@ TestFramework::TestSuite runReplayBufferTests() {
         );
     });
 
+    // Transitions are gathered straight from the columns into a reusable batch
+    suite.runTest("ReplayBuffer Sample Into Batch", []() {
+        ReplayBuffer buffer(8, 3);
+        TestFramework::assertEqual(3, (int)buffer.getStateSize(), "Preallocated buffer should know its state size");
+        for (int i = 0; i < 11; ++i) {
+            const std::vector<double> state = {(double)i, i + 0.5, -(double)i};
+            const std::vector<double> next_state = {i + 1.0, i + 1.5, -(i + 1.0)};
+            buffer.push(state, i, 0.1 * i, next_state, i % 3 == 0);
+        }
+
+        ReplayBatch batch;
+        buffer.sample(5, batch);
+        TestFramework::assertEqual(5, (int)batch.states.rows(), "Batch should have one state row per sample");
+        TestFramework::assertEqual(3, (int)batch.next_states.cols(), "Batch rows should have the state size");
+        std::unordered_set<size_t> slots(batch.indices.begin(), batch.indices.end());
+        TestFramework::assertEqual(5, (int)slots.size(), "Samples should be distinct");
+        for (size_t r = 0; r < 5; ++r) {
+            const int i = batch.actions[r];
+            TestFramework::assertTrue(i >= 3 && i <= 10, "Only the most recent transitions should be sampled");
+            TestFramework::assertDoubleEqual(i + 0.5, batch.states(r, 1), 0.0, "State row should match the action");
+            TestFramework::assertDoubleEqual(-(i + 1.0), batch.next_states(r, 2), 0.0, "Next state row should match the action");
+            TestFramework::assertDoubleEqual(0.1 * i, batch.rewards[r], 0.0, "Reward should match the action");
+            TestFramework::assertEqual(i % 3 == 0 ? 1 : 0, (int)batch.dones[r], "Done flag should match the action");
+        }
+
+        // A reused batch of the same size does not allocate
+        const size_t before = Memory::allocation_count();
+        buffer.sample(5, batch);
+        buffer.sample(3, batch);
+        TestFramework::assertEqual(before, Memory::allocation_count(), "Sampling into a sized batch should not allocate");
+        TestFramework::assertEqual(3, (int)batch.states.rows(), "Batch should shrink to the requested size");
+    });
+
+    // The state size is fixed by the constructor or the first push
+    suite.runTest("ReplayBuffer State Size", []() {
+        ReplayBuffer buffer(4);
+        TestFramework::assertEqual(0, (int)buffer.getStateSize(), "State size should be unknown before the first push");
+        buffer.push({{1.0, 2.0}, 0, 0.5, {3.0, 4.0}, false});
+        TestFramework::assertEqual(2, (int)buffer.getStateSize(), "The first push should fix the state size");
+
+        Experience wrong = {{1.0, 2.0, 3.0}, 0, 0.5, {3.0, 4.0, 5.0}, false};
+        TestFramework::assertThrows<std::invalid_argument>([&]() { buffer.push(wrong); },
+                                                           "A different state size should be rejected");
+        Experience mismatched = {{1.0, 2.0}, 0, 0.5, {3.0}, false};
+        TestFramework::assertThrows<std::invalid_argument>([&]() { buffer.push(mismatched); },
+                                                           "A next state of another size should be rejected");
+        TestFramework::assertEqual(1, (int)buffer.size(), "Rejected pushes should not be stored");
+        TestFramework::assertThrows<std::invalid_argument>([]() { ReplayBuffer empty(0); },
+                                                           "A zero capacity should be rejected");
+    });
+
+    // Every mode draws slots in use with the right multiplicity and roughly uniformly
+    suite.runTest("ReplayBuffer Sampling Modes", []() {
+        ReplayBuffer buffer(64, 1);
+        for (int i = 0; i < 40; ++i) {
+            buffer.push(std::vector<double>{(double)i}, i, 0.0, std::vector<double>{0.0}, false);
+        }
+        TestFramework::assertTrue(buffer.getSampling() == SamplingMode::WithoutReplacement,
+                                  "Sampling without replacement should be the default");
+
+        ReplayBatch batch;
+        for (SamplingMode mode : {SamplingMode::Scan, SamplingMode::WithReplacement, SamplingMode::WithoutReplacement}) {
+            buffer.setSampling(mode);
+            std::vector<int> counts(40, 0);
+            for (int round = 0; round < 500; ++round) {
+                buffer.sample(40, batch);
+                std::unordered_set<size_t> slots;
+                for (size_t r = 0; r < 40; ++r) {
+                    TestFramework::assertTrue(batch.indices[r] < 40, "Only slots in use should be drawn");
+                    TestFramework::assertEqual((int)batch.indices[r], batch.actions[r], "Rows should match their slots");
+                    slots.insert(batch.indices[r]);
+                }
+                if (mode != SamplingMode::WithReplacement) {
+                    TestFramework::assertEqual(40, (int)slots.size(), "A full batch without replacement should draw every slot");
+                }
+
+                buffer.sample(4, batch);
+                for (size_t r = 0; r < 4; ++r) {
+                    ++counts[batch.indices[r]];
+                }
+            }
+
+            // 2000 draws over 40 slots: 50 expected per slot, a standard deviation of about 7
+            for (int count : counts) {
+                TestFramework::assertTrue(count > 15 && count < 85, "Slots should be drawn uniformly");
+            }
+        }
+    });
+
     return suite;
 }
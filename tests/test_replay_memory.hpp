@@ -0,0 +1,114 @@
+#pragma once
+
+#include "test_framework.hpp"
+#include "../include/replay_memory.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Tests for prioritized replay
+ * @return TestSuite with the results
+ */
+TestFramework::TestSuite runReplayMemoryTests() {
+    TestFramework::TestSuite suite("ReplayMemory");
+
+    suite.runTest("PriorityTree Sums And Search", []() {
+        // 5 slots round up to 8 leaves; the unused ones must never be found
+        PriorityTree tree(5);
+        TestFramework::assertDoubleEqual(0.0, tree.total(), 0.0, "A new tree should be empty");
+        TestFramework::assertTrue(std::isinf(tree.min()), "A new tree should have no minimum");
+        TestFramework::assertThrows<std::runtime_error>([&]() { tree.find(0.0); }, "Searching an empty tree should throw");
+
+        const double values[] = {1.0, 2.0, 0.5, 3.0, 1.5};
+        for (size_t i = 0; i < 5; ++i) {
+            tree.set(i, values[i]);
+        }
+        TestFramework::assertDoubleEqual(8.0, tree.total(), 1e-12, "Total should be the sum of the priorities");
+        TestFramework::assertDoubleEqual(0.5, tree.min(), 0.0, "Minimum should be the smallest priority");
+        TestFramework::assertEqual((size_t)0, tree.find(0.0), "Mass 0 should find the first slot");
+        TestFramework::assertEqual((size_t)0, tree.find(0.999), "Mass inside the first range should find the first slot");
+        TestFramework::assertEqual((size_t)1, tree.find(1.0), "A range should start at the previous cumulative sum");
+        TestFramework::assertEqual((size_t)2, tree.find(3.2), "Mass inside the third range should find the third slot");
+        TestFramework::assertEqual((size_t)3, tree.find(3.5), "Mass inside the fourth range should find the fourth slot");
+        TestFramework::assertEqual((size_t)4, tree.find(7.99), "Mass inside the last range should find the last slot");
+        TestFramework::assertEqual((size_t)4, tree.find(100.0), "Mass past the total should be clamped to the last slot in use");
+
+        tree.set(2, 4.0);
+        TestFramework::assertDoubleEqual(11.5, tree.total(), 1e-12, "Updating a slot should update the total");
+        TestFramework::assertDoubleEqual(1.0, tree.min(), 0.0, "Updating the minimum should update the minimum");
+        TestFramework::assertDoubleEqual(4.0, tree.get(2), 0.0, "get should return the leaf priority");
+        TestFramework::assertThrows<std::out_of_range>([&]() { tree.set(8, 1.0); }, "Index past the leaves should throw");
+        TestFramework::assertThrows<std::invalid_argument>([&]() { tree.set(1, 0.0); }, "A zero priority should throw");
+        TestFramework::assertThrows<std::invalid_argument>([]() { PriorityTree empty(0); }, "A zero capacity should throw");
+    });
+
+    suite.runTest("ReplayMemory Proportional Sampling", []() {
+        ReplayMemory memory(4, 2, 1.0, 1e-12);
+        for (int i = 0; i < 4; ++i) {
+            memory.push({{(double)i, 0.0}, i, 0.0, {0.0, (double)i}, false});
+        }
+        TestFramework::assertDoubleEqual(1.0, memory.getPriority(3), 0.0, "New transitions should get the initial maximum priority");
+
+        const std::vector<size_t> slots = {0, 1, 2, 3};
+        memory.update_priorities(slots, std::vector<double>{1.0, 2.0, 3.0, 4.0});
+
+        ReplayBatch batch;
+        std::vector<double> counts(4, 0.0);
+        const int rounds = 4000;
+        for (int round = 0; round < rounds; ++round) {
+            memory.sample(4, 1.0, batch);
+            for (size_t k = 0; k < 4; ++k) {
+                const size_t slot = batch.indices[k];
+                counts[slot] += 1.0;
+                TestFramework::assertEqual((int)slot, batch.actions[k], "Rows should be gathered from the sampled slot");
+                TestFramework::assertDoubleEqual(1.0 / (slot + 1.0), batch.weights[k], 1e-9,
+                                                 "Weights should be (p / p_min)^-beta");
+            }
+        }
+        for (size_t slot = 0; slot < 4; ++slot) {
+            TestFramework::assertDoubleEqual((slot + 1.0) / 10.0, counts[slot] / (4.0 * rounds), 0.02,
+                                             "Slots should be sampled in proportion to priority");
+        }
+
+        // A new transition gets the largest priority seen so far and overwrites the oldest slot
+        memory.push({{9.0, 0.0}, 9, 0.0, {0.0, 9.0}, true});
+        TestFramework::assertDoubleEqual(4.0, memory.getPriority(0), 1e-9, "New transitions should get the maximum priority");
+        TestFramework::assertEqual((size_t)4, memory.size(), "Size should be capped at capacity");
+    });
+
+    suite.runTest("ReplayMemory Uniform Limit And Errors", []() {
+        ReplayMemory memory(1 << 16, 1, 0.0);
+        TestFramework::assertFalse(memory.is_ready(1), "A new memory should be empty");
+        for (int i = 0; i < 100; ++i) {
+            memory.push(std::vector<double>{(double)i}, i, 0.0, std::vector<double>{0.0}, false);
+        }
+        std::vector<size_t> slots = {5, 7};
+        memory.update_priorities(slots, std::vector<double>{10.0, 0.0});
+        TestFramework::assertDoubleEqual(1.0, memory.getPriority(5), 0.0, "Alpha 0 should make every priority 1");
+
+        ReplayBatch batch;
+        memory.sample(32, 0.4, batch);
+        for (size_t k = 0; k < 32; ++k) {
+            TestFramework::assertTrue(batch.indices[k] < 100, "Only slots in use should be sampled");
+            TestFramework::assertDoubleEqual(1.0, batch.weights[k], 0.0, "Uniform sampling should have unit weights");
+        }
+
+        TestFramework::assertThrows<std::runtime_error>([&]() { memory.sample(101, 0.4, batch); },
+                                                        "Sampling more than stored should throw");
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            memory.update_priorities(slots, std::vector<double>{1.0});
+        }, "Mismatched spans should throw");
+        TestFramework::assertThrows<std::invalid_argument>([&]() {
+            memory.update_priorities(slots, std::vector<double>{1.0, -1.0});
+        }, "Negative priorities should throw");
+        TestFramework::assertThrows<std::out_of_range>([&]() {
+            memory.update_priorities(std::vector<size_t>{100}, std::vector<double>{1.0});
+        }, "Unused slots should throw");
+        TestFramework::assertThrows<std::invalid_argument>([]() { ReplayMemory bad(4, 1, 0.6, 0.0); },
+                                                           "A zero epsilon should throw");
+    });
+
+    return suite;
+}
@@ -1,11 +1,27 @@
 #include "test_framework.hpp"
 #include "test_utils.hpp"
+#include "test_matrix.hpp"
+#include "test_gemm.hpp"
+#include "test_simd.hpp"
 #include "test_activation.hpp"
 #include "test_dense.hpp"
 #include "test_loss.hpp"
+#include "test_thread_pool.hpp"
 #include "test_neuralnet.hpp"
+#include "test_parallel_trainer.hpp"
+#include "test_hogwild_trainer.hpp"
+#include "test_inference_plan.hpp"
 #include "test_optimizer.hpp"
+#include "test_precision.hpp"
+#include "test_quantization.hpp"
+#include "test_serialization.hpp"
+#include "test_checkpoint.hpp"
+#include "test_parameter_arena.hpp"
+#include "test_step_arena.hpp"
 #include "test_replay_buffer.hpp"
+#include "test_replay_memory.hpp"
+#include "test_concurrent_replay_buffer.hpp"
+#include "test_frame_replay_buffer.hpp"
 
 #include <iostream>
 #include <vector>
@@ -18,12 +34,28 @@ int main() {
 
     // Run all test suites
     testSuites.push_back(runUtilsTests());
+    testSuites.push_back(runMatrixTests());
+    testSuites.push_back(runGemmTests());
+    testSuites.push_back(runSimdTests());
     testSuites.push_back(runActivationTests());
     testSuites.push_back(runDenseTests());
     testSuites.push_back(runLossTests());
+    testSuites.push_back(runThreadPoolTests());
     testSuites.push_back(runNeuralNetTests());
+    testSuites.push_back(runParallelTrainerTests());
+    testSuites.push_back(runHogwildTrainerTests());
+    testSuites.push_back(runInferencePlanTests());
     testSuites.push_back(runOptimizerTests());
+    testSuites.push_back(runPrecisionTests());
+    testSuites.push_back(runQuantizationTests());
+    testSuites.push_back(runSerializationTests());
+    testSuites.push_back(runCheckpointTests());
+    testSuites.push_back(runParameterArenaTests());
+    testSuites.push_back(runStepArenaTests());
     testSuites.push_back(runReplayBufferTests());
+    testSuites.push_back(runReplayMemoryTests());
+    testSuites.push_back(runConcurrentReplayBufferTests());
+    testSuites.push_back(runFrameReplayBufferTests());
 
     // Calculate summary
     int totalTests = 0;
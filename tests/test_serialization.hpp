@@ -0,0 +1,136 @@
+#pragma once
+
+#include "test_framework.hpp"
+#include "test_fixtures.hpp"
+#include "../include/neuralnet.hpp"
+#include "../include/dense.hpp"
+#include "../include/activation.hpp"
+#include "../include/loss.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    /**
+     * @brief Builds a network (5 -> 7 -> 3) covering Dense, a parameterized and a plain activation
+     */
+    template<typename T>
+    BasicNeuralNet<T> makeSerializationNet() {
+        BasicNeuralNet<T> net;
+        net.addLayer(std::make_shared<BasicDense<T>>(5, 7));
+        net.addLayer(std::make_shared<BasicActivation<T>>(ActivationType::LeakyReLU, 0.2));
+        net.addLayer(std::make_shared<BasicDense<T>>(7, 3));
+        net.addLayer(std::make_shared<BasicActivation<T>>(ActivationType::Softmax));
+        net.setLoss(std::make_shared<BasicMSELoss<T>>());
+        return net;
+    }
+}
+
+/**
+ * @brief Tests for binary model files
+ * @return TestSuite with the results
+ */
+TestFramework::TestSuite runSerializationTests() {
+    TestFramework::TestSuite suite("Serialization");
+
+    suite.runTest("Model Round Trip", []() {
+        const std::string path = scratchPath("round_trip", ".npm");
+        NeuralNet net = makeSerializationNet<double>();
+        net.save(path);
+
+        NeuralNet loaded;
+        loaded.load(path);
+        TestFramework::assertEqual(net.getLayers().size(), loaded.getLayers().size(), "Layer count should match");
+
+        const auto* activation = dynamic_cast<const Activation*>(loaded.getLayers()[1].get());
+        TestFramework::assertTrue(activation != nullptr, "Layer 1 should be an Activation");
+        TestFramework::assertTrue(activation->getType() == ActivationType::LeakyReLU, "Activation type should be kept");
+        TestFramework::assertDoubleEqual(0.2, activation->getAlpha(), 0.0, "LeakyReLU slope should be kept");
+
+        Matrix inputs(9, 5);
+        for (size_t k = 0; k < inputs.size(); ++k) inputs.data()[k] = std::sin(0.4 * (double)k);
+        Matrix expected = net.predict_batch(inputs);
+        Matrix actual = loaded.predict_batch(inputs);
+        for (size_t k = 0; k < expected.size(); ++k) {
+            TestFramework::assertDoubleEqual(expected.data()[k], actual.data()[k], 0.0, "Loaded network should predict identically");
+        }
+        std::remove(path.c_str());
+    });
+
+    suite.runTest("Model Load Maps Weights Without Copying", []() {
+        const std::string path = scratchPath("mapped", ".npm");
+        NeuralNetF net = makeSerializationNet<float>();
+        net.save(path);
+
+        NeuralNetF loaded;
+        loaded.setLoss(std::make_shared<MSELossF>());
+        loaded.load(path);
+        for (size_t l : {0, 2}) {
+            const auto* dense = dynamic_cast<const DenseF*>(loaded.getLayers()[l].get());
+            TestFramework::assertTrue(dense != nullptr, "Dense layer expected");
+            TestFramework::assertTrue(dense->getWeights().borrowed(), "Weights should point into the mapped file");
+            TestFramework::assertEqual((std::uintptr_t)0, (std::uintptr_t)dense->getWeights().data() % 64,
+                                       "Mapped weights should be 64-byte aligned");
+        }
+
+        // Training writes to private pages; the file still holds the saved weights
+        std::vector<std::vector<float>> inputs = {{0.1f, 0.2f, 0.3f, 0.4f, 0.5f}};
+        std::vector<std::vector<float>> targets = {{1.0f, 0.0f, 0.0f}};
+        std::vector<float> before = loaded.predict(inputs[0]);
+        loaded.train(inputs, targets, 3, 0.5);
+        TestFramework::assertTrue(loaded.predict(inputs[0]) != before, "Training should change the loaded network");
+
+        NeuralNetF reloaded;
+        reloaded.load(path);
+        std::vector<float> original = net.predict(inputs[0]);
+        std::vector<float> from_file = reloaded.predict(inputs[0]);
+        for (size_t i = 0; i < original.size(); ++i) {
+            TestFramework::assertDoubleEqual(original[i], from_file[i], 0.0, "Training must not modify the model file");
+        }
+
+        // Saving over a mapped file leaves the mapped network intact
+        std::vector<float> trained = loaded.predict(inputs[0]);
+        makeSerializationNet<float>().save(path);
+        TestFramework::assertTrue(loaded.predict(inputs[0]) == trained, "Replacing the file should not affect mapped layers");
+        std::remove(path.c_str());
+    });
+
+    suite.runTest("Model Load Rejects Bad Files", []() {
+        const std::string path = scratchPath("bad", ".npm");
+        makeSerializationNet<double>().save(path);
+
+        NeuralNetF wrong_type;
+        TestFramework::assertThrows<std::runtime_error>([&]() { wrong_type.load(path); },
+                                                        "Loading a double model as float should throw");
+
+        NeuralNet net;
+        const std::uint32_t version = 99;
+        patchFile(path, 8, &version, sizeof(version));
+        TestFramework::assertThrows<std::runtime_error>([&]() { net.load(path); }, "Unknown version should throw");
+
+        patchFile(path, 0, "NOTAMODL", 8);
+        TestFramework::assertThrows<std::runtime_error>([&]() { net.load(path); }, "Bad magic should throw");
+
+        makeSerializationNet<double>().save(path);
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+        TestFramework::assertThrows<std::runtime_error>([&]() { net.load(path); }, "Truncated file should throw");
+        TestFramework::assertTrue(net.getLayers().empty(), "A failed load should leave the network unchanged");
+
+        std::remove(path.c_str());
+        TestFramework::assertThrows<std::runtime_error>([&]() { net.load(path); }, "Missing file should throw");
+    });
+
+    suite.runTest("Model Save Rejects Custom Activations", []() {
+        NeuralNet net;
+        net.addLayer(std::make_shared<Dense>(2, 2));
+        net.addLayer(std::make_shared<Activation>([](double x) { return x; }, [](double) { return 1.0; }));
+        TestFramework::assertThrows<std::invalid_argument>([&]() { net.save(scratchPath("custom", ".npm")); },
+                                                           "Custom activations cannot be saved");
+    });
+
+    return suite;
+}
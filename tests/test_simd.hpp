@@ -0,0 +1,210 @@
+#pragma once
+
+#include "test_framework.hpp"
+#include "../include/simd.hpp"
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <string>
+
+namespace {
+    /**
+     * @brief Instruction sets the running CPU can execute
+     */
+    std::vector<Simd::Isa> supportedIsas() {
+        std::vector<Simd::Isa> isas;
+        for (Simd::Isa isa : {Simd::Isa::Scalar, Simd::Isa::AVX2, Simd::Isa::AVX512}) {
+            if (Simd::set_isa(isa)) {
+                isas.push_back(isa);
+            }
+        }
+        Simd::set_isa(Simd::detect_isa());
+        return isas;
+    }
+
+    /**
+     * @brief Inputs spanning [lo, hi]; n is deliberately not a multiple of the vector width
+     */
+    std::vector<double> simdInputs(double lo, double hi, size_t n) {
+        std::vector<double> x(n);
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = lo + (hi - lo) * (double)i / (double)(n - 1);
+        }
+        return x;
+    }
+
+    /**
+     * @brief Asserts |actual - expected| <= rel * |expected| + abs_tol for every element
+     */
+    void checkSimdResult(const std::vector<double>& expected, const std::vector<double>& actual,
+                         double rel, double abs_tol, const std::string& message) {
+        for (size_t i = 0; i < expected.size(); ++i) {
+            double tol = rel * std::fabs(expected[i]) + abs_tol;
+            TestFramework::assertDoubleEqual(expected[i], actual[i], tol, message);
+        }
+    }
+}
+
+/**
+ * @brief Tests for Simd functionality
+ * @return TestSuite with the results
+ */
+TestFramework::TestSuite runSimdTests() {
+    TestFramework::TestSuite suite("Simd");
+
+    suite.runTest("Exp Matches Reference", []() {
+        for (Simd::Isa isa : supportedIsas()) {
+            Simd::set_isa(isa);
+            std::vector<double> x = simdInputs(-700.0, 700.0, 1003);
+            std::vector<double> y(x.size());
+            std::vector<double> expected(x.size());
+            for (size_t i = 0; i < x.size(); ++i) expected[i] = std::exp(x[i]);
+
+            Simd::exp(x.data(), y.data(), x.size());
+            checkSimdResult(expected, y, 5e-16, 0.0, "exp differs from std::exp");
+        }
+        Simd::set_isa(Simd::detect_isa());
+    });
+
+    suite.runTest("Exp Edge Cases", []() {
+        const double inf = std::numeric_limits<double>::infinity();
+        for (Simd::Isa isa : supportedIsas()) {
+            Simd::set_isa(isa);
+            std::vector<double> x = {0.0, 710.0, -746.0, inf, -inf, std::nan("")};
+            std::vector<double> y(x.size());
+            Simd::exp(x.data(), y.data(), x.size());
+
+            TestFramework::assertDoubleEqual(1.0, y[0], 0.0, "exp(0) should be 1");
+            TestFramework::assertTrue(std::isinf(y[1]) && y[1] > 0, "exp overflow should give +inf");
+            TestFramework::assertDoubleEqual(0.0, y[2], 0.0, "exp underflow should give 0");
+            TestFramework::assertTrue(std::isinf(y[3]) && y[3] > 0, "exp(+inf) should give +inf");
+            TestFramework::assertDoubleEqual(0.0, y[4], 0.0, "exp(-inf) should give 0");
+            TestFramework::assertTrue(std::isnan(y[5]), "exp(NaN) should give NaN");
+        }
+        Simd::set_isa(Simd::detect_isa());
+    });
+
+    suite.runTest("Sigmoid And Tanh Match Reference", []() {
+        for (Simd::Isa isa : supportedIsas()) {
+            Simd::set_isa(isa);
+            for (size_t n : {1, 7, 13, 1001}) {
+                std::vector<double> x = simdInputs(-40.0, 40.0, n < 2 ? 2 : n);
+                std::vector<double> sig_expected(x.size());
+                std::vector<double> tanh_expected(x.size());
+                for (size_t i = 0; i < x.size(); ++i) {
+                    sig_expected[i] = 1.0 / (1.0 + std::exp(-x[i]));
+                    tanh_expected[i] = std::tanh(x[i]);
+                }
+
+                std::vector<double> y = x;
+                Simd::sigmoid(y.data(), y.data(), y.size());
+                checkSimdResult(sig_expected, y, 1e-15, 0.0, "sigmoid differs from reference");
+
+                y = x;
+                Simd::tanh(y.data(), y.data(), y.size());
+                checkSimdResult(tanh_expected, y, 1e-15, 5e-16, "tanh differs from reference");
+            }
+        }
+        Simd::set_isa(Simd::detect_isa());
+    });
+
+    suite.runTest("Softmax Matches Reference", []() {
+        for (Simd::Isa isa : supportedIsas()) {
+            Simd::set_isa(isa);
+            std::vector<double> x = simdInputs(-30.0, 50.0, 19);
+            double max_val = x.back();
+            double sum = 0.0;
+            std::vector<double> expected(x.size());
+            for (size_t i = 0; i < x.size(); ++i) {
+                expected[i] = std::exp(x[i] - max_val);
+                sum += expected[i];
+            }
+            for (double& e : expected) e /= sum;
+
+            std::vector<double> y(x.size());
+            Simd::softmax(x.data(), y.data(), x.size());
+            checkSimdResult(expected, y, 2e-15, 0.0, "softmax differs from reference");
+        }
+        Simd::set_isa(Simd::detect_isa());
+    });
+
+    suite.runTest("Float Kernels Match Reference", []() {
+        const float inf = std::numeric_limits<float>::infinity();
+        for (Simd::Isa isa : supportedIsas()) {
+            Simd::set_isa(isa);
+            // Lengths straddle the 8 and 16-wide float vector widths
+            for (size_t n : {1, 9, 17, 1001}) {
+                std::vector<double> x = simdInputs(-80.0, 80.0, n < 2 ? 2 : n);
+                std::vector<float> x_f(x.begin(), x.end());
+                std::vector<double> exp_expected(x.size()), sig_expected(x.size()), tanh_expected(x.size());
+                for (size_t i = 0; i < x.size(); ++i) {
+                    const double xi = (double)x_f[i];
+                    exp_expected[i] = std::exp(xi);
+                    sig_expected[i] = 1.0 / (1.0 + std::exp(-xi));
+                    tanh_expected[i] = std::tanh(xi);
+                }
+
+                std::vector<float> y(x_f.size());
+                Simd::exp(x_f.data(), y.data(), y.size());
+                checkSimdResult(exp_expected, std::vector<double>(y.begin(), y.end()), 2e-7, 0.0, "float exp differs from reference");
+
+                y = x_f;
+                Simd::sigmoid(y.data(), y.data(), y.size());
+                checkSimdResult(sig_expected, std::vector<double>(y.begin(), y.end()), 2e-7, 0.0,
+                                "float sigmoid differs from reference");
+
+                y = x_f;
+                Simd::tanh(y.data(), y.data(), y.size());
+                checkSimdResult(tanh_expected, std::vector<double>(y.begin(), y.end()), 2e-7, 1e-7,
+                                "float tanh differs from reference");
+            }
+
+            std::vector<float> edges = {0.0f, 89.0f, -104.0f, inf, -inf, std::nanf("")};
+            Simd::exp(edges.data(), edges.data(), edges.size());
+            TestFramework::assertDoubleEqual(1.0, edges[0], 0.0, "float exp(0) should be 1");
+            TestFramework::assertTrue(std::isinf(edges[1]) && edges[1] > 0, "float exp overflow should give +inf");
+            TestFramework::assertDoubleEqual(0.0, edges[2], 0.0, "float exp underflow should give 0");
+            TestFramework::assertTrue(std::isinf(edges[3]) && edges[3] > 0, "float exp(+inf) should give +inf");
+            TestFramework::assertDoubleEqual(0.0, edges[4], 0.0, "float exp(-inf) should give 0");
+            TestFramework::assertTrue(std::isnan(edges[5]), "float exp(NaN) should give NaN");
+        }
+        Simd::set_isa(Simd::detect_isa());
+    });
+
+    suite.runTest("Fused Adam Matches Reference", []() {
+        const double lr = 0.01, b1 = 0.9, b2 = 0.999, eps = 1e-8, wd = 0.05;
+        for (Simd::Isa isa : supportedIsas()) {
+            Simd::set_isa(isa);
+            // Lengths straddle the 4, 8 and 16-wide vector widths
+            for (size_t n : {0, 1, 7, 33}) {
+                std::vector<double> w = simdInputs(-1.0, 1.0, n + 2);
+                std::vector<double> g = simdInputs(0.5, -0.3, n + 2);
+                w.resize(n);
+                g.resize(n);
+                std::vector<double> m(n, 0.0), v(n, 0.0);
+                std::vector<double> expected = w, em(n, 0.0), ev(n, 0.0);
+                std::vector<float> w_f(w.begin(), w.end()), g_f(g.begin(), g.end()), m_f(n, 0.0f), v_f(n, 0.0f);
+
+                for (int t = 1; t <= 3; ++t) {
+                    for (size_t i = 0; i < n; ++i) {
+                        em[i] = b1 * em[i] + (1.0 - b1) * g[i];
+                        ev[i] = b2 * ev[i] + (1.0 - b2) * g[i] * g[i];
+                        const double m_hat = em[i] / (1.0 - std::pow(b1, t));
+                        const double v_hat = ev[i] / (1.0 - std::pow(b2, t));
+                        expected[i] -= lr * wd * expected[i] + lr * m_hat / (std::sqrt(v_hat) + eps);
+                    }
+                    const Simd::AdamCoefficients c = Simd::adam_coefficients(lr, b1, b2, eps, wd, t);
+                    Simd::adam(w.data(), g.data(), m.data(), v.data(), n, c);
+                    Simd::adam(w_f.data(), g_f.data(), m_f.data(), v_f.data(), n, c);
+                }
+                checkSimdResult(expected, w, 1e-14, 1e-15, "fused adam differs from reference");
+                checkSimdResult(ev, v, 1e-14, 0.0, "fused adam second moment differs from reference");
+                checkSimdResult(expected, std::vector<double>(w_f.begin(), w_f.end()), 1e-6, 1e-7,
+                                "float fused adam differs from reference");
+            }
+        }
+        Simd::set_isa(Simd::detect_isa());
+    });
+
+    return suite;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "test_framework.hpp"
+#include "../include/step_arena.hpp"
+#include "../include/neuralnet.hpp"
+#include "../include/dense.hpp"
+#include "../include/activation.hpp"
+#include "../include/loss.hpp"
+#include "../include/optimizer.hpp"
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace {
+    /**
+     * @brief Counts the aligned allocations made by training a fresh copy of net for the given epochs
+     */
+    size_t trainingAllocations(const NeuralNet& net, int epochs, size_t batch_size, size_t accumulation_steps) {
+        std::vector<std::vector<double>> inputs;
+        std::vector<std::vector<double>> targets;
+        for (int s = 0; s < 10; ++s) {
+            inputs.push_back({std::sin(0.6 * s), std::cos(0.2 * s), 0.1 * s});
+            targets.push_back({std::sin(0.6 * s) * 0.5});
+        }
+
+        NeuralNet copy(net);
+        const size_t before = Memory::allocation_count();
+        copy.train(inputs, targets, epochs, 0.05, batch_size, accumulation_steps);
+        return Memory::allocation_count() - before;
+    }
+}
+
+/**
+ * @brief Tests for the per-step bump allocator
+ * @return TestSuite with the results
+ */
+TestFramework::TestSuite runStepArenaTests() {
+    TestFramework::TestSuite suite("StepArena");
+
+    suite.runTest("Bump Allocation And Reset", []() {
+        StepArena arena(1024);
+        TestFramework::assertEqual((size_t)0, arena.capacity(), "A new arena should not allocate");
+
+        double* a = arena.allocate<double>(3);
+        float* b = arena.allocate<float>(1);
+        TestFramework::assertTrue(reinterpret_cast<std::uintptr_t>(a) % 64 == 0, "Allocations should be 64-byte aligned");
+        TestFramework::assertTrue(reinterpret_cast<std::uintptr_t>(b) % 64 == 0, "Allocations should be 64-byte aligned");
+        TestFramework::assertTrue(reinterpret_cast<unsigned char*>(b) == reinterpret_cast<unsigned char*>(a) + 64,
+                                  "Allocations should be consecutive");
+        TestFramework::assertEqual((size_t)128, arena.used(), "Used bytes should include the padding");
+
+        // A request larger than the block size gets a block of its own
+        double* big = arena.allocate<double>(1000);
+        TestFramework::assertEqual((size_t)2, arena.getBlockAllocations(), "A large request should add a block");
+
+        arena.reset();
+        TestFramework::assertEqual((size_t)0, arena.used(), "Reset should release everything");
+        TestFramework::assertTrue(arena.allocate<double>(3) == a, "Reset should reuse the same memory");
+        arena.allocate<float>(1);
+        TestFramework::assertTrue(arena.allocate<double>(1000) == big, "The same sequence should get the same blocks");
+        TestFramework::assertEqual((size_t)2, arena.getBlockAllocations(), "A repeated step should not allocate");
+    });
+
+    suite.runTest("Scopes And Scratch Matrices", []() {
+        TestFramework::assertTrue(StepArena::active() == nullptr, "No arena should be active by default");
+        Matrix heap = scratch_matrix<double>(2, 3);
+        TestFramework::assertFalse(heap.borrowed(), "Without an arena scratch matrices should own their storage");
+        TestFramework::assertDoubleEqual(0.0, heap(1, 2), 0.0, "Heap scratch matrices should be zero-filled");
+
+        StepArena outer;
+        StepArena inner;
+        {
+            StepArena::Scope outer_scope(outer);
+            Matrix m = scratch_matrix<double>(2, 3);
+            TestFramework::assertTrue(m.borrowed(), "Scratch matrices should come from the active arena");
+            TestFramework::assertEqual((size_t)64, outer.used(), "The matrix should be placed in the outer arena");
+            {
+                StepArena::Scope inner_scope(inner);
+                TestFramework::assertTrue(StepArena::active() == &inner, "The innermost scope should win");
+                Matrix n = scratch_matrix<double>(4, 4);
+                TestFramework::assertEqual((size_t)128, inner.used(), "The matrix should be placed in the inner arena");
+            }
+            TestFramework::assertTrue(StepArena::active() == &outer, "Closing a scope should restore the previous arena");
+
+            // Copies of arena matrices own their storage and survive a reset
+            Matrix kept = m;
+            TestFramework::assertFalse(kept.borrowed(), "A copy should own its storage");
+        }
+        TestFramework::assertTrue(StepArena::active() == nullptr, "All scopes should be closed");
+    });
+
+    suite.runTest("Steady-State Training Does Not Allocate", []() {
+        NeuralNet net;
+        auto hidden = std::make_shared<Dense>(3, 8);
+        auto output = std::make_shared<Dense>(8, 1);
+        hidden->setOptimizer(std::make_unique<Adam>(0.01));
+        output->setOptimizer(std::make_unique<Adam>(0.01));
+        net.addLayer(hidden);
+        net.addLayer(std::make_shared<Activation>(ActivationType::Tanh));
+        net.addLayer(output);
+        net.setLoss(std::make_shared<MSELoss>());
+        NeuralNet flat(net);
+        flat.setOptimizer(std::make_unique<Adam>(0.01));
+
+        // Whatever a call allocates while warming up, more epochs must not add to it
+        TestFramework::assertEqual(trainingAllocations(net, 1, 4, 1), trainingAllocations(net, 6, 4, 1),
+                                   "Batched training should not allocate per step");
+        TestFramework::assertEqual(trainingAllocations(net, 1, 3, 2), trainingAllocations(net, 6, 3, 2),
+                                   "Accumulated training should not allocate per step");
+        TestFramework::assertEqual(trainingAllocations(flat, 1, 4, 1), trainingAllocations(flat, 6, 4, 1),
+                                   "Training through the parameter arena should not allocate per step");
+    });
+
+    return suite;
+}
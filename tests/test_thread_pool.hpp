@@ -0,0 +1,77 @@
+#pragma once
+
+#include "test_framework.hpp"
+#include "../include/thread_pool.hpp"
+#include <atomic>
+#include <vector>
+#include <stdexcept>
+
+/**
+ * @brief Tests for ThreadPool functionality
+ * @return TestSuite with the results
+ */
+TestFramework::TestSuite runThreadPoolTests() {
+    TestFramework::TestSuite suite("ThreadPool");
+
+    // Every index is visited exactly once, whatever the grain
+    suite.runTest("ThreadPool Parallel For Coverage", []() {
+        ThreadPool pool(4);
+        TestFramework::assertEqual(size_t(4), pool.size(), "Pool size incorrect");
+
+        for (size_t grain : {0, 1, 7, 1000}) {
+            std::vector<std::atomic<int>> hits(997);
+            pool.parallel_for(0, hits.size(), grain, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    hits[i].fetch_add(1);
+                }
+            });
+            for (size_t i = 0; i < hits.size(); ++i) {
+                TestFramework::assertEqual(1, hits[i].load(), "Each index should be visited once");
+            }
+        }
+
+        bool called = false;
+        pool.parallel_for(5, 5, 1, [&](size_t, size_t) { called = true; });
+        TestFramework::assertFalse(called, "An empty range should not call the body");
+    });
+
+    // Tasks that call parallel_for on the same pool must not deadlock
+    suite.runTest("ThreadPool Nested Parallel For", []() {
+        ThreadPool pool(2);
+        std::atomic<int> total{0};
+        pool.parallel_for(0, 8, 1, [&](size_t, size_t) {
+            pool.parallel_for(0, 10, 1, [&](size_t lo, size_t hi) {
+                total.fetch_add((int)(hi - lo));
+            });
+        });
+        TestFramework::assertEqual(80, total.load(), "Nested loops should run every inner index");
+    });
+
+    // Submitted tasks complete before wait returns
+    suite.runTest("ThreadPool Submit And Wait", []() {
+        ThreadPool pool(3);
+        std::atomic<int> count{0};
+        for (int i = 0; i < 100; ++i) {
+            pool.submit([&]() { count.fetch_add(1); });
+        }
+        pool.wait();
+        TestFramework::assertEqual(100, count.load(), "All submitted tasks should have run");
+    });
+
+    // An exception in any chunk is rethrown to the caller
+    suite.runTest("ThreadPool Propagates Exceptions", []() {
+        ThreadPool pool(2);
+        std::atomic<int> finished{0};
+        TestFramework::assertThrows<std::runtime_error>([&]() {
+            pool.parallel_for(0, 16, 1, [&](size_t lo, size_t) {
+                if (lo == 11) {
+                    throw std::runtime_error("chunk failed");
+                }
+                finished.fetch_add(1);
+            });
+        }, "A throwing chunk should propagate");
+        TestFramework::assertEqual(15, finished.load(), "The other chunks should still complete");
+    });
+
+    return suite;
+}
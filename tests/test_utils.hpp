@@ -158,5 +158,23 @@ TestFramework::TestSuite runUtilsTests() {
         TestFramework::assertVectorDoubleEqual(expectedOutput, input, 1e-10, "softmax([]) should return empty vector");
     });
 
+    // Test GELU and SiLU functions
+    suite.runTest("GELU and SiLU Functions", []() {
+        TestFramework::assertDoubleEqual(0.0, Utils::gelu(0.0), 1e-12, "gelu(0.0) should be 0");
+        TestFramework::assertDoubleEqual(0.8413447460685429, Utils::gelu(1.0), 1e-10, "gelu(1.0) incorrect");
+        TestFramework::assertDoubleEqual(-0.15865525393145707, Utils::gelu(-1.0), 1e-10, "gelu(-1.0) incorrect");
+        TestFramework::assertDoubleEqual(0.7310585786300049, Utils::silu(1.0), 1e-10, "silu(1.0) incorrect");
+        TestFramework::assertDoubleEqual(-0.2689414213699951, Utils::silu(-1.0), 1e-10, "silu(-1.0) incorrect");
+
+        // Derivatives against central differences
+        const double h = 1e-6;
+        for (double x = -3.0; x <= 3.0; x += 0.5) {
+            double gelu_numeric = (Utils::gelu(x + h) - Utils::gelu(x - h)) / (2.0 * h);
+            double silu_numeric = (Utils::silu(x + h) - Utils::silu(x - h)) / (2.0 * h);
+            TestFramework::assertDoubleEqual(gelu_numeric, Utils::gelu_derivative(x), 1e-7, "gelu_derivative incorrect");
+            TestFramework::assertDoubleEqual(silu_numeric, Utils::silu_derivative(x), 1e-7, "silu_derivative incorrect");
+        }
+    });
+
     return suite;
 }